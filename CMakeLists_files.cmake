@@ -27,6 +27,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/core/props/satfunc/RelpermDiagnostics.cpp
   opm/simulators/timestepping/SimulatorReport.cpp
   opm/simulators/flow/MissingFeatures.cpp
+  opm/simulators/flow/EnsembleDefinition.cpp
   opm/simulators/linalg/ExtractParallelGridInformationToISTL.cpp
   opm/simulators/linalg/setupPropertyTree.cpp
   opm/simulators/linalg/bda/BdaBridge.cpp
@@ -38,6 +39,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/utils/gatherDeferredLogger.cpp
   opm/simulators/utils/moduleVersion.cpp
   opm/simulators/utils/ParallelRestart.cpp
+  opm/simulators/utils/PerformanceProfile.cpp
   opm/simulators/wells/VFPProdProperties.cpp
   opm/simulators/wells/VFPInjProperties.cpp
   )
@@ -52,22 +54,30 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_equil.cc
   tests/test_ecl_output.cc
   tests/test_blackoil_amg.cpp
+  tests/test_blockkernels.cpp
   tests/test_convergencereport.cpp
   tests/test_flexiblesolver.cpp
+  tests/test_krylovsolvers.cpp
   tests/test_preconditionerfactory.cpp
   tests/test_graphcoloring.cpp
   tests/test_vfpproperties.cpp
   tests/test_milu.cpp
   tests/test_multmatrixtransposed.cpp
+  tests/test_checkpoint.cpp
+  tests/test_ensembledefinition.cpp
   tests/test_nncsorter.cpp
   tests/test_wellmodel.cpp
+  tests/test_wellschurcomplement.cpp
+  tests/test_linearsystemdump.cpp
   tests/test_deferredlogger.cpp
   tests/test_timer.cpp
+  tests/test_timestepcontrol.cpp
   tests/test_invert.cpp
   tests/test_stoppedwells.cpp
   tests/test_relpermdiagnostics.cpp
   tests/test_norne_pvt.cpp
   tests/test_ParallelRestart.cpp
+  tests/test_performanceprofile.cpp
   tests/test_wellstatefullyimplicitblackoil.cpp
   )
 
@@ -123,6 +133,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/flow/NonlinearSolverEbos.hpp
   opm/simulators/flow/SimulatorFullyImplicitBlackoilEbos.hpp
   opm/simulators/flow/MissingFeatures.hpp
+  opm/simulators/flow/EnsembleDefinition.hpp
   opm/core/props/BlackoilPhases.hpp
   opm/core/props/phaseUsageFromDeck.hpp
   opm/core/props/satfunc/RelpermDiagnostics.hpp
@@ -140,16 +151,20 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/bda/cusparseSolverBackend.hpp
   opm/simulators/linalg/BlackoilAmg.hpp
   opm/simulators/linalg/BlackoilAmgCpr.hpp
+  opm/simulators/linalg/BlockKernels.hpp
   opm/simulators/linalg/amgcpr.hh
   opm/simulators/linalg/twolevelmethodcpr.hh
   opm/simulators/linalg/CPRPreconditioner.hpp
   opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp
   opm/simulators/linalg/FlexibleSolver.hpp
   opm/simulators/linalg/FlowLinearSolverParameters.hpp
+  opm/simulators/linalg/FusedReduction.hpp
   opm/simulators/linalg/GraphColoring.hpp
   opm/simulators/linalg/ISTLSolverEbos.hpp
   opm/simulators/linalg/ISTLSolverEbosCpr.hpp
   opm/simulators/linalg/ISTLSolverEbosFlexible.hpp
+  opm/simulators/linalg/KrylovSolvers.hpp
+  opm/simulators/linalg/LinearSystemDump.hpp
   opm/simulators/linalg/MatrixBlock.hpp
   opm/simulators/linalg/OwningBlockPreconditioner.hpp
   opm/simulators/linalg/OwningTwoLevelPreconditioner.hpp
@@ -177,6 +192,8 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/utils/gatherDeferredLogger.hpp
   opm/simulators/utils/moduleVersion.hpp
   opm/simulators/utils/ParallelRestart.hpp
+  opm/simulators/utils/PerformanceProfile.hpp
+  opm/simulators/utils/Checkpoint.hpp
   opm/simulators/wells/PerforationData.hpp
   opm/simulators/wells/RateConverter.hpp
   opm/simulators/wells/SimFIBODetails.hpp
@@ -190,6 +207,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/WellHelpers.hpp
   opm/simulators/wells/WellInterface.hpp
   opm/simulators/wells/WellInterface_impl.hpp
+  opm/simulators/wells/WellSchurComplement.hpp
   opm/simulators/wells/StandardWell.hpp
   opm/simulators/wells/StandardWell_impl.hpp
   opm/simulators/wells/MultisegmentWell.hpp
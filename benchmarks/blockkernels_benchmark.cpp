@@ -0,0 +1,177 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Compare the specialized small block kernels of BlockKernels.hpp with the
+// generic Dune::FieldMatrix operations for the block sizes of the models.
+//
+// Usage: blockkernels_benchmark [number of repetitions]
+
+#include <config.h>
+
+#include <opm/simulators/linalg/BlockKernels.hpp>
+
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // keep the optimizer from removing the benchmarked loops
+    volatile double sink = 0.0;
+
+    template <class Function>
+    double timeIt(const int repetitions, Function f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repetitions; ++r)
+            f();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    void report(const std::string& kernel, const int n, const double dune, const double opm)
+    {
+        std::cout << std::setw(20) << kernel << std::setw(4) << n
+                  << std::setw(14) << std::scientific << std::setprecision(3) << dune
+                  << std::setw(14) << opm
+                  << std::setw(10) << std::fixed << std::setprecision(2) << dune/opm << std::endl;
+    }
+
+    template <int n>
+    void benchmark(const int repetitions)
+    {
+        typedef Dune::FieldMatrix<double, n, n> Block;
+        typedef Dune::FieldVector<double, n> Vector;
+        typedef Dune::BCRSMatrix<Block> Matrix;
+        typedef Dune::BlockVector<Vector> BVector;
+
+        // a 7-point stencil on a 32x32x32 grid, the typical sparsity of a
+        // structured reservoir model
+        const int nx = 32;
+        const int N = nx*nx*nx;
+        Matrix A(N, N, 7*N, Matrix::row_wise);
+        for (auto row = A.createbegin(); row != A.createend(); ++row) {
+            const int i = row.index();
+            const int offsets[] = { -nx*nx, -nx, -1, 0, 1, nx, nx*nx };
+            for (const int offset : offsets) {
+                if (i + offset >= 0 && i + offset < N)
+                    row.insert(i + offset);
+            }
+        }
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                for (int i = 0; i < n; ++i) {
+                    for (int j = 0; j < n; ++j) {
+                        (*col)[i][j] = dist(gen) + (i == j && row.index() == col.index() ? 2.0*n : 0.0);
+                    }
+                }
+            }
+        }
+        BVector x(N), y(N);
+        for (auto& block : x)
+            for (auto& value : block)
+                value = dist(gen);
+
+        // sparse matrix-vector product
+        const double duneSpmv = timeIt(repetitions, [&]() { A.mv(x, y); sink = sink + y[0][0]; });
+        const double opmSpmv = timeIt(repetitions, [&]() { Opm::BlockKernels::spmv(A, x, y); sink = sink + y[0][0]; });
+        report("spmv", n, duneSpmv, opmSpmv);
+
+        // block kernels on the matrix entries, as used by the ILU factorization and apply
+        std::vector<Block> blocks;
+        for (auto row = A.begin(); row != A.end(); ++row)
+            for (auto col = row->begin(); col != row->end(); ++col)
+                blocks.push_back(*col);
+        const std::size_t numBlocks = blocks.size();
+        const int blockRepetitions = std::max(1, repetitions / 10);
+
+        Vector v(0.0);
+        const double duneMmv = timeIt(repetitions, [&]() {
+            for (std::size_t b = 0; b < numBlocks; ++b)
+                blocks[b].mmv(x[b % N], v);
+            sink = sink + v[0];
+        });
+        const double opmMmv = timeIt(repetitions, [&]() {
+            for (std::size_t b = 0; b < numBlocks; ++b)
+                Opm::BlockKernels::mmv(blocks[b], x[b % N], v);
+            sink = sink + v[0];
+        });
+        report("mmv", n, duneMmv, opmMmv);
+
+        Block C(0.0);
+        const double duneMult = timeIt(blockRepetitions, [&]() {
+            for (std::size_t b = 1; b < numBlocks; ++b) {
+                Block modifier = blocks[b];
+                modifier.leftmultiply(blocks[b-1]);
+                C -= modifier;
+            }
+            sink = sink + C[0][0];
+        });
+        const double opmMult = timeIt(blockRepetitions, [&]() {
+            for (std::size_t b = 1; b < numBlocks; ++b)
+                Opm::BlockKernels::multiplySubtract(blocks[b-1], blocks[b], C);
+            sink = sink + C[0][0];
+        });
+        report("multiplySubtract", n, duneMult, opmMult);
+
+        std::vector<Block> diagonal;
+        for (int i = 0; i < N; ++i)
+            diagonal.push_back(A[i][i]);
+        const double duneInvert = timeIt(blockRepetitions, [&]() {
+            for (const auto& block : diagonal) {
+                Block inverse(block);
+                inverse.invert();
+                sink = sink + inverse[0][0];
+            }
+        });
+        const double opmInvert = timeIt(blockRepetitions, [&]() {
+            for (const auto& block : diagonal) {
+                Block inverse(block);
+                Opm::BlockKernels::invert(inverse);
+                sink = sink + inverse[0][0];
+            }
+        });
+        report("invert", n, duneInvert, opmInvert);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int repetitions = argc > 1 ? std::atoi(argv[1]) : 50;
+
+    std::cout << std::setw(20) << "kernel" << std::setw(4) << "n"
+              << std::setw(14) << "dune [s]" << std::setw(14) << "opm [s]"
+              << std::setw(10) << "speedup" << std::endl;
+
+    benchmark<1>(repetitions);
+    benchmark<2>(repetitions);
+    benchmark<3>(repetitions);
+    benchmark<4>(repetitions);
+    benchmark<6>(repetitions);
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Time linear solver configurations on linear systems dumped by flow with
+// --linear-system-dump-directory.
+//
+// Usage: linearsolver_benchmark <sweep.json> <system.opmsys>...
+//
+// The sweep file lists the configurations of the flexible solver to run,
+// each in the format used by --linear-solver-configuration-json-file:
+//
+//     {
+//         "repetitions": "3",
+//         "configurations": {
+//             "ilu0": { "tol": "1e-2", "maxiter": "200", "verbosity": "0",
+//                       "solver": "bicgstab",
+//                       "preconditioner": { "type": "ILU0", "relaxation": "1.0" } },
+//             "cpr": { ... }
+//         }
+//     }
+//
+// Every configuration is set up and applied to every system the given number
+// of times. The well contributions of the dumps are added to the matrix. The
+// table lists the average setup and apply times, the number of iterations and
+// the growth of the resident memory during the setup.
+
+#include <config.h>
+
+#include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/LinearSystemDump.hpp>
+#include <opm/simulators/linalg/MatrixBlock.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+
+namespace
+{
+    // the resident memory of the process in MB, or -1 if not available
+    double residentMemory()
+    {
+        std::ifstream statm("/proc/self/statm");
+        long pages = 0, resident = 0;
+        if (!(statm >> pages >> resident))
+            return -1.0;
+        return resident * double(sysconf(_SC_PAGESIZE)) / (1024.0*1024.0);
+    }
+
+    double secondsSince(const std::chrono::steady_clock::time_point& start)
+    {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    template <int n>
+    void benchmark(const std::string& fileName, const boost::property_tree::ptree& sweep)
+    {
+        typedef Dune::BCRSMatrix<Opm::MatrixBlock<double, n, n>> Matrix;
+        typedef Dune::BlockVector<Dune::FieldVector<double, n>> Vector;
+
+        Matrix A;
+        Vector b;
+        Opm::WellSchurComplement<double, n> wells;
+        if (Opm::LinearSystemDump::read(fileName, A, b, wells) && wells.numWells() > 0)
+            A = Opm::LinearSystemDump::addWellContributions(A, wells);
+
+        std::cout << fileName << ": " << A.N() << " rows of " << n << "x" << n << " blocks, "
+                  << A.nonzeroes() << " nonzero blocks, " << wells.numWells() << " wells" << std::endl;
+
+        const int repetitions = sweep.get<int>("repetitions", 1);
+        for (const auto& configuration : sweep.get_child("configurations")) {
+            double setupTime = 0.0, applyTime = 0.0, memory = 0.0;
+            Dune::InverseOperatorResult result;
+            for (int r = 0; r < repetitions; ++r) {
+                const double memoryBefore = residentMemory();
+                auto start = std::chrono::steady_clock::now();
+                Dune::FlexibleSolver<Matrix, Vector> solver(configuration.second, A);
+                setupTime += secondsSince(start);
+                memory = std::max(memory, residentMemory() - memoryBefore);
+
+                Vector x(A.M()), rhs(b);
+                x = 0.0;
+                start = std::chrono::steady_clock::now();
+                solver.apply(x, rhs, result);
+                applyTime += secondsSince(start);
+            }
+
+            std::cout << std::setw(24) << configuration.first
+                      << std::fixed << std::setprecision(4)
+                      << std::setw(12) << setupTime/repetitions
+                      << std::setw(12) << applyTime/repetitions
+                      << std::setw(8) << result.iterations
+                      << std::setw(11) << (result.converged ? "yes" : "no")
+                      << std::setprecision(1) << std::setw(14) << memory << std::endl;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <sweep.json> <system.opmsys>..." << std::endl;
+        return 1;
+    }
+
+    try {
+        boost::property_tree::ptree sweep;
+        boost::property_tree::read_json(argv[1], sweep);
+
+        std::cout << std::setw(24) << "configuration" << std::setw(12) << "setup [s]"
+                  << std::setw(12) << "apply [s]" << std::setw(8) << "iter"
+                  << std::setw(11) << "converged" << std::setw(14) << "memory [MB]" << std::endl;
+        for (int arg = 2; arg < argc; ++arg) {
+            const std::string fileName = argv[arg];
+            switch (Opm::LinearSystemDump::blockSize(fileName)) {
+            case 1: benchmark<1>(fileName, sweep); break;
+            case 2: benchmark<2>(fileName, sweep); break;
+            case 3: benchmark<3>(fileName, sweep); break;
+            case 4: benchmark<4>(fileName, sweep); break;
+            default:
+                std::cerr << fileName << ": unsupported block size" << std::endl;
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
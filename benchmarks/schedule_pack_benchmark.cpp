@@ -0,0 +1,144 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Time the distribution of the Schedule of a deck from rank 0 to all
+// processes, as done by flow at startup.
+//
+// Usage: mpirun -np <n> schedule_pack_benchmark <deck.DATA> [repetitions]
+//
+// The table lists the average times of
+//  - packSize: the traversal which computes the size of the buffer,
+//  - pack: packing into a buffer sized by packSize,
+//  - single pass pack: packing into a growing buffer,
+//  - unpack: unpacking the buffer on rank 0,
+//  - broadcast: packAndSend() on rank 0 and receiveAndUnpack() on the
+//    other ranks, i.e. the complete distribution (max over all ranks).
+
+#include <config.h>
+
+#include <opm/simulators/utils/ParallelRestart.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Parser/ErrorGuard.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    double secondsSince(const std::chrono::steady_clock::time_point& start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void printRow(const std::string& name, const double seconds)
+    {
+        std::cout << std::left << std::setw(20) << name
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(4)
+                  << seconds << " s\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+    const auto comm = mpiHelper.getCollectiveCommunication();
+
+    if (argc < 2) {
+        if (comm.rank() == 0)
+            std::cerr << "Usage: " << argv[0] << " <deck.DATA> [repetitions]\n";
+        return 1;
+    }
+    const int repetitions = argc > 2 ? std::stoi(argv[2]) : 3;
+
+    std::unique_ptr<Opm::Schedule> schedule;
+    if (comm.rank() == 0) {
+        Opm::Parser parser;
+        Opm::ParseContext parseContext;
+        Opm::ErrorGuard errorGuard;
+        const auto deck = parser.parseFile(argv[1], parseContext, errorGuard);
+        const Opm::EclipseState eclipseState(deck, parseContext, errorGuard);
+        schedule.reset(new Opm::Schedule(deck, eclipseState, parseContext, errorGuard));
+    }
+    else
+        schedule.reset(new Opm::Schedule);
+
+    double packSizeTime = 0.0;
+    double packTime = 0.0;
+    double singlePassTime = 0.0;
+    double unpackTime = 0.0;
+    double broadcastTime = 0.0;
+    std::size_t bufferSize = 0;
+
+    for (int rep = 0; rep < repetitions; ++rep) {
+        if (comm.rank() == 0) {
+            auto start = std::chrono::steady_clock::now();
+            const std::size_t size = Opm::Mpi::packSize(*schedule, comm);
+            packSizeTime += secondsSince(start);
+
+            start = std::chrono::steady_clock::now();
+            std::vector<char> buffer(size);
+            std::size_t pos = 0;
+            Opm::Mpi::pack(*schedule, buffer, pos, comm);
+            packTime += secondsSince(start);
+
+            start = std::chrono::steady_clock::now();
+            buffer = Opm::Mpi::packToBuffer(*schedule, comm);
+            singlePassTime += secondsSince(start);
+            bufferSize = buffer.size();
+
+            start = std::chrono::steady_clock::now();
+            Opm::Schedule copy;
+            pos = 0;
+            Opm::Mpi::unpack(copy, buffer, pos, comm);
+            unpackTime += secondsSince(start);
+        }
+
+        comm.barrier();
+        const auto start = std::chrono::steady_clock::now();
+        if (comm.rank() == 0)
+            Opm::Mpi::packAndSend(*schedule, comm);
+        else {
+            Opm::Schedule received;
+            Opm::Mpi::receiveAndUnpack(received, comm);
+        }
+        broadcastTime += comm.max(secondsSince(start));
+    }
+
+    if (comm.rank() == 0) {
+        std::cout << "Schedule of " << argv[1] << ": " << bufferSize/1024.0/1024.0 << " MB, "
+                  << comm.size() << " processes, " << repetitions << " repetitions\n";
+        printRow("packSize", packSizeTime/repetitions);
+        printRow("pack", packTime/repetitions);
+        printRow("single pass pack", singlePassTime/repetitions);
+        printRow("unpack", unpackTime/repetitions);
+        if (comm.size() > 1)
+            printRow("broadcast", broadcastTime/repetitions);
+    }
+
+    return 0;
+}
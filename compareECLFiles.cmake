@@ -140,6 +140,48 @@ function(add_test_compare_parallel_restarted_simulation)
                        PROPERTIES RUN_SERIAL 1)
 endfunction()
 
+###########################################################################
+# TEST: add_test_compare_checkpointed_simulation
+###########################################################################
+
+# Input:
+#   - casename: basename (no extension)
+#   - PARALLEL: run both simulations with four processes
+#
+# Details:
+#   - This test class compares the output from a simulation which is
+#     resumed from a binary checkpoint to that of an uninterrupted simulation.
+function(add_test_compare_checkpointed_simulation)
+  set(oneValueArgs CASENAME FILENAME SIMULATOR ABS_TOL REL_TOL)
+  set(multiValueArgs TEST_ARGS)
+  cmake_parse_arguments(PARAM "PARALLEL" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
+
+  if(PARAM_PARALLEL)
+    set(TEST_NAME compareParallelCheckpointedSim_${PARAM_SIMULATOR}+${PARAM_FILENAME})
+    set(RESULT_PATH ${BASE_RESULT_PATH}/parallelCheckpoint/${PARAM_SIMULATOR}+${PARAM_CASENAME})
+    set(MPI_RUN 1)
+  else()
+    set(TEST_NAME compareCheckpointedSim_${PARAM_SIMULATOR}+${PARAM_FILENAME})
+    set(RESULT_PATH ${BASE_RESULT_PATH}/checkpoint/${PARAM_SIMULATOR}+${PARAM_CASENAME})
+    set(MPI_RUN 0)
+  endif()
+  set(TEST_ARGS ${OPM_TESTS_ROOT}/${PARAM_CASENAME}/${PARAM_FILENAME} ${PARAM_TEST_ARGS})
+
+  opm_add_test(${TEST_NAME} NO_COMPILE
+               EXE_NAME ${PARAM_SIMULATOR}
+               DRIVER_ARGS ${OPM_TESTS_ROOT}/${PARAM_CASENAME} ${RESULT_PATH}
+                           ${PROJECT_BINARY_DIR}/bin
+                           ${PARAM_FILENAME}
+                           ${PARAM_ABS_TOL} ${PARAM_REL_TOL}
+                           ${COMPARE_ECL_COMMAND}
+                           ${OPM_PACK_COMMAND}
+                           ${MPI_RUN}
+               TEST_ARGS ${TEST_ARGS})
+  if(PARAM_PARALLEL)
+    set_tests_properties(${TEST_NAME} PROPERTIES RUN_SERIAL 1)
+  endif()
+endfunction()
+
 if(NOT TARGET test-suite)
   add_custom_target(test-suite)
 endif()
@@ -416,6 +458,86 @@ add_test_compareECLFiles(CASENAME bc_lab
                          REL_TOL ${rel_tol}
                          DIR bc_lab)
 
+# Multithreaded linearization, checked to be bitwise identical to the serial one
+if(OpenMP_FOUND)
+  add_test_compareECLFiles(CASENAME spe1
+                           FILENAME SPE1CASE1
+                           SIMULATOR flow
+                           ABS_TOL ${abs_tol}
+                           REL_TOL ${rel_tol}
+                           PREFIX compareECLFiles_threaded
+                           DIR_PREFIX /threaded
+                           TEST_ARGS --threads-per-process=4 --verify-threaded-linearization=true)
+
+  add_test_compareECLFiles(CASENAME ctaquifer_2d_oilwater
+                           FILENAME 2D_OW_CTAQUIFER
+                           SIMULATOR flow
+                           ABS_TOL ${abs_tol}
+                           REL_TOL ${rel_tol}
+                           DIR aquifer-oilwater
+                           PREFIX compareECLFiles_threaded
+                           DIR_PREFIX /threaded
+                           TEST_ARGS --threads-per-process=4 --verify-threaded-linearization=true)
+endif()
+
+# Newton iterations restricted to the cells violating the CNV criterion
+add_test_compareECLFiles(CASENAME spe1
+                         FILENAME SPE1CASE2
+                         SIMULATOR flow
+                         ABS_TOL ${abs_tol}
+                         REL_TOL ${coarse_rel_tol}
+                         PREFIX compareECLFiles_localsolve
+                         DIR_PREFIX /localsolve
+                         TEST_ARGS --local-solve-max-pv-fraction=0.1)
+
+# iterations failing only the well or mass balance criteria must be global
+add_test_compareECLFiles(CASENAME spe3
+                         FILENAME SPE3CASE1
+                         SIMULATOR flow
+                         ABS_TOL ${abs_tol}
+                         REL_TOL ${coarse_rel_tol}
+                         PREFIX compareECLFiles_localsolve
+                         DIR_PREFIX /localsolve
+                         TEST_ARGS --tolerance-wells=1e-6 --flow-newton-max-iterations=20 --local-solve-max-pv-fraction=1.0)
+
+add_test_compareECLFiles(CASENAME spe1
+                         FILENAME SPE1CASE1
+                         SIMULATOR flow
+                         ABS_TOL ${abs_tol}
+                         REL_TOL ${coarse_rel_tol}
+                         PREFIX compareECLFiles_localsolve
+                         DIR_PREFIX /localsolve
+                         TEST_ARGS --tolerance-mb=1e-9 --local-solve-max-pv-fraction=1.0)
+
+# Nonlinear domain decomposition preconditioning of the Newton iterations
+add_test_compareECLFiles(CASENAME spe1
+                         FILENAME SPE1CASE2
+                         SIMULATOR flow
+                         ABS_TOL ${abs_tol}
+                         REL_TOL ${coarse_rel_tol}
+                         PREFIX compareECLFiles_nldd
+                         DIR_PREFIX /nldd
+                         TEST_ARGS --nldd-num-subdomains=4)
+
+# Sequential implicit method: pressure step followed by transport step
+add_test_compareECLFiles(CASENAME spe1
+                         FILENAME SPE1CASE2
+                         SIMULATOR flow
+                         ABS_TOL ${abs_tol}
+                         REL_TOL ${coarse_rel_tol}
+                         PREFIX compareECLFiles_sequential
+                         DIR_PREFIX /sequential
+                         TEST_ARGS --sequential-implicit=true --matrix-add-well-contributions=true)
+
+add_test_compareECLFiles(CASENAME spe1
+                         FILENAME SPE1CASE2
+                         SIMULATOR flow
+                         ABS_TOL ${abs_tol}
+                         REL_TOL ${coarse_rel_tol}
+                         PREFIX compareECLFiles_reordered
+                         DIR_PREFIX /reordered
+                         TEST_ARGS --sequential-implicit=true --sequential-reorder-transport=true --matrix-add-well-contributions=true)
+
 # Restart tests
 opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-restart-regressionTest.sh "")
 
@@ -433,6 +555,20 @@ add_test_compare_restarted_simulation(CASENAME spe9
                                       ABS_TOL ${abs_tol_restart}
                                       REL_TOL ${rel_tol_restart})
 
+# Checkpoint tests. Resuming is bit for bit, hence the tolerances of the
+# regular tests
+opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-checkpoint-regressionTest.sh "")
+add_test_compare_checkpointed_simulation(CASENAME spe1
+                                         FILENAME SPE1CASE2
+                                         SIMULATOR flow
+                                         ABS_TOL ${abs_tol}
+                                         REL_TOL ${rel_tol})
+add_test_compare_checkpointed_simulation(CASENAME spe9
+                                         FILENAME SPE9_CP_SHORT
+                                         SIMULATOR flow
+                                         ABS_TOL ${abs_tol}
+                                         REL_TOL ${rel_tol})
+
 # PORV test
 opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-porv-acceptanceTest.sh "")
 add_test_compareECLFiles(CASENAME norne
@@ -454,6 +590,20 @@ add_test_compareECLFiles(CASENAME norne
                          PREFIX compareECLInitFiles
                          DIR_PREFIX /init)
 
+# Cost of the nonlinear domain decomposition compared to plain Newton
+# iterations. These runs take long, hence they are benchmarks.
+if(BUILD_BENCHMARKS)
+  opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-comparison-performanceTest.sh "")
+  add_test_compareECLFiles(CASENAME norne
+                           FILENAME NORNE_ATW2013
+                           SIMULATOR flow
+                           ABS_TOL ${abs_tol}
+                           REL_TOL ${coarse_rel_tol}
+                           PREFIX compareNlddPerformance
+                           DIR_PREFIX /nldd-performance
+                           TEST_ARGS --nldd-num-subdomains=16)
+endif()
+
 # Parallel tests
 if(MPI_FOUND)
   opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-restart-regressionTest.sh "")
@@ -463,6 +613,14 @@ if(MPI_FOUND)
                                                  ABS_TOL ${abs_tol_restart}
                                                  REL_TOL ${rel_tol_restart})
 
+  opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-checkpoint-regressionTest.sh "")
+  add_test_compare_checkpointed_simulation(CASENAME spe1
+                                           FILENAME SPE1CASE2
+                                           SIMULATOR flow
+                                           ABS_TOL ${abs_tol}
+                                           REL_TOL ${rel_tol}
+                                           PARALLEL)
+
 
   opm_set_test_driver(${PROJECT_SOURCE_DIR}/tests/run-parallel-regressionTest.sh "")
 
@@ -548,14 +548,20 @@ public:
 
     class PackUnPackBlockData : public P2PCommunicatorType::DataHandleInterface
     {
-        const std::map<std::pair<std::string, int>, double>& localBlockData_;
-        std::map<std::pair<std::string, int>, double>& globalBlockValues_;
+        const std::vector<int>& localBlockSlots_;
+        const std::vector<double>& localBlockValues_;
+        std::vector<int>& globalBlockSlots_;
+        std::vector<double>& globalBlockValues_;
 
     public:
-        PackUnPackBlockData(const std::map<std::pair<std::string, int>, double>& localBlockData,
-                            std::map<std::pair<std::string, int>, double>& globalBlockValues,
+        PackUnPackBlockData(const std::vector<int>& localBlockSlots,
+                            const std::vector<double>& localBlockValues,
+                            std::vector<int>& globalBlockSlots,
+                            std::vector<double>& globalBlockValues,
                             bool isIORank)
-            : localBlockData_(localBlockData)
+            : localBlockSlots_(localBlockSlots)
+            , localBlockValues_(localBlockValues)
+            , globalBlockSlots_(globalBlockSlots)
             , globalBlockValues_(globalBlockValues)
         {
             if (isIORank) {
@@ -575,13 +581,12 @@ public:
             if (link != 0)
                 throw std::logic_error("link in method pack is not 0 as expected");
 
-            // write all block data
-            unsigned int size = localBlockData_.size();
+            // write all block data, the slots identify the summary keys
+            unsigned int size = localBlockSlots_.size();
             buffer.write(size);
-            for (const auto& map : localBlockData_) {
-                buffer.write(map.first.first);
-                buffer.write(map.first.second);
-                buffer.write(map.second);
+            for (const int slot : localBlockSlots_) {
+                buffer.write(slot);
+                buffer.write(localBlockValues_[slot]);
             }
         }
 
@@ -592,13 +597,12 @@ public:
             unsigned int size = 0;
             buffer.read(size);
             for (size_t i = 0; i < size; ++i) {
-                std::string name;
-                int idx;
+                int slot;
                 double data;
-                buffer.read(name);
-                buffer.read(idx);
+                buffer.read(slot);
                 buffer.read(data);
-                globalBlockValues_[std::make_pair(name, idx)] = data;
+                globalBlockSlots_.push_back(slot);
+                globalBlockValues_[slot] = data;
             }
         }
 
@@ -606,11 +610,13 @@ public:
 
     // gather solution to rank 0 for EclipseWriter
     void collect(const Opm::data::Solution& localCellData,
-                 const std::map<std::pair<std::string, int>, double>& localBlockData,
+                 const std::vector<int>& localBlockSlots,
+                 const std::vector<double>& localBlockValues,
                  const Opm::data::Wells& localWellData)
     {
         globalCellData_ = {};
-        globalBlockData_.clear();
+        globalBlockSlots_.clear();
+        globalBlockValues_.assign(localBlockValues.size(), 0.0);
         globalWellData_.clear();
 
         // index maps only have to be build when reordering is needed
@@ -636,8 +642,10 @@ public:
                                isIORank());
 
         PackUnPackBlockData
-            packUnpackBlockData(localBlockData,
-                                globalBlockData_,
+            packUnpackBlockData(localBlockSlots,
+                                localBlockValues,
+                                globalBlockSlots_,
+                                globalBlockValues_,
                                 isIORank());
 
         toIORankComm_.exchange(packUnpackCellData);
@@ -652,8 +660,11 @@ public:
 #endif
     }
 
-    const std::map<std::pair<std::string, int>, double>& globalBlockData() const
-    { return globalBlockData_; }
+    const std::vector<int>& globalBlockSlots() const
+    { return globalBlockSlots_; }
+
+    const std::vector<double>& globalBlockValues() const
+    { return globalBlockValues_; }
 
     const Opm::data::Solution& globalCellData() const
     { return globalCellData_; }
@@ -705,7 +716,8 @@ protected:
     IndexMapStorageType indexMaps_;
     std::vector<int> globalRanks_;
     Opm::data::Solution globalCellData_;
-    std::map<std::pair<std::string, int>, double> globalBlockData_;
+    std::vector<int> globalBlockSlots_;
+    std::vector<double> globalBlockValues_;
     Opm::data::Wells globalWellData_;
     std::vector<int> localIdxToGlobalIdx_;
 };
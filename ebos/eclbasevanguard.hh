@@ -53,6 +53,8 @@
 
 #include <array>
 #include <chrono>
+#include <map>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
@@ -77,6 +79,9 @@ NEW_PROP_TAG(EclOutputInterval);
 NEW_PROP_TAG(IgnoreKeywords);
 NEW_PROP_TAG(EnableExperiments);
 NEW_PROP_TAG(EdgeWeightsMethod);
+NEW_PROP_TAG(EclCellCostModel);
+NEW_PROP_TAG(EclCellCostFile);
+NEW_PROP_TAG(EclCellCostOutputFile);
 
 SET_STRING_PROP(EclBaseVanguard, IgnoreKeywords, "");
 SET_STRING_PROP(EclBaseVanguard, EclDeckFileName, "");
@@ -84,6 +89,9 @@ SET_INT_PROP(EclBaseVanguard, EclOutputInterval, -1); // use the deck-provided v
 SET_BOOL_PROP(EclBaseVanguard, EnableOpmRstFile, false);
 SET_BOOL_PROP(EclBaseVanguard, EclStrictParsing, false);
 SET_INT_PROP(EclBaseVanguard, EdgeWeightsMethod, 1);
+SET_STRING_PROP(EclBaseVanguard, EclCellCostModel, "none");
+SET_STRING_PROP(EclBaseVanguard, EclCellCostFile, "");
+SET_STRING_PROP(EclBaseVanguard, EclCellCostOutputFile, "");
 
 END_PROPERTIES
 
@@ -129,6 +137,12 @@ public:
                              "Use strict mode for parsing - all errors are collected before the applicaton exists.");
         EWOMS_REGISTER_PARAM(TypeTag, int, EdgeWeightsMethod,
                              "Choose edge-weighing strategy: 0=uniform, 1=trans, 2=log(trans).");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, EclCellCostModel,
+                             "Estimate of the computational cost of the cells used to report the load balance of the processes. The partitioning balances the number of cells and does not use it: none=uniform, deck=from the well perforations of the deck, file=from the profile given by --ecl-cell-cost-file.");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, EclCellCostFile,
+                             "Cell cost profile written by a previous run using --ecl-cell-cost-output-file.");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, EclCellCostOutputFile,
+                             "Write the estimated per-cell costs, scaled for each process to the measured assembly time of the process, to this file at the end of the simulation.");
     }
 
     /*!
@@ -261,6 +275,9 @@ public:
 
         std::string fileName = EWOMS_GET_PARAM(TypeTag, std::string, EclDeckFileName);
         edgeWeightsMethod_   = Dune::EdgeWeightMethod(EWOMS_GET_PARAM(TypeTag, int, EdgeWeightsMethod));
+        cellCostModel_       = EWOMS_GET_PARAM(TypeTag, std::string, EclCellCostModel);
+        cellCostFile_        = EWOMS_GET_PARAM(TypeTag, std::string, EclCellCostFile);
+        cellCostOutputFile_  = EWOMS_GET_PARAM(TypeTag, std::string, EclCellCostOutputFile);
 
         // Skip processing of filename if external deck already exists.
         if (!externalDeck_)
@@ -430,6 +447,52 @@ public:
     static void setExternalSummaryConfig(Opm::SummaryConfig* summaryConfig)
     { externalEclSummaryConfig_ = summaryConfig; }
 
+    /*!
+     * \brief Set the factors by which some field properties of the deck are multiplied.
+     *
+     * This allows to run several realizations of a model which only differ by these
+     * factors without creating a new Opm::EclipseState object for each of them. The
+     * keys are the names of the properties. PERMX, PERMY, PERMZ and PORO are supported;
+     * the PORO factor is applied to the pore volumes used by the simulation, but not to
+     * the ones used to construct the grid. The PERM* factors are applied to the
+     * transmissibilities and to the well connection factors which are computed from the
+     * permeabilities. The lifetime of the object is not managed by the vanguard.
+     */
+    static void setExternalFieldPropertyMultipliers(const std::map<std::string, double>* multipliers)
+    { externalFieldPropertyMultipliers_ = multipliers; }
+
+    /*!
+     * \brief Set factors of the same field properties which differ between the cells.
+     *
+     * The arrays have one entry per cell of the logically Cartesian grid. They are
+     * applied in addition to the constant factors. The lifetime of the object is not
+     * managed by the vanguard.
+     */
+    static void setExternalFieldPropertyCellMultipliers(const std::map<std::string, std::vector<double>>* multipliers)
+    { externalFieldPropertyCellMultipliers_ = multipliers; }
+
+    /*!
+     * \brief Returns the factor by which a field property of the deck is multiplied
+     *        in a cell.
+     *
+     * \param name The name of the property
+     * \param cartesianElemIdx The index of the cell in the logically Cartesian grid
+     */
+    Scalar fieldPropertyMultiplier(const std::string& name, unsigned cartesianElemIdx) const
+    {
+        Scalar mult = 1.0;
+        if (externalFieldPropertyMultipliers_) {
+            const auto it = externalFieldPropertyMultipliers_->find(name);
+            if (it != externalFieldPropertyMultipliers_->end())
+                mult = it->second;
+        }
+        if (externalFieldPropertyCellMultipliers_) {
+            const auto it = externalFieldPropertyCellMultipliers_->find(name);
+            if (it != externalFieldPropertyCellMultipliers_->end())
+                mult *= it->second[cartesianElemIdx];
+        }
+        return mult;
+    }
 
     /*!
     * \brief Returns the summary state
@@ -449,6 +512,25 @@ public:
      */
     Dune::EdgeWeightMethod edgeWeightsMethod() const
     { return edgeWeightsMethod_; }
+
+    /*!
+     * \brief The model for the computational cost of the cells: "none", "deck" or "file".
+     */
+    const std::string& cellCostModel() const
+    { return cellCostModel_; }
+
+    /*!
+     * \brief The cell cost profile which is read if the cell cost model is "file".
+     */
+    const std::string& cellCostFile() const
+    { return cellCostFile_; }
+
+    /*!
+     * \brief The file to which the measured cell cost profile is written, empty if none.
+     */
+    const std::string& cellCostOutputFile() const
+    { return cellCostOutputFile_; }
+
     /*!
      * \brief Returns the name of the case.
      *
@@ -589,6 +671,8 @@ private:
     static Opm::EclipseState* externalEclState_;
     static Opm::Schedule* externalEclSchedule_;
     static Opm::SummaryConfig* externalEclSummaryConfig_;
+    static const std::map<std::string, double>* externalFieldPropertyMultipliers_;
+    static const std::map<std::string, std::vector<double>>* externalFieldPropertyCellMultipliers_;
 
     std::unique_ptr<Opm::ParseContext> internalParseContext_;
     std::unique_ptr<Opm::ErrorGuard> internalErrorGuard_;
@@ -608,6 +692,9 @@ private:
     Opm::SummaryConfig* eclSummaryConfig_;
 
     Dune::EdgeWeightMethod edgeWeightsMethod_;
+    std::string cellCostModel_;
+    std::string cellCostFile_;
+    std::string cellCostOutputFile_;
 };
 
 template <class TypeTag>
@@ -631,6 +718,12 @@ Opm::Schedule* EclBaseVanguard<TypeTag>::externalEclSchedule_ = nullptr;
 template <class TypeTag>
 Opm::SummaryConfig* EclBaseVanguard<TypeTag>::externalEclSummaryConfig_ = nullptr;
 
+template <class TypeTag>
+const std::map<std::string, double>* EclBaseVanguard<TypeTag>::externalFieldPropertyMultipliers_ = nullptr;
+
+template <class TypeTag>
+const std::map<std::string, std::vector<double>>* EclBaseVanguard<TypeTag>::externalFieldPropertyCellMultipliers_ = nullptr;
+
 } // namespace Opm
 
 #endif
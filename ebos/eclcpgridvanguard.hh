@@ -38,6 +38,17 @@
 
 #include <dune/common/version.hh>
 
+#include <opm/common/OpmLog/OpmLog.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 namespace Opm {
 template <class TypeTag>
 class EclCpGridVanguard;
@@ -208,8 +219,45 @@ public:
         cartesianIndexMapper_.reset(new CartesianIndexMapper(*grid_));
 
         this->updateGridView_();
+
+        computeCellCosts_();
+        if (grid_->comm().size() > 1)
+            logLoadBalance_("Load balance after partitioning", /*localWork=*/-1.0);
+    }
+
+    /*!
+     * \brief Report the load balance of the processes at the end of a run.
+     *
+     * \param localWork The time this process spent on work which scales with the
+     *                  cell costs, i.e., on the assembly of the reservoir and the
+     *                  well equations.
+     *
+     * If an output file for the cell cost profile was given, the estimated costs of
+     * the cells of each process are scaled such that they add up to the measured work
+     * of the process, and written to that file. This calibrates the estimate per
+     * process only; the costs of the cells of a process relative to each other are
+     * still the estimated ones. The profile can be read by a subsequent run using the
+     * "file" cell cost model.
+     */
+    void reportLoadBalance(double localWork) const
+    {
+        if (grid_->comm().size() > 1)
+            logLoadBalance_("Load balance at the end of the simulation", localWork);
+
+        if (!this->cellCostOutputFile().empty()) {
+            const double localCost = std::accumulate(cellCosts_.begin(), cellCosts_.end(), 0.0);
+            writeCellCostProfile_(localCost > 0.0 ? localWork/localCost : 0.0);
+        }
     }
 
+    /*!
+     * \brief The estimated computational cost of each cell of the local grid.
+     *
+     * The cost of cells which are not owned by this process is zero.
+     */
+    const std::vector<double>& cellCosts() const
+    { return cellCosts_; }
+
     /*!
      * \brief Free the memory occupied by the global transmissibility object.
      *
@@ -297,6 +345,193 @@ protected:
         }
     }
 
+    std::vector<int> cartesianToCompressed_() const
+    {
+        std::vector<int> cartesianToCompressed(cartesianIndexMapper_->cartesianSize(), -1);
+        const auto& globalCell = grid_->globalCell();
+        for (std::size_t cellIdx = 0; cellIdx < globalCell.size(); ++cellIdx)
+            cartesianToCompressed[globalCell[cellIdx]] = cellIdx;
+        return cartesianToCompressed;
+    }
+
+    void computeCellCosts_()
+    {
+        cellCosts_.assign(grid_->size(0), 1.0);
+
+        const std::string& model = this->cellCostModel();
+        if (model == "deck") {
+            // relative cost of the perforations of standard and multi-segment wells
+            // compared to the cost of a grid cell
+            const double perforationCost = 4.0;
+            const double multiSegmentPerforationCost = 8.0;
+
+            const auto& cartDims = cartesianIndexMapper_->cartesianDimensions();
+            const auto cartesianToCompressed = cartesianToCompressed_();
+            for (const auto& well : this->schedule().getWellsatEnd()) {
+                const double cost = well.isMultiSegment() ? multiSegmentPerforationCost : perforationCost;
+                const auto& connections = well.getConnections();
+                for (std::size_t c = 0; c < connections.size(); ++c) {
+                    const auto& connection = connections.get(c);
+                    const int cartIdx = connection.getI() + cartDims[0]*(connection.getJ() + cartDims[1]*connection.getK());
+                    const int cellIdx = cartesianToCompressed[cartIdx];
+                    if (cellIdx >= 0)
+                        cellCosts_[cellIdx] += cost;
+                }
+            }
+        }
+        else if (model == "file")
+            readCellCostProfile_();
+        else if (model != "none")
+            throw std::invalid_argument("Unknown cell cost model '" + model + "'. Valid models are none, deck and file.");
+
+        // only the cells owned by a process are accounted for
+        ElementMapper elemMapper(this->gridView(), Dune::mcmgElementLayout());
+        const auto& gridView = this->gridView();
+        const auto& elemEndIt = gridView.template end</*codim=*/0>();
+        for (auto elemIt = gridView.template begin</*codim=*/0>(); elemIt != elemEndIt; ++elemIt) {
+            if (elemIt->partitionType() != Dune::InteriorEntity)
+                cellCosts_[elemMapper.index(*elemIt)] = 0.0;
+        }
+    }
+
+    // The profile consists of lines "I J K cost" with one-based Cartesian
+    // indices. Cells which are not listed get the average cost of the profile.
+    void readCellCostProfile_()
+    {
+        const std::string& fileName = this->cellCostFile();
+        std::ifstream profile(fileName);
+        if (!profile)
+            throw std::runtime_error("Cannot open cell cost profile '" + fileName + "'");
+
+        const auto& cartDims = cartesianIndexMapper_->cartesianDimensions();
+        const auto cartesianToCompressed = cartesianToCompressed_();
+        std::vector<bool> listed(cellCosts_.size(), false);
+        double totalCost = 0.0;
+        std::size_t numEntries = 0;
+        std::string line;
+        while (std::getline(profile, line)) {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            std::istringstream entry(line);
+            int i, j, k;
+            double cost;
+            if (!(entry >> i >> j >> k >> cost) || i < 1 || j < 1 || k < 1
+                || i > cartDims[0] || j > cartDims[1] || k > cartDims[2])
+                throw std::runtime_error("Invalid entry '" + line + "' in cell cost profile '" + fileName + "'");
+
+            totalCost += cost;
+            ++numEntries;
+            const int cellIdx = cartesianToCompressed[(i - 1) + cartDims[0]*((j - 1) + cartDims[1]*(k - 1))];
+            if (cellIdx >= 0) {
+                cellCosts_[cellIdx] = cost;
+                listed[cellIdx] = true;
+            }
+        }
+
+        const double averageCost = numEntries > 0 ? totalCost/numEntries : 1.0;
+        for (std::size_t cellIdx = 0; cellIdx < cellCosts_.size(); ++cellIdx) {
+            if (!listed[cellIdx])
+                cellCosts_[cellIdx] = averageCost;
+        }
+    }
+
+    // Log the number of cells, the estimated cost and, if localWork is not
+    // negative, the measured work of each process together with the imbalance
+    // (maximum over mean) of these quantities.
+    void logLoadBalance_(const std::string& title, double localWork) const
+    {
+        const auto& comm = grid_->comm();
+        const int numRanks = comm.size();
+        double local[3] = { double(std::count_if(cellCosts_.begin(), cellCosts_.end(),
+                                                 [](double cost) { return cost > 0.0; })),
+                            std::accumulate(cellCosts_.begin(), cellCosts_.end(), 0.0),
+                            localWork };
+        std::vector<double> all(comm.rank() == 0 ? 3*numRanks : 0);
+        comm.gather(local, all.data(), 3, 0);
+        if (comm.rank() != 0)
+            return;
+
+        const int numColumns = localWork < 0.0 ? 2 : 3;
+        const char* names[] = { "cells", "cost", "work [s]" };
+        std::ostringstream ss;
+        ss << title << ":\n" << std::setw(8) << "rank";
+        for (int col = 0; col < numColumns; ++col)
+            ss << std::setw(14) << names[col];
+        ss << "\n";
+        for (int rank = 0; rank < numRanks; ++rank) {
+            ss << std::setw(8) << rank;
+            for (int col = 0; col < numColumns; ++col)
+                ss << std::setw(14) << std::setprecision(6) << all[3*rank + col];
+            ss << "\n";
+        }
+        const char* stats[] = { "min", "max", "mean", "max/mean" };
+        for (int stat = 0; stat < 4; ++stat) {
+            ss << std::setw(8) << stats[stat];
+            for (int col = 0; col < numColumns; ++col) {
+                double min = all[col], max = all[col], sum = 0.0;
+                for (int rank = 0; rank < numRanks; ++rank) {
+                    min = std::min(min, all[3*rank + col]);
+                    max = std::max(max, all[3*rank + col]);
+                    sum += all[3*rank + col];
+                }
+                const double mean = sum/numRanks;
+                const double values[] = { min, max, mean, mean > 0.0 ? max/mean : 1.0 };
+                ss << std::setw(14) << std::setprecision(6) << values[stat];
+            }
+            ss << "\n";
+        }
+        Opm::OpmLog::info(ss.str());
+    }
+
+    // Write the costs of the owned cells of all processes, multiplied by the
+    // given per-process factor, as a cell cost profile.
+    void writeCellCostProfile_(double scale) const
+    {
+        const auto& comm = grid_->comm();
+        const auto& globalCell = grid_->globalCell();
+        std::vector<int> localCells;
+        std::vector<double> localCosts;
+        for (std::size_t cellIdx = 0; cellIdx < cellCosts_.size(); ++cellIdx) {
+            if (cellCosts_[cellIdx] > 0.0) {
+                localCells.push_back(globalCell[cellIdx]);
+                localCosts.push_back(scale*cellCosts_[cellIdx]);
+            }
+        }
+
+        const int numRanks = comm.size();
+        int numLocal = localCells.size();
+        std::vector<int> sizes(numRanks), offsets(numRanks + 1, 0);
+        comm.gather(&numLocal, sizes.data(), 1, 0);
+        std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+        std::vector<int> cells(comm.rank() == 0 ? offsets.back() : 0);
+        std::vector<double> costs(cells.size());
+        comm.gatherv(localCells.data(), numLocal, cells.data(), sizes.data(), offsets.data(), 0);
+        comm.gatherv(localCosts.data(), numLocal, costs.data(), sizes.data(), offsets.data(), 0);
+        if (comm.rank() != 0)
+            return;
+
+        std::vector<std::size_t> order(cells.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&cells](std::size_t a, std::size_t b) { return cells[a] < cells[b]; });
+
+        const std::string& fileName = this->cellCostOutputFile();
+        std::ofstream profile(fileName);
+        if (!profile)
+            throw std::runtime_error("Cannot write cell cost profile '" + fileName + "'");
+
+        const auto& cartDims = cartesianIndexMapper_->cartesianDimensions();
+        profile << "# I J K cost\n" << std::setprecision(8);
+        for (const std::size_t idx : order) {
+            const int cartIdx = cells[idx];
+            profile << cartIdx % cartDims[0] + 1 << " "
+                    << (cartIdx / cartDims[0]) % cartDims[1] + 1 << " "
+                    << cartIdx / (cartDims[0]*cartDims[1]) + 1 << " "
+                    << costs[idx] << "\n";
+        }
+    }
+
     std::unique_ptr<Grid> grid_;
     std::unique_ptr<EquilGrid> equilGrid_;
     std::unique_ptr<CartesianIndexMapper> cartesianIndexMapper_;
@@ -304,6 +539,7 @@ protected:
 
     std::unique_ptr<EclTransmissibility<TypeTag> > globalTrans_;
     std::unordered_set<std::string> defunctWellNames_;
+    std::vector<double> cellCosts_;
     int mpiRank;
 };
 
@@ -242,17 +242,12 @@ protected:
         const auto& intQuantsIn = elemCtx.intensiveQuantities(interiorDofIdx_, timeIdx);
         const auto& intQuantsEx = elemCtx.intensiveQuantities(exteriorDofIdx_, timeIdx);
 
-        // this is quite hacky because the dune grid interface does not provide a
-        // cellCenterDepth() method (so we ask the problem to provide it). The "good"
-        // solution would be to take the Z coordinate of the element centroids, but since
-        // ECL seems to like to be inconsistent on that front, it needs to be done like
-        // here...
-        Scalar zIn = problem.dofCenterDepth(elemCtx, interiorDofIdx_, timeIdx);
-        Scalar zEx = problem.dofCenterDepth(elemCtx, exteriorDofIdx_, timeIdx);
-
         // the distances from the DOF's depths. (i.e., the additional depth of the
-        // exterior DOF)
-        Scalar distZ = zIn - zEx;
+        // exterior DOF.) the depths are the ones provided by the problem's
+        // dofCenterDepth() method because the dune grid interface does not provide a
+        // cellCenterDepth() method and ECL is inconsistent about the Z coordinates of
+        // the element centroids.
+        Scalar distZ = problem.depthDifference(elemCtx, interiorDofIdx_, exteriorDofIdx_);
 
         for (unsigned phaseIdx=0; phaseIdx < numPhases; phaseIdx++) {
             if (!FluidSystem::phaseIsActive(phaseIdx))
@@ -296,30 +291,16 @@ protected:
             }
             else {
                 // if the pressure difference is zero, we chose the DOF which has the
-                // larger volume associated to it as upstream DOF
-                Scalar Vin = elemCtx.dofVolume(interiorDofIdx_, /*timeIdx=*/0);
-                Scalar Vex = elemCtx.dofVolume(exteriorDofIdx_, /*timeIdx=*/0);
-                if (Vin > Vex) {
+                // larger volume associated to it as upstream DOF. if the volumes are
+                // also equal, the one which exhibits the smaller global index is taken.
+                if (problem.tieUpstreamIsFrom(elemCtx, interiorDofIdx_, exteriorDofIdx_)) {
                     upIdx_[phaseIdx] = interiorDofIdx_;
                     dnIdx_[phaseIdx] = exteriorDofIdx_;
                 }
-                else if (Vin < Vex) {
+                else {
                     upIdx_[phaseIdx] = exteriorDofIdx_;
                     dnIdx_[phaseIdx] = interiorDofIdx_;
                 }
-                else {
-                    assert(Vin == Vex);
-                    // if the volumes are also equal, we pick the DOF which exhibits the
-                    // smaller global index
-                    if (I < J) {
-                        upIdx_[phaseIdx] = interiorDofIdx_;
-                        dnIdx_[phaseIdx] = exteriorDofIdx_;
-                    }
-                    else {
-                        upIdx_[phaseIdx] = exteriorDofIdx_;
-                        dnIdx_[phaseIdx] = interiorDofIdx_;
-                    }
-                }
             }
 
             // apply the threshold pressure for the intersection. note that the concept
@@ -23,6 +23,10 @@
 
 #include <opm/simulators/utils/ParallelRestart.hpp>
 
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
 namespace Opm {
 
 class EclMpiSerializer {
@@ -36,14 +40,21 @@ public:
         return Mpi::packSize(data, m_comm);
     }
 
+    // The objects which are serialized by this class keep track of the
+    // position in the buffer as an int. The buffer grows while packing,
+    // so it does not need to be sized by packSize() first.
     template<class T>
     void pack(const T& data, std::vector<char>& buffer, int& pos) {
-        Mpi::pack(data, buffer, pos, m_comm);
+        std::size_t position = pos;
+        Mpi::pack(data, buffer, position, m_comm);
+        pos = checkedPosition_(position);
     }
 
     template<class T>
     void unpack(T& data, std::vector<char>& buffer, int& pos) {
-        Mpi::unpack(data, buffer, pos, m_comm);
+        std::size_t position = pos;
+        Mpi::unpack(data, buffer, position, m_comm);
+        pos = checkedPosition_(position);
     }
 
     template<class T>
@@ -53,19 +64,14 @@ public:
             return;
 
 #if HAVE_MPI
+        std::vector<char> buffer;
+        int position = 0;
         if (m_comm.rank() == 0) {
-            size_t size = T::packSize(*this);
-            std::vector<char> buffer(size);
-            int position = 0;
             T::pack(buffer, position, *this);
-            m_comm.broadcast(&position, 1, 0);
-            m_comm.broadcast(buffer.data(), position, 0);
+            buffer.resize(position);
+            Mpi::broadcastBuffer(buffer, m_comm);
         } else {
-            int size;
-            m_comm.broadcast(&size, 1, 0);
-            std::vector<char> buffer(size);
-            m_comm.broadcast(buffer.data(), size, 0);
-            int position = 0;
+            Mpi::broadcastBuffer(buffer, m_comm);
             T::unpack(buffer, position, *this);
         }
 #endif
@@ -78,25 +84,27 @@ public:
             return;
 
 #if HAVE_MPI
+        std::vector<char> buffer;
+        int position = 0;
         if (m_comm.rank() == 0) {
-            size_t size = data.packSize(*this);
-            std::vector<char> buffer(size);
-            int position = 0;
             data.pack(buffer, position, *this);
-            m_comm.broadcast(&position, 1, 0);
-            m_comm.broadcast(buffer.data(), position, 0);
+            buffer.resize(position);
+            Mpi::broadcastBuffer(buffer, m_comm);
         } else {
-            int size;
-            m_comm.broadcast(&size, 1, 0);
-            std::vector<char> buffer(size);
-            m_comm.broadcast(buffer.data(), size, 0);
-            int position = 0;
+            Mpi::broadcastBuffer(buffer, m_comm);
             data.unpack(buffer, position, *this);
         }
 #endif
     }
 
 protected:
+    static int checkedPosition_(std::size_t position)
+    {
+        if (position > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+            throw std::runtime_error("The serialized object exceeds 2 GB");
+        return static_cast<int>(position);
+    }
+
     Dune::CollectiveCommunication<Dune::MPIHelper::MPICommunicator> m_comm;
 };
 
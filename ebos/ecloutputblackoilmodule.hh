@@ -42,7 +42,12 @@
 
 #include <dune/common/fvector.hh>
 
+#include <algorithm>
+#include <map>
+#include <numeric>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 BEGIN_PROPERTIES
 
@@ -173,6 +178,25 @@ class EclOutputBlackOilModule
         static const int numWCValues = 10;
         static const int numWCNames = 3;
     };
+    struct BlockDataType
+    {
+        enum BlockId
+        {
+            WaterSaturation = 0, //BWSAT
+            GasSaturation = 1, //BGSAT
+            OilSaturation = 2, //BOSAT
+            Pressure = 3, //BPR
+            WaterRelPerm = 4, //BWKR, BKRW
+            GasRelPerm = 5, //BGKR, BKRG
+            OilRelPerm = 6, //BOKR, BKRO
+            WaterCapPressure = 7, //BWPC
+            GasCapPressure = 8, //BGPC
+            WaterViscosity = 9, //BVWAT, BWVIS
+            GasViscosity = 10, //BVGAS, BGVIS
+            OilViscosity = 11, //BVOIL, BOVIS
+            Unhandled = 12,
+        };
+    };
 
 public:
     template<class CollectDataToIORankType>
@@ -182,17 +206,22 @@ public:
         createLocalFipnum_();
 
         // Summary output is for all steps
-        const Opm::SummaryConfig summaryConfig = simulator_.vanguard().summaryConfig();
+        const Opm::SummaryConfig& summaryConfig = simulator_.vanguard().summaryConfig();
 
-        // Initialize block output
+        // Initialize block output. The keys are the same on all ranks, so
+        // that the values can be identified by their slot in blockKeys_.
         for (const auto& node: summaryConfig) {
-            if (node.category() == SummaryNode::Category::Block) {
-                if (collectToIORank.isGlobalIdxOnThisRank(node.number() - 1)) {
-                    std::pair<std::string, int> key = std::make_pair(node.keyword(), node.number());
-                    blockData_[key] = 0.0;
-                }
-            }
+            if (node.category() == SummaryNode::Category::Block)
+                blockKeys_.emplace_back(node.keyword(), node.number());
+        }
+        std::sort(blockKeys_.begin(), blockKeys_.end());
+        blockKeys_.erase(std::unique(blockKeys_.begin(), blockKeys_.end()), blockKeys_.end());
+        blockValues_.resize(blockKeys_.size(), 0.0);
+        for (unsigned slot = 0; slot < blockKeys_.size(); ++slot) {
+            if (collectToIORank.isGlobalIdxOnThisRank(blockKeys_[slot].second - 1))
+                localBlockSlots_.push_back(slot);
         }
+        createBlockDataPlan_();
 
         forceDisableFipOutput_ = EWOMS_GET_PARAM(TypeTag, bool, ForceDisableFluidInPlaceOutput);
     }
@@ -206,6 +235,61 @@ public:
                              "Do not print fluid-in-place values after each report step even if requested by the deck.");
     }
 
+    /*!
+     * \brief Evaluate which output is required for a report step.
+     *
+     * This looks up the summary, restart and RFT configuration once per
+     * report step, so that allocating the buffers for the individual
+     * (sub)steps does not need to consult the configuration.
+     */
+    void prepareOutputPlan(unsigned reportStepNum)
+    {
+        OutputPlan& plan = outputPlan_;
+        plan.reportStepNum = reportStepNum;
+
+        const Opm::SummaryConfig& summaryConfig = simulator_.vanguard().summaryConfig();
+        for (int i = 0; i<FipDataType::numFipValues; i++) {
+            plan.fip3D[i] = summaryConfig.require3DField(fipEnumToString_(i));
+            plan.fieldFip[i] = summaryConfig.hasKeyword("F" + fipEnumToString_(i));
+            plan.regionFip[i] = summaryConfig.hasKeyword("R" + fipEnumToString_(i));
+        }
+        plan.foe = summaryConfig.hasKeyword("FOE");
+        plan.fpr = summaryConfig.hasKeyword("FPR");
+        plan.fprp = summaryConfig.hasKeyword("FPRP");
+        plan.rpr = summaryConfig.hasKeyword("RPR");
+        plan.rprp = summaryConfig.hasKeyword("RPRP");
+        plan.pressureAverages = plan.fpr || plan.fprp || plan.rpr;
+
+        const Opm::RestartConfig& restartConfig = simulator_.vanguard().eclState().getRestartConfig();
+        plan.restartKeywords = restartConfig.getRestartKeywords(reportStepNum);
+        for (auto& keyValue: plan.restartKeywords) {
+            keyValue.second = restartConfig.getKeyword(keyValue.first, reportStepNum);
+        }
+        const auto fipKeyword = plan.restartKeywords.find("FIP");
+        plan.restartFip = fipKeyword != plan.restartKeywords.end() && fipKeyword->second > 0;
+
+        plan.rftConnections.clear();
+        const auto& schedule = simulator_.vanguard().schedule();
+        if (schedule.rftConfig().active(reportStepNum)) {
+            const auto& defunctWellNames = simulator_.vanguard().defunctWellNames();
+            const auto& inputGrid = simulator_.vanguard().eclState().getInputGrid();
+            for (const auto& well: schedule.getWells(reportStepNum)) {
+
+                // don't bother with wells not on this process
+                if (defunctWellNames.find(well.name()) != defunctWellNames.end()) {
+                    continue;
+                }
+
+                for (const auto& connection: well.getConnections()) {
+                    const size_t i = size_t(connection.getI());
+                    const size_t j = size_t(connection.getJ());
+                    const size_t k = size_t(connection.getK());
+                    plan.rftConnections.push_back(inputGrid.getGlobalIndex(i, j, k));
+                }
+            }
+        }
+    }
+
     /*!
      * \brief Allocate memory for the scalar fields we would like to
      *        write to ECL output files
@@ -215,33 +299,25 @@ public:
         if (!std::is_same<Discretization, Opm::EcfvDiscretization<TypeTag> >::value)
             return;
 
-        // Summary output is for all steps
-        const Opm::SummaryConfig summaryConfig = simulator_.vanguard().summaryConfig();
-
-        // Only output RESTART_AUXILIARY asked for by the user.
-        const Opm::RestartConfig& restartConfig = simulator_.vanguard().eclState().getRestartConfig();
-        std::map<std::string, int> rstKeywords = restartConfig.getRestartKeywords(reportStepNum);
-        for (auto& keyValue: rstKeywords) {
-            keyValue.second = restartConfig.getKeyword(keyValue.first, reportStepNum);
-        }
+        if (outputPlan_.reportStepNum != static_cast<int>(reportStepNum))
+            prepareOutputPlan(reportStepNum);
+        const OutputPlan& plan = outputPlan_;
 
         outputFipRestart_ = false;
         computeFip_ = false;
 
         // Fluid in place
         for (int i = 0; i<FipDataType::numFipValues; i++) {
-            if (!substep || summaryConfig.require3DField(fipEnumToString_(i))) {
-                if (rstKeywords["FIP"] > 0) {
-                    rstKeywords["FIP"] = 0;
+            if (!substep || plan.fip3D[i]) {
+                if (plan.restartFip)
                     outputFipRestart_ = true;
-                }
                 fip_[i].resize(bufferSize, 0.0);
                 computeFip_ = true;
             }
             else
                 fip_[i].clear();
         }
-        if (!substep || summaryConfig.hasKeyword("FPR") || summaryConfig.hasKeyword("FPRP") || summaryConfig.hasKeyword("RPR")) {
+        if (!substep || plan.pressureAverages) {
             fip_[FipDataType::PoreVolume].resize(bufferSize, 0.0);
             hydrocarbonPoreVolume_.resize(bufferSize, 0.0);
             pressureTimesPoreVolume_.resize(bufferSize, 0.0);
@@ -255,29 +331,10 @@ public:
 
         // Well RFT data
         if (!substep) {
-            const auto& schedule = simulator_.vanguard().schedule();
-            const auto& rft_config = schedule.rftConfig();
-            for (const auto& well: schedule.getWells(reportStepNum)) {
-
-                // don't bother with wells not on this process
-                const auto& defunctWellNames = simulator_.vanguard().defunctWellNames();
-                if (defunctWellNames.find(well.name()) != defunctWellNames.end()) {
-                    continue;
-                }
-
-                if (!rft_config.active(reportStepNum))
-                    continue;
-
-                for (const auto& connection: well.getConnections()) {
-                    const size_t i = size_t(connection.getI());
-                    const size_t j = size_t(connection.getJ());
-                    const size_t k = size_t(connection.getK());
-                    const size_t index = simulator_.vanguard().eclState().getInputGrid().getGlobalIndex(i, j, k);
-
-                    oilConnectionPressures_.emplace(std::make_pair(index, 0.0));
-                    waterConnectionSaturations_.emplace(std::make_pair(index, 0.0));
-                    gasConnectionSaturations_.emplace(std::make_pair(index, 0.0));
-                }
+            for (const size_t index : plan.rftConnections) {
+                oilConnectionPressures_.emplace(std::make_pair(index, 0.0));
+                waterConnectionSaturations_.emplace(std::make_pair(index, 0.0));
+                gasConnectionSaturations_.emplace(std::make_pair(index, 0.0));
             }
         }
 
@@ -288,9 +345,15 @@ public:
         // 1) when we want to restart
         // 2) when it is ask for by the user via restartConfig
         // 3) when it is not a substep
-        if (!isRestart && (!restartConfig.getWriteRestartFile(reportStepNum, log) || substep))
+        const Opm::RestartConfig& restartConfig = simulator_.vanguard().eclState().getRestartConfig();
+        if (!isRestart && (substep || !restartConfig.getWriteRestartFile(reportStepNum, log)))
             return;
 
+        // Only output RESTART_AUXILIARY asked for by the user.
+        std::map<std::string, int> rstKeywords = plan.restartKeywords;
+        if (outputFipRestart_)
+            rstKeywords["FIP"] = 0;
+
         // always output saturation of active phases
         for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++ phaseIdx) {
             if (!FluidSystem::phaseIsActive(phaseIdx))
@@ -686,45 +749,15 @@ public:
             updateFluidInPlace_(elemCtx, dofIdx);
 
             // Adding block data
-            const auto cartesianIdx = elemCtx.simulator().vanguard().grid().globalCell()[globalDofIdx];
-            for (auto& val: blockData_) {
-                const auto& key = val.first;
-                int cartesianIdxBlock = key.second - 1;
-                if (cartesianIdx == cartesianIdxBlock) {
-                    if (key.first == "BWSAT")
-                        val.second = Opm::getValue(fs.saturation(waterPhaseIdx));
-                    else if (key.first == "BGSAT")
-                        val.second = Opm::getValue(fs.saturation(gasPhaseIdx));
-                    else if (key.first == "BOSAT")
-                        val.second = 1. - Opm::getValue(fs.saturation(gasPhaseIdx)) - Opm::getValue(fs.saturation(waterPhaseIdx));
-                    else if (key.first == "BPR")
-                        val.second = Opm::getValue(fs.pressure(oilPhaseIdx));
-                    else if (key.first == "BWKR" || key.first == "BKRW")
-                        val.second = Opm::getValue(intQuants.relativePermeability(waterPhaseIdx));
-                    else if (key.first == "BGKR" || key.first == "BKRG")
-                        val.second = Opm::getValue(intQuants.relativePermeability(gasPhaseIdx));
-                    else if (key.first == "BOKR" || key.first == "BKRO")
-                        val.second = Opm::getValue(intQuants.relativePermeability(oilPhaseIdx));
-                    else if (key.first == "BWPC")
-                        val.second = Opm::getValue(fs.pressure(oilPhaseIdx)) - Opm::getValue(fs.pressure(waterPhaseIdx));
-                    else if (key.first == "BGPC")
-                        val.second = Opm::getValue(fs.pressure(gasPhaseIdx)) - Opm::getValue(fs.pressure(oilPhaseIdx));
-                    else if (key.first == "BVWAT" || key.first == "BWVIS")
-                        val.second = Opm::getValue(fs.viscosity(waterPhaseIdx));
-                    else if (key.first == "BVGAS" || key.first == "BGVIS")
-                        val.second = Opm::getValue(fs.viscosity(gasPhaseIdx));
-                    else if (key.first == "BVOIL" || key.first == "BOVIS")
-                        val.second = Opm::getValue(fs.viscosity(oilPhaseIdx));
-                    else {
-                        std::string logstring = "Keyword '";
-                        logstring.append(key.first);
-                        logstring.append("' is unhandled for output to file.");
-                        Opm::OpmLog::warning("Unhandled output keyword", logstring);
-                    }
+            if (!blockCellOffsets_.empty()) {
+                for (int entryIdx = blockCellOffsets_[globalDofIdx]; entryIdx < blockCellOffsets_[globalDofIdx + 1]; ++entryIdx) {
+                    const auto& entry = blockEntries_[entryIdx];
+                    blockValues_[entry.slot] = blockValue_(entry.quantity, fs, intQuants);
                 }
             }
 
             // Adding Well RFT data
+            const auto cartesianIdx = elemCtx.simulator().vanguard().grid().globalCell()[globalDofIdx];
             if (oilConnectionPressures_.count(cartesianIdx) > 0) {
                 oilConnectionPressures_[cartesianIdx] = Opm::getValue(fs.pressure(oilPhaseIdx));
             }
@@ -1025,63 +1058,66 @@ public:
         }
         ntFip = comm.max(ntFip);
 
-        // sum values over each region
+        // sum values over each region. All region totals are reduced over
+        // the processes with a single collective.
+        enum { PressurePv = FipDataType::numFipValues, PvHydrocarbon, PressurePvHydrocarbon, numRegionQuantities };
+        std::vector<const ScalarBuffer*> cellQuantities(numRegionQuantities);
+        for (int i = 0; i < FipDataType::numFipValues; i++)
+            cellQuantities[i] = &fip_[i];
+        cellQuantities[PressurePv] = &pressureTimesPoreVolume_;
+        cellQuantities[PvHydrocarbon] = &hydrocarbonPoreVolume_;
+        cellQuantities[PressurePvHydrocarbon] = &pressureTimesHydrocarbonVolume_;
+        std::vector<ScalarBuffer> regionValues = computeRegionTotals_(cellQuantities, fipnum_, ntFip);
+
         ScalarBuffer regionFipValues[FipDataType::numFipValues];
         for (int i = 0; i < FipDataType::numFipValues; i++) {
-            regionFipValues[i] = computeFipForRegions_(fip_[i], fipnum_, ntFip);
+            regionFipValues[i] = std::move(regionValues[i]);
             if (isIORank_() && origRegionValues_[i].empty())
                 origRegionValues_[i] = regionFipValues[i];
         }
+        const ScalarBuffer& regPressurePv = regionValues[PressurePv];
+        const ScalarBuffer& regPvHydrocarbon = regionValues[PvHydrocarbon];
+        const ScalarBuffer& regPressurePvHydrocarbon = regionValues[PressurePvHydrocarbon];
 
-        // sum all region values to compute the field total
-        std::vector<int> fieldNum(ntFip, 1);
+        // sum all region values to compute the field total. The region
+        // values are already summed over all ranks.
         ScalarBuffer fieldFipValues(FipDataType::numFipValues, 0.0);
-        bool comunicateSum = false; // the regionValues are already summed over all ranks.
-        for (int i = 0; i<FipDataType::numFipValues; i++) {
-            const ScalarBuffer& tmp = computeFipForRegions_(regionFipValues[i], fieldNum, 1, comunicateSum);
-            fieldFipValues[i] = tmp[0];
-        }
+        for (int i = 0; i<FipDataType::numFipValues; i++)
+            fieldFipValues[i] = std::accumulate(regionFipValues[i].begin(), regionFipValues[i].end(), 0.0);
 
-        // compute the hydrocarbon averaged pressure over the regions.
-        ScalarBuffer regPressurePv = computeFipForRegions_(pressureTimesPoreVolume_, fipnum_, ntFip);
-        ScalarBuffer regPvHydrocarbon = computeFipForRegions_(hydrocarbonPoreVolume_, fipnum_, ntFip);
-        ScalarBuffer regPressurePvHydrocarbon = computeFipForRegions_(pressureTimesHydrocarbonVolume_, fipnum_, ntFip);
-
-        ScalarBuffer fieldPressurePv = computeFipForRegions_(regPressurePv, fieldNum, 1, comunicateSum);
-        ScalarBuffer fieldPvHydrocarbon = computeFipForRegions_(regPvHydrocarbon, fieldNum, 1, comunicateSum);
-        ScalarBuffer fieldPressurePvHydrocarbon = computeFipForRegions_(regPressurePvHydrocarbon, fieldNum, 1, comunicateSum);
+        const ScalarBuffer fieldPressurePv(1, std::accumulate(regPressurePv.begin(), regPressurePv.end(), 0.0));
+        const ScalarBuffer fieldPvHydrocarbon(1, std::accumulate(regPvHydrocarbon.begin(), regPvHydrocarbon.end(), 0.0));
+        const ScalarBuffer fieldPressurePvHydrocarbon(1, std::accumulate(regPressurePvHydrocarbon.begin(), regPressurePvHydrocarbon.end(), 0.0));
 
         // output on io rank
         // the original Fip values are stored on the first step
         // TODO: Store initial Fip in the init file and restore them
         // and use them here.
-        const Opm::SummaryConfig summaryConfig = simulator_.vanguard().summaryConfig();
+        const OutputPlan& plan = outputPlan_;
         if (isIORank_()) {
             // Field summary output
             for (int i = 0; i<FipDataType::numFipValues; i++) {
-                std::string key = "F" + fipEnumToString_(i);
-                if (summaryConfig.hasKeyword(key))
-                    miscSummaryData[key] = fieldFipValues[i];
+                if (plan.fieldFip[i])
+                    miscSummaryData["F" + fipEnumToString_(i)] = fieldFipValues[i];
             }
-            if (summaryConfig.hasKeyword("FOE") && !origTotalValues_.empty())
+            if (plan.foe && !origTotalValues_.empty())
                 miscSummaryData["FOE"] = fieldFipValues[FipDataType::OilInPlace] / origTotalValues_[FipDataType::OilInPlace];
 
-            if (summaryConfig.hasKeyword("FPR"))
+            if (plan.fpr)
                 miscSummaryData["FPR"] = pressureAverage_(fieldPressurePvHydrocarbon[0], fieldPvHydrocarbon[0], fieldPressurePv[0], fieldFipValues[FipDataType::PoreVolume], true);
 
-            if (summaryConfig.hasKeyword("FPRP"))
+            if (plan.fprp)
                 miscSummaryData["FPRP"] = pressureAverage_(fieldPressurePvHydrocarbon[0], fieldPvHydrocarbon[0], fieldPressurePv[0], fieldFipValues[FipDataType::PoreVolume], false);
 
             // Region summary output
             for (int i = 0; i<FipDataType::numFipValues; i++) {
-                std::string key = "R" + fipEnumToString_(i);
-                if (summaryConfig.hasKeyword(key))
-                    regionData[key] = regionFipValues[i];
+                if (plan.regionFip[i])
+                    regionData["R" + fipEnumToString_(i)] = regionFipValues[i];
             }
-            if (summaryConfig.hasKeyword("RPR"))
+            if (plan.rpr)
                 regionData["RPR"] = pressureAverage_(regPressurePvHydrocarbon, regPvHydrocarbon, regPressurePv, regionFipValues[FipDataType::PoreVolume], true);
 
-            if (summaryConfig.hasKeyword("RPRP"))
+            if (plan.rprp)
                 regionData["RPRP"] = pressureAverage_(regPressurePvHydrocarbon, regPvHydrocarbon, regPressurePv, regionFipValues[FipDataType::PoreVolume], false);
 
             // Output to log
@@ -1645,8 +1681,37 @@ public:
         return 0;
     }
 
-    const std::map<std::pair<std::string, int>, double>& getBlockData()
-    { return blockData_; }
+    /*!
+     * \brief The block summary keys of the whole model, the index of a key
+     *        is the slot of its value.
+     */
+    const std::vector<std::pair<std::string, int>>& blockKeys() const
+    { return blockKeys_; }
+
+    /*!
+     * \brief The block summary values, indexed by slot. Only the values of
+     *        the slots in localBlockSlots() are computed on this process.
+     */
+    const std::vector<double>& blockValues() const
+    { return blockValues_; }
+
+    /*!
+     * \brief The slots of the block summary values of this process.
+     */
+    const std::vector<int>& localBlockSlots() const
+    { return localBlockSlots_; }
+
+    /*!
+     * \brief Map the values of the given slots to their summary keys.
+     */
+    std::map<std::pair<std::string, int>, double>
+    blockData(const std::vector<int>& slots, const std::vector<double>& values) const
+    {
+        std::map<std::pair<std::string, int>, double> data;
+        for (const int slot : slots)
+            data.emplace_hint(data.end(), blockKeys_[slot], values[slot]);
+        return data;
+    }
 
 private:
 
@@ -1765,31 +1830,148 @@ private:
         }
     }
 
-    // Sum Fip values over regions.
-    ScalarBuffer computeFipForRegions_(const ScalarBuffer& fip, std::vector<int>& regionId, size_t maxNumberOfRegions, bool commSum = true)
+    static typename BlockDataType::BlockId blockDataId_(const std::string& keyword)
     {
-        ScalarBuffer totals(maxNumberOfRegions, 0.0);
+        if (keyword == "BWSAT")
+            return BlockDataType::WaterSaturation;
+        else if (keyword == "BGSAT")
+            return BlockDataType::GasSaturation;
+        else if (keyword == "BOSAT")
+            return BlockDataType::OilSaturation;
+        else if (keyword == "BPR")
+            return BlockDataType::Pressure;
+        else if (keyword == "BWKR" || keyword == "BKRW")
+            return BlockDataType::WaterRelPerm;
+        else if (keyword == "BGKR" || keyword == "BKRG")
+            return BlockDataType::GasRelPerm;
+        else if (keyword == "BOKR" || keyword == "BKRO")
+            return BlockDataType::OilRelPerm;
+        else if (keyword == "BWPC")
+            return BlockDataType::WaterCapPressure;
+        else if (keyword == "BGPC")
+            return BlockDataType::GasCapPressure;
+        else if (keyword == "BVWAT" || keyword == "BWVIS")
+            return BlockDataType::WaterViscosity;
+        else if (keyword == "BVGAS" || keyword == "BGVIS")
+            return BlockDataType::GasViscosity;
+        else if (keyword == "BVOIL" || keyword == "BOVIS")
+            return BlockDataType::OilViscosity;
+
+        return BlockDataType::Unhandled;
+    }
 
-        if (fip.empty())
-            return totals;
+    // Translate the block summary requests of this process into a table
+    // of quantities per cell, so that processElement() does not need to
+    // look at the keywords.
+    void createBlockDataPlan_()
+    {
+        if (localBlockSlots_.empty())
+            return;
 
-        assert(regionId.size() == fip.size());
-        for (size_t j = 0; j < regionId.size(); ++j) {
-            const int regionIdx = regionId[j] - 1;
-            // the cell is not attributed to any region. ignore it!
-            if (regionIdx < 0)
+        std::unordered_map<int, std::vector<BlockDataEntry>> entriesByCartesianIdx;
+        for (const int slot : localBlockSlots_) {
+            const auto& key = blockKeys_[slot];
+            const auto quantity = blockDataId_(key.first);
+            if (quantity == BlockDataType::Unhandled) {
+                std::string logstring = "Keyword '";
+                logstring.append(key.first);
+                logstring.append("' is unhandled for output to file.");
+                Opm::OpmLog::warning("Unhandled output keyword", logstring);
                 continue;
+            }
+            entriesByCartesianIdx[key.second - 1].push_back(BlockDataEntry{quantity, slot});
+        }
+
+        const auto& vanguard = simulator_.vanguard();
+        const unsigned numElements = vanguard.gridView().size(/*codim=*/0);
+        blockCellOffsets_.resize(numElements + 1, 0);
+        for (unsigned elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+            const auto entries = entriesByCartesianIdx.find(vanguard.cartesianIndex(elemIdx));
+            if (entries != entriesByCartesianIdx.end())
+                blockEntries_.insert(blockEntries_.end(), entries->second.begin(), entries->second.end());
+            blockCellOffsets_[elemIdx + 1] = blockEntries_.size();
+        }
+    }
 
-            assert(regionIdx < static_cast<int>(maxNumberOfRegions));
-            totals[regionIdx] += fip[j];
+    template <class FluidState, class IntensiveQuantities>
+    static double blockValue_(const typename BlockDataType::BlockId quantity,
+                              const FluidState& fs,
+                              const IntensiveQuantities& intQuants)
+    {
+        switch (quantity) {
+        case BlockDataType::WaterSaturation:
+            return Opm::getValue(fs.saturation(waterPhaseIdx));
+        case BlockDataType::GasSaturation:
+            return Opm::getValue(fs.saturation(gasPhaseIdx));
+        case BlockDataType::OilSaturation:
+            return 1. - Opm::getValue(fs.saturation(gasPhaseIdx)) - Opm::getValue(fs.saturation(waterPhaseIdx));
+        case BlockDataType::Pressure:
+            return Opm::getValue(fs.pressure(oilPhaseIdx));
+        case BlockDataType::WaterRelPerm:
+            return Opm::getValue(intQuants.relativePermeability(waterPhaseIdx));
+        case BlockDataType::GasRelPerm:
+            return Opm::getValue(intQuants.relativePermeability(gasPhaseIdx));
+        case BlockDataType::OilRelPerm:
+            return Opm::getValue(intQuants.relativePermeability(oilPhaseIdx));
+        case BlockDataType::WaterCapPressure:
+            return Opm::getValue(fs.pressure(oilPhaseIdx)) - Opm::getValue(fs.pressure(waterPhaseIdx));
+        case BlockDataType::GasCapPressure:
+            return Opm::getValue(fs.pressure(gasPhaseIdx)) - Opm::getValue(fs.pressure(oilPhaseIdx));
+        case BlockDataType::WaterViscosity:
+            return Opm::getValue(fs.viscosity(waterPhaseIdx));
+        case BlockDataType::GasViscosity:
+            return Opm::getValue(fs.viscosity(gasPhaseIdx));
+        case BlockDataType::OilViscosity:
+            return Opm::getValue(fs.viscosity(oilPhaseIdx));
+        default:
+            return 0.0;
         }
-        if (commSum) {
+    }
+
+    // Sum cell values over regions and over all processes. The totals of
+    // all quantities are accumulated in one contiguous buffer, so that
+    // they are reduced with a single collective. Empty quantities yield
+    // zero totals.
+    std::vector<ScalarBuffer> computeRegionTotals_(const std::vector<const ScalarBuffer*>& quantities,
+                                                   const std::vector<int>& regionId,
+                                                   size_t maxNumberOfRegions)
+    {
+        const int numQuantities = quantities.size();
+        ScalarBuffer totals(numQuantities*maxNumberOfRegions, 0.0);
+
+        // each thread accumulates whole quantities, so no two threads
+        // write to the same total.
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int q = 0; q < numQuantities; ++q) {
+            const ScalarBuffer& values = *quantities[q];
+            if (values.empty())
+                continue;
+
+            assert(regionId.size() == values.size());
+            Scalar* regionTotals = totals.data() + q*maxNumberOfRegions;
+            for (size_t j = 0; j < regionId.size(); ++j) {
+                const int regionIdx = regionId[j] - 1;
+                // the cell is not attributed to any region. ignore it!
+                if (regionIdx < 0)
+                    continue;
+
+                assert(regionIdx < static_cast<int>(maxNumberOfRegions));
+                regionTotals[regionIdx] += values[j];
+            }
+        }
+
+        if (!totals.empty()) {
             const auto& comm = simulator_.gridView().comm();
-            for (size_t i = 0; i < maxNumberOfRegions; ++i)
-                totals[i] = comm.sum(totals[i]);
+            comm.sum(totals.data(), totals.size());
         }
 
-        return totals;
+        std::vector<ScalarBuffer> result(numQuantities);
+        for (int q = 0; q < numQuantities; ++q)
+            result[q].assign(totals.begin() + q*maxNumberOfRegions, totals.begin() + (q + 1)*maxNumberOfRegions);
+
+        return result;
     }
 
     ScalarBuffer pressureAverage_(const ScalarBuffer& pressurePvHydrocarbon, const ScalarBuffer& pvHydrocarbon, const ScalarBuffer& pressurePv, const ScalarBuffer& pv, bool hydrocarbon)
@@ -2145,7 +2327,39 @@ private:
     ScalarBuffer hydrocarbonPoreVolume_;
     ScalarBuffer pressureTimesPoreVolume_;
     ScalarBuffer pressureTimesHydrocarbonVolume_;
-    std::map<std::pair<std::string, int>, double> blockData_;
+    struct OutputPlan
+    {
+        int reportStepNum = -1;
+        // 3D fields required by the summary
+        bool fip3D[FipDataType::numFipValues] = {};
+        bool pressureAverages = false;
+        // field and region summary keywords
+        bool fieldFip[FipDataType::numFipValues] = {};
+        bool regionFip[FipDataType::numFipValues] = {};
+        bool foe = false;
+        bool fpr = false;
+        bool fprp = false;
+        bool rpr = false;
+        bool rprp = false;
+        // RESTART_AUXILIARY keywords and their values
+        std::map<std::string, int> restartKeywords;
+        bool restartFip = false;
+        // cartesian indices of the connections for RFT output
+        std::vector<size_t> rftConnections;
+    };
+    OutputPlan outputPlan_;
+
+    struct BlockDataEntry
+    {
+        typename BlockDataType::BlockId quantity;
+        int slot;
+    };
+    std::vector<std::pair<std::string, int>> blockKeys_;
+    std::vector<double> blockValues_;
+    std::vector<int> localBlockSlots_;
+    // block summary quantities of cell i are blockEntries_[blockCellOffsets_[i]:blockCellOffsets_[i+1]]
+    std::vector<int> blockCellOffsets_;
+    std::vector<BlockDataEntry> blockEntries_;
     std::map<size_t, Scalar> oilConnectionPressures_;
     std::map<size_t, Scalar> waterConnectionSaturations_;
     std::map<size_t, Scalar> gasConnectionSaturations_;
@@ -68,6 +68,8 @@
 #include <opm/models/utils/pffgridvector.hh>
 #include <opm/models/blackoil/blackoilmodel.hh>
 #include <opm/models/discretization/ecfv/ecfvdiscretization.hh>
+#include <opm/simulators/utils/Checkpoint.hpp>
+#include <opm/simulators/utils/PerformanceProfile.hpp>
 
 #include <opm/material/fluidmatrixinteractions/EclMaterialLawManager.hpp>
 #include <opm/material/thermal/EclThermalLawManager.hpp>
@@ -768,12 +770,62 @@ public:
         // reload the current episode/report step from the deck
         beginEpisode();
 
-        // deserialize the wells
+        deserializeState(res);
+    }
+
+    /*!
+     * \brief Restores the state of the problem and its sub-objects written by
+     *        serialize() without beginning the current episode again.
+     *
+     * The modifications of the grid properties by the SCHEDULE section of the
+     * episodes before the current one are applied again.
+     */
+    template <class Restarter>
+    void deserializeState(Restarter& res)
+    {
+        reapplyModifierDecks_();
+
         wellModel_.deserialize(res);
 
         if (enableAquifers_)
             // deserialize the aquifer
             aquiferModel_.deserialize(res);
+
+        tracerModel_.deserialize(res);
+
+        res.deserializeSectionBegin("EclProblem");
+        auto& is = res.deserializeStream();
+        Opm::Checkpoint::read(is, referencePorosity_[0]);
+        Opm::Checkpoint::read(is, referencePorosity_[1]);
+        Opm::Checkpoint::read(is, maxOilSaturation_);
+        Opm::Checkpoint::read(is, maxWaterSaturation_);
+        Opm::Checkpoint::read(is, minOilPressure_);
+        Opm::Checkpoint::read(is, lastRs_);
+        Opm::Checkpoint::read(is, lastRv_);
+        Opm::Checkpoint::read(is, maxPolymerAdsorption_);
+
+        std::uint64_t driftSize;
+        Opm::Checkpoint::read(is, driftSize);
+        drift_.resize(driftSize);
+        for (auto& d : drift_)
+            for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx)
+                Opm::Checkpoint::read(is, d[eqIdx]);
+
+        if (materialLawManager_->enableHysteresis()) {
+            size_t numDof = this->model().numGridDof();
+            for (unsigned dofIdx = 0; dofIdx < numDof; ++dofIdx) {
+                Scalar pcSwMdc, krnSwMdc;
+                Opm::Checkpoint::read(is, pcSwMdc);
+                Opm::Checkpoint::read(is, krnSwMdc);
+                materialLawManager_->setOilWaterHysteresisParams(pcSwMdc, krnSwMdc, dofIdx);
+                Opm::Checkpoint::read(is, pcSwMdc);
+                Opm::Checkpoint::read(is, krnSwMdc);
+                materialLawManager_->setGasOilHysteresisParams(pcSwMdc, krnSwMdc, dofIdx);
+            }
+        }
+        res.deserializeSectionEnd();
+
+        this->model().invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
     }
 
     /*!
@@ -789,6 +841,38 @@ public:
 
         if (enableAquifers_)
             aquiferModel_.serialize(res);
+
+        tracerModel_.serialize(res);
+
+        res.serializeSectionBegin("EclProblem");
+        auto& os = res.serializeStream();
+        Opm::Checkpoint::write(os, referencePorosity_[0]);
+        Opm::Checkpoint::write(os, referencePorosity_[1]);
+        Opm::Checkpoint::write(os, maxOilSaturation_);
+        Opm::Checkpoint::write(os, maxWaterSaturation_);
+        Opm::Checkpoint::write(os, minOilPressure_);
+        Opm::Checkpoint::write(os, lastRs_);
+        Opm::Checkpoint::write(os, lastRv_);
+        Opm::Checkpoint::write(os, maxPolymerAdsorption_);
+
+        Opm::Checkpoint::write(os, static_cast<std::uint64_t>(drift_.size()));
+        for (const auto& d : drift_)
+            for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx)
+                Opm::Checkpoint::write(os, d[eqIdx]);
+
+        if (materialLawManager_->enableHysteresis()) {
+            size_t numDof = this->model().numGridDof();
+            for (unsigned dofIdx = 0; dofIdx < numDof; ++dofIdx) {
+                Scalar pcSwMdc, krnSwMdc;
+                materialLawManager_->oilWaterHysteresisParams(pcSwMdc, krnSwMdc, dofIdx);
+                Opm::Checkpoint::write(os, pcSwMdc);
+                Opm::Checkpoint::write(os, krnSwMdc);
+                materialLawManager_->gasOilHysteresisParams(pcSwMdc, krnSwMdc, dofIdx);
+                Opm::Checkpoint::write(os, pcSwMdc);
+                Opm::Checkpoint::write(os, krnSwMdc);
+            }
+        }
+        res.serializeSectionEnd();
     }
 
     /*!
@@ -861,6 +945,10 @@ public:
         // set up the wells for the next episode.
         wellModel_.beginEpisode();
 
+        // evaluate the output requirements of the report step
+        if (enableEclOutput_)
+            eclWriter_->beginEpisode();
+
         // set up the aquifers for the next episode.
         if (enableAquifers_)
             // set up the aquifers for the next episode.
@@ -944,8 +1032,10 @@ public:
     void beginIteration()
     {
         wellModel_.beginIteration();
-        if (enableAquifers_)
+        if (enableAquifers_) {
+            Opm::PerformanceProfile::ScopedTimer profileTimer("aquifers");
             aquiferModel_.beginIteration();
+        }
     }
 
     /*!
@@ -1141,6 +1231,35 @@ public:
         return pffDofData_.get(context.element(), toDofLocalIdx).transmissibility;
     }
 
+    /*!
+     * \brief Returns the depth of the center of the first degree of freedom minus the
+     *        one of the second degree of freedom.
+     */
+    template <class Context>
+    Scalar depthDifference(const Context& context,
+                           unsigned OPM_OPTIM_UNUSED fromDofLocalIdx,
+                           unsigned toDofLocalIdx) const
+    {
+        assert(fromDofLocalIdx == 0);
+        return pffDofData_.get(context.element(), toDofLocalIdx).depthDifference;
+    }
+
+    /*!
+     * \brief Returns true if the first degree of freedom is upstream of the second one
+     *        if the potential difference between them vanishes.
+     *
+     * This is the degree of freedom with the larger volume, or the one with the smaller
+     * global index if the volumes are equal.
+     */
+    template <class Context>
+    bool tieUpstreamIsFrom(const Context& context,
+                           unsigned OPM_OPTIM_UNUSED fromDofLocalIdx,
+                           unsigned toDofLocalIdx) const
+    {
+        assert(fromDofLocalIdx == 0);
+        return pffDofData_.get(context.element(), toDofLocalIdx).tieUpstreamIsCenter;
+    }
+
     /*!
      * \copydoc EclTransmissiblity::transmissibilityBoundary
      */
@@ -2379,7 +2498,7 @@ private:
         int ny = eclGrid.getNY();
         for (size_t dofIdx = 0; dofIdx < numDof; ++ dofIdx) {
             unsigned cartElemIdx = vanguard.cartesianIndex(dofIdx);
-            Scalar poreVolume = porvData[cartElemIdx];
+            Scalar poreVolume = vanguard.fieldPropertyMultiplier("PORO", cartElemIdx)*porvData[cartElemIdx];
 
             // sum up the pore volume of the active cell and all inactive ones above it
             // which were disabled due to their pore volume being too small. If energy is
@@ -2402,7 +2521,7 @@ private:
                         // greater than 10^-3 m^3
                         break;
 
-                    poreVolume += porvData[aboveElemCartIdx];
+                    poreVolume += vanguard.fieldPropertyMultiplier("PORO", aboveElemCartIdx)*porvData[aboveElemCartIdx];
                 }
             }
 
@@ -2922,13 +3041,41 @@ private:
         updateNum("PLMIXNUM", plmixnum_);
     }
 
+    // apply the modifications of the grid properties by the episodes before the
+    // current one, which a run that is restarted from a checkpoint has not seen
+    void reapplyModifierDecks_()
+    {
+        auto& simulator = this->simulator();
+        auto& eclState = simulator.vanguard().eclState();
+        const auto& schedule = simulator.vanguard().schedule();
+        const auto& events = schedule.getEvents();
+
+        bool modified = false;
+        for (int episodeIdx = 0; episodeIdx < simulator.episodeIndex(); ++episodeIdx) {
+            if (events.hasEvent(Opm::ScheduleEvents::GEO_MODIFIER, episodeIdx)) {
+                eclState.applyModifierDeck(schedule.getModifierDeck(episodeIdx));
+                modified = true;
+            }
+        }
+
+        if (modified) {
+            transmissibilities_.update();
+            updatePffDofData_();
+        }
+    }
+
     struct PffDofData_
     {
         Opm::ConditionalStorage<enableEnergy, Scalar> thermalHalfTrans;
         Scalar transmissibility;
+        Scalar depthDifference;
+        bool tieUpstreamIsCenter;
     };
 
-    // update the prefetch friendly data object
+    // update the prefetch friendly data object. besides the transmissibility, the
+    // quantities of the flux computation which do not depend on the solution are
+    // stored, so the depths and volumes of both elements need not be looked up for
+    // every flux evaluation.
     void updatePffDofData_()
     {
         const auto& distFn =
@@ -2943,6 +3090,14 @@ private:
             if (localDofIdx != 0) {
                 unsigned globalCenterElemIdx = elementMapper.index(stencil.entity(/*dofIdx=*/0));
                 dofData.transmissibility = transmissibilities_.transmissibility(globalCenterElemIdx, globalElemIdx);
+                dofData.depthDifference = elementCenterDepth_[globalCenterElemIdx] - elementCenterDepth_[globalElemIdx];
+
+                Scalar centerVolume = stencil.subControlVolume(/*dofIdx=*/0).volume();
+                Scalar volume = stencil.subControlVolume(localDofIdx).volume();
+                if (centerVolume != volume)
+                    dofData.tieUpstreamIsCenter = centerVolume > volume;
+                else
+                    dofData.tieUpstreamIsCenter = globalCenterElemIdx < globalElemIdx;
 
                 if (enableEnergy)
                     *dofData.thermalHalfTrans = transmissibilities_.thermalHalfTrans(globalCenterElemIdx, globalElemIdx);
@@ -31,13 +31,25 @@
 #include "tracervdtable.hh"
 
 #include <opm/models/blackoil/blackoilmodel.hh>
+#include <opm/simulators/utils/Checkpoint.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/ParallelIstlInformation.hpp>
+#include <opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp>
+#include <opm/simulators/linalg/findOverlapRowsAndColumns.hpp>
 
 #include <dune/istl/operators.hh>
 #include <dune/istl/solvers.hh>
 #include <dune/istl/preconditioners.hh>
+#include <dune/istl/scalarproducts.hh>
+#include <dune/istl/owneroverlapcopy.hh>
 
 #include <dune/common/version.hh>
 
+#include <boost/any.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -55,7 +67,9 @@ namespace Opm {
  *
  * \brief A class which handles tracers as specified in by ECL
  *
- * TODO: MPI parallelism.
+ * In parallel runs, each process assembles the tracer equations of its
+ * interior cells and the tracer concentrations of the overlap cells are
+ * communicated after each linear solve.
  */
 template <class TypeTag>
 class EclTracerModel
@@ -64,7 +78,6 @@ class EclTracerModel
     typedef typename GET_PROP_TYPE(TypeTag, GridView) GridView;
     typedef typename GET_PROP_TYPE(TypeTag, Grid) Grid;
     typedef typename GET_PROP_TYPE(TypeTag, Scalar) Scalar;
-    typedef typename GET_PROP_TYPE(TypeTag, Stencil) Stencil;
     typedef typename GET_PROP_TYPE(TypeTag, FluidSystem) FluidSystem;
     typedef typename GET_PROP_TYPE(TypeTag, ElementContext) ElementContext;
     typedef typename GET_PROP_TYPE(TypeTag, RateVector) RateVector;
@@ -78,11 +91,14 @@ class EclTracerModel
     enum { oilPhaseIdx = FluidSystem::oilPhaseIdx };
     enum { gasPhaseIdx = FluidSystem::gasPhaseIdx };
 
-    typedef typename GridView::template Codim<0>::Entity Element;
-    typedef typename GridView::template Codim<0>::Iterator ElementIterator;
-
     typedef Dune::BCRSMatrix<Dune::FieldMatrix<Scalar, 1, 1>> TracerMatrix;
     typedef Dune::BlockVector<Dune::FieldVector<Scalar,1>> TracerVector;
+    typedef Dune::AssembledLinearOperator<TracerMatrix, TracerVector, TracerVector> TracerOperator;
+    typedef Dune::ScalarProduct<TracerVector> TracerScalarProduct;
+    typedef Dune::Preconditioner<TracerVector, TracerVector> TracerPreconditioner;
+#if HAVE_MPI
+    typedef Dune::OwnerOverlapCopyCommunication<int, int> TracerCommunication;
+#endif
 
 public:
     EclTracerModel(Simulator& simulator)
@@ -119,11 +135,21 @@ public:
             throw std::runtime_error("The deck does not contain the TRACER keyword");
 
         if (simulator_.gridView().comm().size() > 1) {
-            tracerNames_.resize(0);
-            if (simulator_.gridView().comm().rank() == 0)
-                std::cout << "Warning: The tracer model currently does not work for parallel runs\n"
-                          << std::flush;
-            return;
+            extractParallelGridInformationToISTL(simulator_.vanguard().grid(), parallelInformation_);
+            if (!isParallel_()) {
+                tracerNames_.resize(0);
+                if (simulator_.gridView().comm().rank() == 0)
+                    std::cout << "Warning: The tracer model does not support parallel runs on this grid\n"
+                              << std::flush;
+                return;
+            }
+#if HAVE_MPI
+            const auto& info = boost::any_cast<const ParallelISTLInformation&>(parallelInformation_);
+            tracerComm_.reset(new TracerCommunication(info.communicator()));
+            info.copyValuesTo(tracerComm_->indexSet(), tracerComm_->remoteIndices(),
+                              simulator_.model().numGridDof(), 1);
+#endif
+            detail::findOverlapAndInterior(simulator_.vanguard().grid(), overlapRows_, interiorRows_);
         }
 
         // retrieve the number of tracers from the deck
@@ -197,52 +223,19 @@ public:
         // residual of tracers
         tracerResidual_.resize(numGridDof);
 
-        // allocate matrix for storing the Jacobian of the tracer residual
-        tracerMatrix_ = new TracerMatrix(numGridDof, numGridDof, TracerMatrix::random);
-
-        // find the sparsity pattern of the tracer matrix
-        typedef std::set<unsigned> NeighborSet;
-        std::vector<NeighborSet> neighbors(numGridDof);
-
-        Stencil stencil(simulator_.gridView(), simulator_.model().dofMapper() );
-        ElementIterator elemIt = simulator_.gridView().template begin<0>();
-        const ElementIterator elemEndIt = simulator_.gridView().template end<0>();
-        for (; elemIt != elemEndIt; ++elemIt) {
-            const Element& elem = *elemIt;
-            stencil.update(elem);
-
-            for (unsigned primaryDofIdx = 0; primaryDofIdx < stencil.numPrimaryDof(); ++primaryDofIdx) {
-                unsigned myIdx = stencil.globalSpaceIndex(primaryDofIdx);
-
-                for (unsigned dofIdx = 0; dofIdx < stencil.numDof(); ++dofIdx) {
-                    unsigned neighborIdx = stencil.globalSpaceIndex(dofIdx);
-                    neighbors[myIdx].insert(neighborIdx);
-                }
-            }
-        }
-
-        // allocate space for the rows of the matrix
-        for (unsigned dofIdx = 0; dofIdx < numGridDof; ++ dofIdx)
-            tracerMatrix_->setrowsize(dofIdx, neighbors[dofIdx].size());
-        tracerMatrix_->endrowsizes();
-
-        // fill the rows with indices. each degree of freedom talks to
-        // all of its neighbors. (it also talks to itself since
-        // degrees of freedom are sometimes quite egocentric.)
-        for (unsigned dofIdx = 0; dofIdx < numGridDof; ++ dofIdx) {
-            typename NeighborSet::iterator nIt = neighbors[dofIdx].begin();
-            typename NeighborSet::iterator nEndIt = neighbors[dofIdx].end();
-            for (; nIt != nEndIt; ++nIt)
-                tracerMatrix_->addindex(dofIdx, *nIt);
-        }
-        tracerMatrix_->endindices();
+        // the matrix for the Jacobian of the tracer residual is allocated at the
+        // end of the first time step, when the Jacobian of the flow model exists
 
         const int sizeCartGrid = simulator_.vanguard().cartesianSize();
-        cartToGlobal_.resize(sizeCartGrid);
+        cartToGlobal_.assign(sizeCartGrid, -1);
         for (unsigned i = 0; i < numGridDof; ++i) {
             int cartIdx = simulator_.vanguard().cartesianIndex(i);
             cartToGlobal_[cartIdx] = i;
         }
+        // the well connections of the overlap cells are accounted for by the
+        // process which owns them
+        for (const int overlapIdx : overlapRows_)
+            cartToGlobal_[simulator_.vanguard().cartesianIndex(overlapIdx)] = -1;
 
     }
 
@@ -286,6 +279,9 @@ public:
         auto elemIt = simulator_.gridView().template begin</*codim=*/0>();
         auto elemEndIt = simulator_.gridView().template end</*codim=*/0>();
         for (; elemIt != elemEndIt; ++ elemIt) {
+            if (elemIt->partitionType() != Dune::InteriorEntity)
+                continue;
+
             elemCtx.updateAll(*elemIt);
             int globalDofIdx = elemCtx.globalSpaceIndex(0, 0);
             for (int tracerIdx = 0; tracerIdx < numTracers(); ++ tracerIdx){
@@ -304,16 +300,26 @@ public:
         if (numTracers()==0)
             return;
 
+        if (!tracerMatrix_)
+            setupLinearSolver_();
+
+        // the Jacobian of the tracer residual only depends on the phase of the
+        // tracer, so the preconditioner is only set up once per phase
+        int preconditionerPhaseIdx = -1;
         for (int tracerIdx = 0; tracerIdx < numTracers(); ++ tracerIdx){
 
             TracerVector dx(tracerResidual_.size());
             // Newton step (currently the system is linear, converge in one iteration)
             for (int iter = 0; iter < 5; ++ iter){
                 linearize_(tracerIdx);
-                linearSolve_(*tracerMatrix_, dx, tracerResidual_);
+                if (preconditionerPhaseIdx != tracerPhaseIdx_[tracerIdx]) {
+                    updatePreconditioner_();
+                    preconditionerPhaseIdx = tracerPhaseIdx_[tracerIdx];
+                }
+                linearSolve_(dx, tracerResidual_);
                 tracerConcentration_[tracerIdx] -= dx;
 
-                if (dx.two_norm()<1e-2)
+                if (tracerScalarProduct_->norm(dx)<1e-2)
                     break;
             }
         }
@@ -324,8 +330,17 @@ public:
      *        to the hard disk.
      */
     template <class Restarter>
-    void serialize(Restarter& res OPM_UNUSED)
-    { /* not implemented */ }
+    void serialize(Restarter& res)
+    {
+        res.serializeSectionBegin("EclTracerModel");
+        auto& os = res.serializeStream();
+        for (const auto& concentration : tracerConcentration_) {
+            Opm::Checkpoint::write(os, static_cast<std::uint64_t>(concentration.size()));
+            for (const auto& c : concentration)
+                Opm::Checkpoint::write(os, c[0]);
+        }
+        res.serializeSectionEnd();
+    }
 
     /*!
      * \brief This method restores the complete state of the tracer
@@ -334,8 +349,19 @@ public:
      * It is the inverse of the serialize() method.
      */
     template <class Restarter>
-    void deserialize(Restarter& res OPM_UNUSED)
-    { /* not implemented */ }
+    void deserialize(Restarter& res)
+    {
+        res.deserializeSectionBegin("EclTracerModel");
+        auto& is = res.deserializeStream();
+        for (auto& concentration : tracerConcentration_) {
+            std::uint64_t size;
+            Opm::Checkpoint::read(is, size);
+            concentration.resize(size);
+            for (auto& c : concentration)
+                Opm::Checkpoint::read(is, c[0]);
+        }
+        res.deserializeSectionEnd();
+    }
 
 protected:
     // evaluate storage term for all tracers in a single cell
@@ -400,33 +426,89 @@ protected:
 
     }
 
-    bool linearSolve_(const TracerMatrix& M, TracerVector& x, TracerVector& b)
+    bool isParallel_() const
+    {
+#if HAVE_MPI
+        return parallelInformation_.type() == typeid(ParallelISTLInformation);
+#else
+        return false;
+#endif
+    }
+
+    // allocate the Jacobian of the tracer residual and the parts of the linear
+    // solver which only depend on its sparsity pattern. The tracer equations
+    // couple the same cells as the flow equations, so the pattern of the
+    // Jacobian of the flow model is used. (it additionally contains the
+    // couplings of the well cells, which are harmless.)
+    void setupLinearSolver_()
+    {
+        const auto& flowMatrix = simulator_.model().linearizer().jacobian().istlMatrix();
+        assert(flowMatrix.N() == simulator_.model().numGridDof());
+
+        tracerMatrix_.reset(new TracerMatrix(flowMatrix.N(), flowMatrix.M(),
+                                             flowMatrix.nonzeroes(), TracerMatrix::row_wise));
+        auto flowRowIt = flowMatrix.begin();
+        for (auto rowIt = tracerMatrix_->createbegin(); rowIt != tracerMatrix_->createend(); ++rowIt, ++flowRowIt) {
+            for (auto colIt = flowRowIt->begin(); colIt != flowRowIt->end(); ++colIt)
+                rowIt.insert(colIt.index());
+        }
+
+#if HAVE_MPI
+        if (isParallel_()) {
+            typedef Dune::OverlappingSchwarzOperator<TracerMatrix, TracerVector, TracerVector,
+                                                     TracerCommunication> ParallelTracerOperator;
+            tracerOperator_.reset(new ParallelTracerOperator(*tracerMatrix_, *tracerComm_));
+            tracerScalarProduct_ =
+                Dune::createScalarProduct<TracerVector, TracerCommunication>(*tracerComm_,
+                                                                             tracerOperator_->category());
+            return;
+        }
+#endif
+        tracerOperator_.reset(new Dune::MatrixAdapter<TracerMatrix, TracerVector, TracerVector>(*tracerMatrix_));
+        tracerScalarProduct_.reset(new Dune::SeqScalarProduct<TracerVector>());
+    }
+
+    // (re-)compute the ILU0 decomposition of the current Jacobian
+    void updatePreconditioner_()
     {
 #if ! DUNE_VERSION_NEWER(DUNE_COMMON, 2,7)
         Dune::FMatrixPrecision<Scalar>::set_singular_limit(1.e-30);
         Dune::FMatrixPrecision<Scalar>::set_absolute_limit(1.e-30);
 #endif
+#if HAVE_MPI
+        if (isParallel_()) {
+            typedef ParallelOverlappingILU0<TracerMatrix, TracerVector, TracerVector,
+                                            TracerCommunication> ParallelTracerPreconditioner;
+            tracerPreconditioner_.reset(new ParallelTracerPreconditioner(*tracerMatrix_, *tracerComm_, 0, 1.0,
+                                                                         MILU_VARIANT::ILU));
+            return;
+        }
+#endif
+        typedef ParallelOverlappingILU0<TracerMatrix, TracerVector, TracerVector> SeqTracerPreconditioner;
+        tracerPreconditioner_.reset(new SeqTracerPreconditioner(*tracerMatrix_, 0, 1.0, MILU_VARIANT::ILU));
+    }
+
+    bool linearSolve_(TracerVector& x, TracerVector& b)
+    {
         x = 0.0;
         Scalar tolerance = 1e-2;
         int maxIter = 100;
 
         int verbosity = 0;
         typedef Dune::BiCGSTABSolver<TracerVector> TracerSolver;
-        typedef Dune::MatrixAdapter<TracerMatrix, TracerVector , TracerVector > TracerOperator;
-        typedef Dune::SeqScalarProduct< TracerVector > TracerScalarProduct ;
-        typedef Dune::SeqILU< TracerMatrix, TracerVector, TracerVector  > TracerPreconditioner;
-
-        TracerOperator tracerOperator(M);
-        TracerScalarProduct tracerScalarProduct;
-        TracerPreconditioner tracerPreconditioner(M, 0, 1); // results in ILU0
-
-        TracerSolver solver (tracerOperator, tracerScalarProduct,
-                             tracerPreconditioner, tolerance, maxIter,
+        TracerSolver solver (*tracerOperator_, *tracerScalarProduct_,
+                             *tracerPreconditioner_, tolerance, maxIter,
                              verbosity);
 
         Dune::InverseOperatorResult result;
         solver.apply(x, b, result);
 
+#if HAVE_MPI
+        // update the overlap cells with the solution of their owners
+        if (isParallel_())
+            tracerComm_->copyOwnerToAll(x, x);
+#endif
+
         // return the result of the solver
         return result.converged;
     }
@@ -442,6 +524,9 @@ protected:
         auto elemIt = simulator_.gridView().template begin</*codim=*/0>();
         auto elemEndIt = simulator_.gridView().template end</*codim=*/0>();
         for (; elemIt != elemEndIt; ++ elemIt) {
+            if (elemIt->partitionType() != Dune::InteriorEntity)
+                continue;
+
             elemCtx.updateAll(*elemIt);
 
             Scalar extrusionFactor =
@@ -502,6 +587,9 @@ protected:
                 cartesianCoordinate[2] = connection.getK();
                 const size_t cartIdx = simulator_.vanguard().cartesianIndex(cartesianCoordinate);
                 const int I = cartToGlobal_[cartIdx];
+                if (I < 0)
+                    continue;
+
                 Scalar rate = simulator_.problem().wellModel().well(well.name())->volumetricSurfaceRateForConnection(I, tracerPhaseIdx_[tracerIdx]);
                 if (rate > 0)
                     tracerResidual_[I][0] -= rate*wtracer;
@@ -509,6 +597,14 @@ protected:
                     tracerResidual_[I][0] -= rate*tracerConcentration_[tracerIdx][I];
             }
         }
+
+        // the equations of the overlap cells are solved by the processes which
+        // own them
+        for (const int overlapIdx : overlapRows_) {
+            (*tracerMatrix_)[overlapIdx] = 0.0;
+            (*tracerMatrix_)[overlapIdx][overlapIdx] = 1.0;
+            tracerResidual_[overlapIdx] = 0.0;
+        }
     }
 
     Simulator& simulator_;
@@ -517,11 +613,23 @@ protected:
     std::vector<int> tracerPhaseIdx_;
     std::vector<Dune::BlockVector<Dune::FieldVector<Scalar, 1>>> tracerConcentration_;
     std::vector<Dune::BlockVector<Dune::FieldVector<Scalar, 1>>> tracerConcentrationInitial_;
-    TracerMatrix *tracerMatrix_;
+    std::unique_ptr<TracerMatrix> tracerMatrix_;
     TracerVector tracerResidual_;
     std::vector<int> cartToGlobal_;
     std::vector<Dune::BlockVector<Dune::FieldVector<Scalar, 1>>> storageOfTimeIndex1_;
 
+    // parallel communication and the linear solver, which are reused by all
+    // time steps
+    boost::any parallelInformation_;
+#if HAVE_MPI
+    std::unique_ptr<TracerCommunication> tracerComm_;
+#endif
+    std::vector<int> overlapRows_;
+    std::vector<int> interiorRows_;
+    std::unique_ptr<TracerOperator> tracerOperator_;
+    std::shared_ptr<TracerScalarProduct> tracerScalarProduct_;
+    std::unique_ptr<TracerPreconditioner> tracerPreconditioner_;
+
 };
 } // namespace Opm
 
@@ -715,9 +715,9 @@ private:
             for (size_t dofIdx = 0; dofIdx < numElem; ++ dofIdx) {
                 unsigned cartesianElemIdx = vanguard_.cartesianIndex(dofIdx);
                 permeability_[dofIdx] = 0.0;
-                permeability_[dofIdx][0][0] = permxData[cartesianElemIdx];
-                permeability_[dofIdx][1][1] = permyData[cartesianElemIdx];
-                permeability_[dofIdx][2][2] = permzData[cartesianElemIdx];
+                permeability_[dofIdx][0][0] = vanguard_.fieldPropertyMultiplier("PERMX", cartesianElemIdx)*permxData[cartesianElemIdx];
+                permeability_[dofIdx][1][1] = vanguard_.fieldPropertyMultiplier("PERMY", cartesianElemIdx)*permyData[cartesianElemIdx];
+                permeability_[dofIdx][2][2] = vanguard_.fieldPropertyMultiplier("PERMZ", cartesianElemIdx)*permzData[cartesianElemIdx];
             }
 
             // for now we don't care about non-diagonal entries
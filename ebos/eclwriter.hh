@@ -44,6 +44,7 @@
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 
 #include <opm/simulators/utils/ParallelRestart.hpp>
+#include <opm/simulators/utils/PerformanceProfile.hpp>
 #include <opm/grid/GridHelpers.hpp>
 #include <opm/grid/utility/cartesianToCompressed.hpp>
 
@@ -52,6 +53,7 @@
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <atomic>
 #include <list>
 #include <utility>
 #include <string>
@@ -179,6 +181,8 @@ public:
         : simulator_(simulator)
         , collectToIORank_(simulator_.vanguard())
         , eclOutputModule_(simulator, collectToIORank_)
+        , numPendingWrites_(0)
+        , summaryEvalTime_(-1.0)
     {
         if (collectToIORank_.isIORank()) {
             eclIO_.reset(new Opm::EclipseIO(simulator_.vanguard().eclState(),
@@ -249,6 +253,7 @@ public:
         if (reportStepNum == 0)
             return;
 
+        Opm::PerformanceProfile::ScopedTimer profileTimer("summary");
         Scalar curTime = simulator_.time() + simulator_.timeStepSize();
         Scalar totalCpuTime =
             simulator_.executionTimer().realTimeElapsed() +
@@ -271,9 +276,14 @@ public:
             elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
             eclOutputModule_.processElement(elemCtx);
         }
+        // the element buffers now hold the state at curTime; substep output for the
+        // same time level can reuse them instead of processing all elements again.
+        summaryEvalTime_ = curTime;
 
-        if (collectToIORank_.isParallel())
-            collectToIORank_.collect({}, eclOutputModule_.getBlockData(), localWellData);
+        if (collectToIORank_.isParallel()) {
+            Opm::PerformanceProfile::ScopedTimer gatherTimer("gather");
+            collectToIORank_.collect({}, eclOutputModule_.localBlockSlots(), eclOutputModule_.blockValues(), localWellData);
+        }
 
         std::map<std::string, double> miscSummaryData;
         std::map<std::string, std::vector<double>> regionData;
@@ -297,10 +307,10 @@ public:
 
             const Opm::data::Wells& wellData = collectToIORank_.isParallel() ? collectToIORank_.globalWellData() : localWellData;
 
-            const std::map<std::pair<std::string, int>, double>& blockData
+            const auto blockData
                 = collectToIORank_.isParallel()
-                ? collectToIORank_.globalBlockData()
-                : eclOutputModule_.getBlockData();
+                ? eclOutputModule_.blockData(collectToIORank_.globalBlockSlots(), collectToIORank_.globalBlockValues())
+                : eclOutputModule_.blockData(eclOutputModule_.localBlockSlots(), eclOutputModule_.blockValues());
 
             summary.eval(summaryState(),
                          reportStepNum,
@@ -333,12 +343,19 @@ public:
 
     void writeOutput(bool isSubStep)
     {
+        Opm::PerformanceProfile::ScopedTimer profileTimer("output");
         Scalar curTime = simulator_.time() + simulator_.timeStepSize();
-        Scalar nextStepSize = simulator_.problem().nextTimeStepSize();
 
         // output using eclWriter if enabled
         Opm::data::Wells localWellData = simulator_.problem().wellModel().wellData();
 
+        if (isSubStep && summaryEvalTime_ == curTime) {
+            writeSubStepOutput_(curTime, std::move(localWellData));
+            return;
+        }
+
+        Scalar nextStepSize = simulator_.problem().nextTimeStepSize();
+
         int reportStepNum = simulator_.episodeIndex() + 1;
         const auto& gridView = simulator_.vanguard().gridView();
         int numElements = gridView.size(/*codim=*/0);
@@ -365,8 +382,10 @@ public:
         if (!isSubStep)
             eclOutputModule_.addRftDataToWells(localWellData, reportStepNum);
 
-        if (collectToIORank_.isParallel())
-            collectToIORank_.collect(localCellData, eclOutputModule_.getBlockData(), localWellData);
+        if (collectToIORank_.isParallel()) {
+            Opm::PerformanceProfile::ScopedTimer gatherTimer("gather");
+            collectToIORank_.collect(localCellData, eclOutputModule_.localBlockSlots(), eclOutputModule_.blockValues(), localWellData);
+        }
 
 
         if (collectToIORank_.isIORank()) {
@@ -392,13 +411,15 @@ public:
                                                                      isSubStep,
                                                                      curTime,
                                                                      restartValue,
-                                                                     enableDoublePrecisionOutput);
+                                                                     enableDoublePrecisionOutput,
+                                                                     numPendingWrites_);
 
             // then, make sure that the previous I/O request has been completed and the
             // number of incomplete tasklets does not increase between time steps
             taskletRunner_->barrier();
 
             // finally, start a new output writing job
+            ++numPendingWrites_;
             taskletRunner_->dispatch(eclWriteTasklet);
         }
     }
@@ -467,6 +488,12 @@ public:
     void endRestart()
     {}
 
+    /*!
+     * \brief Prepare the output of the report step which is about to start.
+     */
+    void beginEpisode()
+    { eclOutputModule_.prepareOutputPlan(simulator_.episodeIndex() + 1); }
+
     const EclOutputBlackOilModule<TypeTag>& eclOutputModule() const
     { return eclOutputModule_; }
 
@@ -676,6 +703,44 @@ private:
         return ret;
     }
 
+    /*!
+     * \brief Write the output of a substep for which evalSummaryState() has already
+     *        processed all elements.
+     *
+     * Substeps do not write restart data, so the solution does not need to be
+     * assigned or gathered to the I/O rank: the only remaining work is the
+     * error log and writing the summary, which is handed to the output thread
+     * without waiting for the previous substep to be written. At most
+     * maxPendingWrites_ write requests are in flight at any time.
+     */
+    void writeSubStepOutput_(Scalar curTime, Opm::data::Wells localWellData)
+    {
+        eclOutputModule_.outputErrorLog();
+
+        if (!collectToIORank_.isIORank())
+            return;
+
+        int reportStepNum = simulator_.episodeIndex() + 1;
+        bool enableDoublePrecisionOutput = EWOMS_GET_PARAM(TypeTag, bool, EclOutputDoublePrecision);
+        Opm::RestartValue restartValue(Opm::data::Solution{}, std::move(localWellData));
+
+        auto eclWriteTasklet = std::make_shared<EclWriteTasklet>(summaryState(),
+                                                                 *eclIO_,
+                                                                 reportStepNum,
+                                                                 /*isSubStep=*/true,
+                                                                 curTime,
+                                                                 std::move(restartValue),
+                                                                 enableDoublePrecisionOutput,
+                                                                 numPendingWrites_);
+
+        // only block if both output buffers are still being written
+        if (numPendingWrites_ >= maxPendingWrites_)
+            taskletRunner_->barrier();
+
+        ++numPendingWrites_;
+        taskletRunner_->dispatch(eclWriteTasklet);
+    }
+
     struct EclWriteTasklet
         : public TaskletInterface
     {
@@ -686,6 +751,7 @@ private:
         double secondsElapsed_;
         Opm::RestartValue restartValue_;
         bool writeDoublePrecision_;
+        std::atomic<int>& numPendingWrites_;
 
         explicit EclWriteTasklet(const Opm::SummaryState& summaryState,
                                  Opm::EclipseIO& eclIO,
@@ -693,14 +759,16 @@ private:
                                  bool isSubStep,
                                  double secondsElapsed,
                                  Opm::RestartValue restartValue,
-                                 bool writeDoublePrecision)
+                                 bool writeDoublePrecision,
+                                 std::atomic<int>& numPendingWrites)
             : summaryState_(summaryState)
             , eclIO_(eclIO)
             , reportStepNum_(reportStepNum)
             , isSubStep_(isSubStep)
             , secondsElapsed_(secondsElapsed)
-            , restartValue_(restartValue)
+            , restartValue_(std::move(restartValue))
             , writeDoublePrecision_(writeDoublePrecision)
+            , numPendingWrites_(numPendingWrites)
         { }
 
         // callback to eclIO serial writeTimeStep method
@@ -712,6 +780,7 @@ private:
                                  secondsElapsed_,
                                  restartValue_,
                                  writeDoublePrecision_);
+            --numPendingWrites_;
         }
     };
 
@@ -728,8 +797,13 @@ private:
     CollectDataToIORankType collectToIORank_;
     EclOutputBlackOilModule<TypeTag> eclOutputModule_;
     std::unique_ptr<Opm::EclipseIO> eclIO_;
+    // number of write tasklets which have been dispatched but not yet run. this must
+    // be declared before the tasklet runner so that it outlives the output thread.
+    std::atomic<int> numPendingWrites_;
+    static constexpr int maxPendingWrites_ = 2;
     std::unique_ptr<TaskletRunner> taskletRunner_;
     Scalar restartTimeStepSize_;
+    Scalar summaryEvalTime_;
 
 
 };
@@ -0,0 +1,363 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Run the realizations of an ensemble of black-oil models which only differ
+// by some field properties, e.g. for history matching:
+//
+//     flow_ensemble --ensemble-file=ENSEMBLE.txt [flow parameters] CASE.DATA
+//
+// The properties of a realization are given by constant factors or by the
+// arrays of include files. The limitations of this approach are listed in
+// the description printed by --help.
+//
+// The deck is parsed once. The realizations listed in the ensemble file (see
+// Opm::readEnsembleDefinition()) are run one after the other by all processes.
+// They share the deck, the EclipseState and the SummaryConfig. Each one gets
+// a copy of the Schedule, because ACTIONX modifies it during the simulation.
+// If the SCHEDULE section modifies grid properties, the EclipseState is
+// modified too, and a fresh one is created from the shared deck for every
+// realization. The output of a realization, including its summary files, is
+// written to the subdirectory of the output directory named after it.
+
+#include "config.h"
+#include "flow/flow_tag.hpp"
+
+#include <opm/simulators/flow/EnsembleDefinition.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    bool schedulePropertiesModified(const Opm::Schedule& schedule)
+    {
+        const auto& events = schedule.getEvents();
+        for (std::size_t stepIdx = 0; stepIdx < schedule.getTimeMap().numTimesteps(); ++stepIdx)
+            if (events.hasEvent(Opm::ScheduleEvents::GEO_MODIFIER, stepIdx))
+                return true;
+        return false;
+    }
+
+    bool startsWith(const char* arg, const char* prefix)
+    { return std::strncmp(arg, prefix, std::strlen(prefix)) == 0; }
+
+    const char* ensembleDescription =
+        "Flow for ensembles of realizations which only differ by some field properties.\n"
+        "\n"
+        "The realizations are defined by the file given by --ensemble-file=ENSEMBLE.txt.\n"
+        "Each line of it contains the name of a realization, which is also the name of\n"
+        "its output directory, followed by entries KEYWORD=FACTOR, which multiply the\n"
+        "values of a property in the deck by a constant, or KEYWORD=@FILE, which replace\n"
+        "them by the array of the keyword in an include file. The paths of the include\n"
+        "files are relative to the directory of the ensemble file.\n"
+        "\n"
+        "Limitations:\n"
+        " - Only PERMX, PERMY, PERMZ and PORO are supported, each with at most one\n"
+        "   entry per realization.\n"
+        " - The PORO values only change the pore volumes of the simulation. The cells\n"
+        "   removed by MINPV and the PORV output are those of the deck.\n"
+        " - The transmissibility factors of the well connections which are computed\n"
+        "   from the permeabilities follow them only if the two permeabilities\n"
+        "   perpendicular to the connection change by the same factor in its cell.\n"
+        "   Otherwise the realization fails, e.g. for a vertical well if PERMX and\n"
+        "   PERMY change differently.\n"
+        " - Cells with a value of zero in the deck must keep this value.\n"
+        " - The realizations are run one after the other by all processes.\n";
+
+    // read the arrays of a realization and convert them to factors for the
+    // values of the deck
+    std::map<std::string, std::vector<double>>
+    readCellMultipliers(const Opm::EnsembleMember& member,
+                        const boost::filesystem::path& ensembleDir,
+                        const Opm::EclipseState& eclState)
+    {
+        std::map<std::string, std::vector<double>> multipliers;
+        const auto& fp = eclState.fieldProps();
+        for (const auto& entry : member.arrayFiles) {
+            const std::string& keyword = entry.first;
+            boost::filesystem::path fileName(entry.second);
+            if (fileName.is_relative())
+                fileName = ensembleDir / fileName;
+
+            // the permeabilities which are not given by the deck are taken from
+            // PERMX, just like for the simulation
+            std::string deckKeyword = keyword;
+            if (!fp.has_double(deckKeyword) && deckKeyword != "PORO")
+                deckKeyword = "PERMX";
+            if (!fp.has_double(deckKeyword))
+                throw std::invalid_argument("Realization " + member.name + ": the deck does not specify "
+                                            + keyword + ", which cannot be replaced");
+
+            Opm::Parser parser;
+            Opm::ParseContext parseContext;
+            Opm::ErrorGuard errorGuard;
+            const Opm::Deck arrayDeck = parser.parseFile(fileName.string(), parseContext, errorGuard);
+            if (errorGuard) {
+                errorGuard.dump();
+                errorGuard.clear();
+                throw std::invalid_argument("Realization " + member.name + ": errors while reading '"
+                                            + fileName.string() + "'");
+            }
+            if (!arrayDeck.hasKeyword(keyword))
+                throw std::invalid_argument("Realization " + member.name + ": the file '" + fileName.string()
+                                            + "' does not contain " + keyword);
+
+            // the permeabilities are given in mD in all unit systems
+            try {
+                multipliers[keyword] = Opm::cellMultipliers(fp.get_global_double(deckKeyword),
+                                                            arrayDeck.getKeyword(keyword).getSIDoubleData());
+            }
+            catch (const std::invalid_argument& e) {
+                throw std::invalid_argument("Realization " + member.name + ", " + keyword
+                                            + " of '" + fileName.string() + "': " + e.what());
+            }
+        }
+        return multipliers;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    typedef TTAG(EclFlowProblem) TypeTag;
+    typedef GET_PROP_TYPE(TypeTag, Vanguard) Vanguard;
+
+    Dune::Timer externalSetupTimer;
+    externalSetupTimer.start();
+
+    detail::handleVersionCmdLine(argc, argv);
+#if HAVE_DUNE_FEM
+    Dune::Fem::MPIManager::initialize(argc, argv);
+    int mpiRank = Dune::Fem::MPIManager::rank();
+#else
+    const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+    int mpiRank = mpiHelper.rank();
+#endif
+
+    Opm::resetLocale();
+
+    // the ensemble file and the output directory are handled here, the
+    // remaining arguments are passed on to the simulator of each realization
+    std::string ensembleFileName;
+    std::string baseOutputDir;
+    std::vector<char*> args;
+    for (int i = 0; i < argc; ++i) {
+        if (startsWith(argv[i], "--ensemble-file="))
+            ensembleFileName = argv[i] + std::strlen("--ensemble-file=");
+        else if (startsWith(argv[i], "--output-dir="))
+            baseOutputDir = argv[i] + std::strlen("--output-dir=");
+        else
+            args.push_back(argv[i]);
+    }
+    int numArgs = args.size();
+    args.push_back(nullptr);
+
+    typedef TTAG(FlowEarlyBird) PreTypeTag;
+    typedef GET_PROP_TYPE(PreTypeTag, Problem) PreProblem;
+
+    PreProblem::setBriefDescription(ensembleDescription);
+
+    int status = Opm::FlowMainEbos<PreTypeTag>::setupParameters_(numArgs, args.data());
+    if (status != 0) {
+#if HAVE_MPI
+        MPI_Finalize();
+#endif
+        return (status >= 0)?status:0;
+    }
+
+    bool outputCout = false;
+    if (mpiRank == 0)
+        outputCout = EWOMS_GET_PARAM(PreTypeTag, bool, EnableTerminalOutput);
+
+    std::vector<Opm::EnsembleMember> members;
+    std::string deckFilename = EWOMS_GET_PARAM(PreTypeTag, std::string, EclDeckFileName);
+    try {
+        deckFilename = Vanguard::canonicalDeckPath(deckFilename).string();
+
+        if (ensembleFileName.empty())
+            throw std::invalid_argument("No ensemble has been specified via '--ensemble-file=ENSEMBLE.txt'");
+        std::ifstream ensembleFile(ensembleFileName);
+        if (!ensembleFile)
+            throw std::invalid_argument("Cannot open the ensemble file '" + ensembleFileName + "'");
+        members = Opm::readEnsembleDefinition(ensembleFile);
+        if (members.empty())
+            throw std::invalid_argument("The ensemble file '" + ensembleFileName + "' does not define any realization");
+    }
+    catch (const std::exception& e) {
+        if (mpiRank == 0)
+            std::cerr << "Error: " << e.what() << "\n";
+#if HAVE_MPI
+        MPI_Finalize();
+#endif
+        return EXIT_FAILURE;
+    }
+
+    // parse the input once for all realizations
+    std::shared_ptr<Opm::Deck> deck;
+    std::shared_ptr<Opm::EclipseState> eclipseState;
+    std::shared_ptr<Opm::Schedule> schedule;
+    std::shared_ptr<Opm::SummaryConfig> summaryConfig;
+    Opm::ParseContext parseContext;
+    Opm::ErrorGuard errorGuard;
+    {
+        if (outputCout) {
+            std::cout << "Reading deck file '" << deckFilename << "'\n";
+            std::cout.flush();
+        }
+
+        Opm::Parser parser;
+        setupLogging(mpiRank,
+                     deckFilename,
+                     baseOutputDir,
+                     EWOMS_GET_PARAM(PreTypeTag, std::string, OutputMode),
+                     outputCout, "STDOUT_LOGGER");
+
+        if (EWOMS_GET_PARAM(PreTypeTag, bool, EclStrictParsing))
+            parseContext.update( Opm::InputError::DELAYED_EXIT1);
+        else {
+            parseContext.update(Opm::ParseContext::PARSE_RANDOM_SLASH, Opm::InputError::IGNORE);
+            parseContext.update(Opm::ParseContext::PARSE_MISSING_DIMS_KEYWORD, Opm::InputError::WARN);
+            parseContext.update(Opm::ParseContext::SUMMARY_UNKNOWN_WELL, Opm::InputError::WARN);
+            parseContext.update(Opm::ParseContext::SUMMARY_UNKNOWN_GROUP, Opm::InputError::WARN);
+        }
+
+        Opm::FlowMainEbos<PreTypeTag>::printPRTHeader(outputCout);
+
+        deck.reset( new Opm::Deck( parser.parseFile(deckFilename , parseContext, errorGuard)));
+        Opm::MissingFeatures::checkKeywords(*deck, parseContext, errorGuard);
+        if ( outputCout )
+            Opm::checkDeck(*deck, parser, parseContext, errorGuard);
+
+        eclipseState.reset( new Opm::EclipseState(*deck, parseContext, errorGuard ));
+        schedule.reset(new Opm::Schedule(*deck, *eclipseState, parseContext, errorGuard));
+        summaryConfig.reset( new Opm::SummaryConfig(*deck, *schedule, eclipseState->getTableManager(), parseContext, errorGuard));
+
+        Opm::checkConsistentArrayDimensions(*eclipseState, *schedule, parseContext, errorGuard);
+
+        if (errorGuard) {
+            errorGuard.dump();
+            errorGuard.clear();
+
+            throw std::runtime_error("Unrecoverable errors were encountered while loading input.");
+        }
+    }
+
+    const auto& phases = eclipseState->runspec().phases();
+    if (phases.size() != 3 || eclipseState->getSimulationConfig().isThermal()) {
+        if (outputCout)
+            std::cerr << "flow_ensemble only supports three-phase black-oil models" << std::endl;
+#if HAVE_MPI
+        MPI_Finalize();
+#endif
+        return EXIT_FAILURE;
+    }
+
+    if (baseOutputDir.empty())
+        baseOutputDir = eclipseState->getIOConfig().getOutputDir();
+    const bool sharedEclState = !schedulePropertiesModified(*schedule);
+    const boost::filesystem::path ensembleDir = boost::filesystem::path(ensembleFileName).parent_path();
+
+    std::vector<int> memberStatus;
+    std::vector<double> memberTime;
+    bool parametersRead = false;
+    double setupTime = externalSetupTimer.elapsed();
+    for (const auto& member : members) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::string outputDir = baseOutputDir + "/" + member.name;
+
+        Opm::OpmLog::removeAllBackends();
+        FileOutputMode outputMode = setupLogging(mpiRank,
+                                                 deckFilename,
+                                                 outputDir,
+                                                 EWOMS_GET_PARAM(PreTypeTag, std::string, OutputMode),
+                                                 outputCout, "STDOUT_LOGGER");
+        setupMessageLimiter(schedule->getMessageLimits(), "STDOUT_LOGGER");
+        if (outputCout)
+            Opm::OpmLog::info("\n================ Realization " + member.name + " ===============\n");
+
+        std::unique_ptr<Opm::EclipseState> memberEclState;
+        if (!sharedEclState)
+            memberEclState.reset(new Opm::EclipseState(*deck, parseContext, errorGuard));
+        Opm::EclipseState& eclState = sharedEclState ? *eclipseState : *memberEclState;
+
+        // the vanguard writes to the output directory of the EclipseState
+        // because --output-dir is not passed on
+        eclState.getIOConfig().setOutputDir(outputDir);
+
+        std::map<std::string, std::vector<double>> cellMultipliers;
+        try {
+            cellMultipliers = readCellMultipliers(member, ensembleDir, eclState);
+        }
+        catch (const std::exception& e) {
+            if (outputCout)
+                std::cerr << "Error: " << e.what() << "\n";
+            memberStatus.push_back(EXIT_FAILURE);
+            memberTime.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            continue;
+        }
+
+        Opm::Schedule memberSchedule(*schedule);
+
+        Vanguard::setExternalSetupTime(setupTime);
+        Vanguard::setExternalDeck(deck.get());
+        Vanguard::setExternalEclState(&eclState);
+        Vanguard::setExternalSchedule(&memberSchedule);
+        Vanguard::setExternalSummaryConfig(summaryConfig.get());
+        Vanguard::setExternalFieldPropertyMultipliers(&member.multipliers);
+        Vanguard::setExternalFieldPropertyCellMultipliers(&cellMultipliers);
+
+        {
+            const bool outputFiles = (outputMode != FileOutputMode::OUTPUT_NONE);
+            Opm::FlowMainEbos<TypeTag> mainfunc;
+            // the parameters of the simulator are read once
+            if (!parametersRead)
+                memberStatus.push_back(mainfunc.execute(numArgs, args.data(), outputCout, outputFiles));
+            else
+                memberStatus.push_back(mainfunc.executeWithParameters(outputCout, outputFiles));
+            parametersRead = true;
+        }
+
+        Vanguard::setExternalFieldPropertyMultipliers(nullptr);
+        Vanguard::setExternalFieldPropertyCellMultipliers(nullptr);
+        memberTime.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        setupTime = 0.0;
+    }
+
+    int result = EXIT_SUCCESS;
+    if (outputCout)
+        std::cout << "\n================ Ensemble ===============\n"
+                  << std::left << std::setw(20) << "Realization" << std::right << std::setw(12) << "Time [s]"
+                  << "  Status\n";
+    for (std::size_t memberIdx = 0; memberIdx < members.size(); ++memberIdx) {
+        if (memberStatus[memberIdx] != EXIT_SUCCESS)
+            result = EXIT_FAILURE;
+        if (outputCout)
+            std::cout << std::left << std::setw(20) << members[memberIdx].name
+                      << std::right << std::setw(12) << std::fixed << std::setprecision(1) << memberTime[memberIdx]
+                      << "  " << (memberStatus[memberIdx] == EXIT_SUCCESS ? "ok" : "failed") << "\n";
+    }
+
+    return result;
+}
@@ -68,6 +68,18 @@ public:
         }
     }
 
+    void serialize(std::ostream& os) const override
+    {
+        Base::serialize(os);
+        Checkpoint::write(os, aquifer_pressure_);
+    }
+
+    void deserialize(std::istream& is) override
+    {
+        Base::deserialize(is);
+        Checkpoint::read(is, aquifer_pressure_);
+    }
+
 protected:
     // Aquifer Fetkovich Specific Variables
     // TODO: using const reference here will cause segmentation fault, which is very strange
@@ -34,7 +34,11 @@
 #include <opm/material/densead/Math.hpp>
 #include <opm/material/fluidstates/BlackOilFluidState.hpp>
 
+#include <opm/simulators/utils/Checkpoint.hpp>
+
 #include <algorithm>
+#include <istream>
+#include <ostream>
 #include <unordered_map>
 #include <vector>
 
@@ -155,6 +159,31 @@ public:
             += Qai_[idx] / context.dofVolume(spaceIdx, timeIdx);
     }
 
+    // Write the state which is carried from one time step to the next to a
+    // binary checkpoint. The connection quantities are recomputed at the
+    // beginning of every time step.
+    virtual void serialize(std::ostream& os) const
+    {
+        Checkpoint::write(os, W_flux_.value());
+        for (int i = 0; i < W_flux_.size(); ++i)
+            Checkpoint::write(os, W_flux_.derivative(i));
+        Checkpoint::write(os, pa0_);
+        Checkpoint::write(os, solution_set_from_restart_);
+    }
+
+    virtual void deserialize(std::istream& is)
+    {
+        Scalar value;
+        Checkpoint::read(is, value);
+        W_flux_.setValue(value);
+        for (int i = 0; i < W_flux_.size(); ++i) {
+            Checkpoint::read(is, value);
+            W_flux_.setDerivative(i, value);
+        }
+        Checkpoint::read(is, pa0_);
+        Checkpoint::read(is, solution_set_from_restart_);
+    }
+
 protected:
     inline Scalar gravity_() const
     {
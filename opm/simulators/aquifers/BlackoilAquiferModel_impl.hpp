@@ -119,19 +119,29 @@ BlackoilAquiferModel<TypeTag>::endEpisode()
 template <typename TypeTag>
 template <class Restarter>
 void
-BlackoilAquiferModel<TypeTag>::serialize(Restarter& /* res */)
+BlackoilAquiferModel<TypeTag>::serialize(Restarter& res)
 {
-    // TODO (?)
-    throw std::logic_error("BlackoilAquiferModel::serialize() is not yet implemented");
+    res.serializeSectionBegin("BlackoilAquiferModel");
+    auto& os = res.serializeStream();
+    for (const auto& aquifer : aquifers_CarterTracy)
+        aquifer.serialize(os);
+    for (const auto& aquifer : aquifers_Fetkovich)
+        aquifer.serialize(os);
+    res.serializeSectionEnd();
 }
 
 template <typename TypeTag>
 template <class Restarter>
 void
-BlackoilAquiferModel<TypeTag>::deserialize(Restarter& /* res */)
-{
-    // TODO (?)
-    throw std::logic_error("BlackoilAquiferModel::deserialize() is not yet implemented");
+BlackoilAquiferModel<TypeTag>::deserialize(Restarter& res)
+{
+    res.deserializeSectionBegin("BlackoilAquiferModel");
+    auto& is = res.deserializeStream();
+    for (auto& aquifer : aquifers_CarterTracy)
+        aquifer.deserialize(is);
+    for (auto& aquifer : aquifers_Fetkovich)
+        aquifer.deserialize(is);
+    res.deserializeSectionEnd();
 }
 
 // Initialize the aquifers in the deck
@@ -26,6 +26,7 @@
 
 #include <ebos/eclproblem.hh>
 #include <opm/models/utils/start.hh>
+#include <opm/models/parallel/threadmanager.hh>
 
 #include <opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp>
 
@@ -50,9 +51,17 @@
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 
 #include <opm/simulators/linalg/ISTLSolverEbos.hpp>
+#include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
+#include <opm/simulators/linalg/GraphColoring.hpp>
+#include <opm/simulators/utils/PerformanceProfile.hpp>
 #include <opm/common/data/SimulationDataContainer.hpp>
 
 #include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/solvers.hh>
+#include <dune/istl/paamg/amg.hh>
+#include <dune/istl/paamg/graph.hh>
 #if DUNE_VERSION_NEWER(DUNE_COMMON, 2, 7)
 #include <dune/common/parallel/communication.hh>
 #else
@@ -63,12 +72,19 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <memory>
+#include <array>
 #include <vector>
 #include <algorithm>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 BEGIN_PROPERTIES
 
@@ -119,6 +135,8 @@ namespace Opm {
         typedef typename GET_PROP_TYPE(TypeTag, PrimaryVariables)  PrimaryVariables ;
         typedef typename GET_PROP_TYPE(TypeTag, FluidSystem)       FluidSystem;
         typedef typename GET_PROP_TYPE(TypeTag, Indices)           Indices;
+        typedef typename GET_PROP_TYPE(TypeTag, GridView)          GridView;
+        typedef typename GridView::template Codim<0>::Entity      Element;
         typedef typename GET_PROP_TYPE(TypeTag, MaterialLaw)       MaterialLaw;
         typedef typename GET_PROP_TYPE(TypeTag, MaterialLawParams) MaterialLawParams;
 
@@ -143,6 +161,23 @@ namespace Opm {
         typedef Dune::BlockVector<VectorBlockType>      BVector;
 
         typedef ISTLSolverEbos<TypeTag> ISTLSolverType;
+        typedef typename GET_PROP_TYPE(TypeTag, ThreadManager) ThreadManager;
+
+        // the systems of the two steps of the sequential implicit method. the
+        // block size of the transport system is kept positive for single phase
+        // models, for which the method is not available.
+        enum { numTransportEq = (numEq > 1) ? numEq - 1 : 1 };
+        typedef Dune::BCRSMatrix<Dune::FieldMatrix<Scalar, 1, 1>> PressureMatrix;
+        typedef Dune::BlockVector<Dune::FieldVector<Scalar, 1>> PressureVector;
+        typedef Dune::BCRSMatrix<Dune::FieldMatrix<Scalar, numTransportEq, numTransportEq>> TransportMatrix;
+        typedef Dune::BlockVector<Dune::FieldVector<Scalar, numTransportEq>> TransportVector;
+
+        // the conservation equation which is replaced by the pressure equation
+        // in the sequential implicit method, as in the CPR preconditioner of
+        // ISTLSolverEbos
+        static const int sequentialPressureEqIdx = Indices::waterEnabled
+            ? BlackOilDefaultIndexTraits::waterCompIdx
+            : BlackOilDefaultIndexTraits::oilCompIdx;
         //typedef typename SolutionVector :: value_type            PrimaryVariables ;
 
         // ---------  Public methods  ---------
@@ -181,6 +216,14 @@ namespace Opm {
             // compute global sum of number of cells
             global_nc_ = detail::countGlobalCells(grid_);
             convergence_reports_.reserve(300); // Often insufficient, but avoids frequent moves.
+
+            if (param_.sequential_implicit_) {
+                // the pressure equation needs the wells in the Jacobian
+                if (!param_.matrix_add_well_contributions_)
+                    OPM_THROW(std::invalid_argument, "The sequential implicit method requires --matrix-add-well-contributions=true");
+                if (isParallel() || numEq < 2)
+                    OPM_THROW(std::invalid_argument, "The sequential implicit method is only available for serial runs of models with more than one phase");
+            }
         }
 
         bool isParallel() const
@@ -251,6 +294,7 @@ namespace Opm {
             report.total_linearizations = 1;
 
             try {
+                PerformanceProfile::ScopedTimer profileTimer("assembly");
                 report += assembleReservoir(timer, iteration);
                 report.assemble_time += perfTimer.stop();
             }
@@ -262,12 +306,19 @@ namespace Opm {
             }
 
             std::vector<double> residual_norms;
+            bool onlyCnvFailed = false;
             perfTimer.reset();
             perfTimer.start();
             // the step is not considered converged until at least minIter iterations is done
             {
+                PerformanceProfile::ScopedTimer profileTimer("convergence");
                 auto convrep = getConvergence(timer, iteration,residual_norms);
                 report.converged = convrep.converged()  && iteration > nonlinear_solver.minIter();;
+                // a local solve can only reduce the CNV errors of the cells
+                onlyCnvFailed = !convrep.wellFailed()
+                    && std::all_of(convrep.reservoirFailures().begin(), convrep.reservoirFailures().end(),
+                                   [](const ConvergenceReport::ReservoirFailure& f)
+                                   { return f.type() == ConvergenceReport::ReservoirFailure::Type::Cnv; });
                 ConvergenceReport::Severity severity = convrep.severityOfWorstFailure();
                 convergence_reports_.back().report.push_back(std::move(convrep));
 
@@ -280,7 +331,68 @@ namespace Opm {
             }
             report.update_time += perfTimer.stop();
             residual_norms_history_.push_back(residual_norms);
+
+            // if only a small part of the reservoir violates the CNV criterion,
+            // iterate on this part only. the next call re-checks the convergence
+            // of the whole system. failures of the mass balance or of the wells
+            // require a global iteration.
+            if (!report.converged && onlyCnvFailed && param_.local_solve_max_pv_fraction_ > 0.0 && iteration > 0) {
+                if (localSolve_(timer, iteration, report)) {
+                    report.total_newton_iterations = 1;
+                    return report;
+                }
+            }
+
             if (!report.converged) {
+                // nonlinear domain decomposition: converge the subdomains locally
+                // and take the global Newton step from the resulting state, which
+                // requires a second global linearization unless all subdomain
+                // solves were rejected. the new state may already be converged.
+                if (param_.nldd_num_subdomains_ > 0) {
+                    try {
+                        const bool changed = solveNlddSubdomains_(timer, iteration, report);
+                        if (grid_.comm().max(changed ? 1 : 0) == 1) {
+                            relinearize_(timer, iteration, report);
+
+                            perfTimer.reset();
+                            perfTimer.start();
+                            residual_norms.clear();
+                            auto convrep = getConvergence(timer, iteration, residual_norms);
+                            report.converged = convrep.converged() && iteration > nonlinear_solver.minIter();
+                            ConvergenceReport::Severity severity = convrep.severityOfWorstFailure();
+                            convergence_reports_.back().report.push_back(std::move(convrep));
+                            if (severity == ConvergenceReport::Severity::NotANumber) {
+                                OPM_THROW(Opm::NumericalIssue, "NaN residual found!");
+                            } else if (severity == ConvergenceReport::Severity::TooLarge) {
+                                OPM_THROW(Opm::NumericalIssue, "Too large residual found!");
+                            }
+                            residual_norms_history_.back() = residual_norms;
+                            report.update_time += perfTimer.stop();
+                        }
+                    }
+                    catch (...) {
+                        failureReport_ += report;
+                        throw;
+                    }
+                    if (report.converged) {
+                        report.total_newton_iterations = 1;
+                        return report;
+                    }
+                }
+
+                // the sequential implicit method replaces the global linear solve
+                if (param_.sequential_implicit_) {
+                    report.total_newton_iterations = 1;
+                    try {
+                        sequentialIteration_(timer, iteration, report);
+                    }
+                    catch (...) {
+                        failureReport_ += report;
+                        throw;
+                    }
+                    return report;
+                }
+
                 perfTimer.reset();
                 perfTimer.start();
                 report.total_newton_iterations = 1;
@@ -294,12 +406,16 @@ namespace Opm {
 
                 // apply the Schur compliment of the well model to the reservoir linearized
                 // equations
-                wellModel().linearize(ebosSimulator().model().linearizer().jacobian(),
-                                      ebosSimulator().model().linearizer().residual());
+                {
+                    PerformanceProfile::ScopedTimer profileTimer("wellLinearization");
+                    wellModel().linearize(ebosSimulator().model().linearizer().jacobian(),
+                                          ebosSimulator().model().linearizer().residual());
+                }
 
                 // Solve the linear system.
                 linear_solve_setup_time_ = 0.0;
                 try {
+                    PerformanceProfile::ScopedTimer profileTimer("linearSolver");
                     solveJacobianSystem(x);
                     report.linear_solve_setup_time += linear_solve_setup_time_;
                     report.linear_solve_time += perfTimer.stop();
@@ -316,6 +432,7 @@ namespace Opm {
 
                 perfTimer.reset();
                 perfTimer.start();
+                PerformanceProfile::ScopedTimer profileTimer("update");
 
                 // handling well state update before oscillation treatment is a decision based
                 // on observation to avoid some big performance degeneration under some circumstances.
@@ -374,7 +491,12 @@ namespace Opm {
             // -------- Mass balance equations --------
             ebosSimulator_.model().newtonMethod().setIterationIndex(iterationIdx);
             ebosSimulator_.problem().beginIteration();
-            ebosSimulator_.model().linearizer().linearizeDomain();
+            if (param_.verify_threaded_linearization_) {
+                linearizeDomainVerified_();
+            }
+            else {
+                ebosSimulator_.model().linearizer().linearizeDomain();
+            }
             ebosSimulator_.problem().endIteration();
 
             return wellModel().lastReport();
@@ -485,7 +607,10 @@ namespace Opm {
             auto& ebosSolver = ebosSimulator_.model().newtonMethod().linearSolver();
             Dune::Timer perfTimer;
             perfTimer.start();
-            ebosSolver.prepare(ebosJac, ebosResid);
+            {
+                PerformanceProfile::ScopedTimer profileTimer("setup");
+                ebosSolver.prepare(ebosJac, ebosResid);
+            }
             linear_solve_setup_time_ = perfTimer.stop();
             ebosSolver.setResidual(ebosResid);
             // actually, the error needs to be calculated after setResidual in order to
@@ -493,7 +618,11 @@ namespace Opm {
             // discretizations does not need to be synchronized across processes to be
             // consistent, this is not relevant for OPM-flow...
             ebosSolver.setMatrix(ebosJac);
-            ebosSolver.solve(x);
+            {
+                PerformanceProfile::ScopedTimer profileTimer("solve");
+                ebosSolver.solve(x);
+            }
+            PerformanceProfile::count("iterations", ebosSolver.iterations());
        }
 
 
@@ -533,6 +662,7 @@ namespace Opm {
 
             if( comm.size() > 1 )
             {
+                PerformanceProfile::ScopedTimer profileTimer("reduction");
                 // global reduction
                 std::vector< Scalar > sumBuffer;
                 std::vector< Scalar > maxBuffer;
@@ -818,6 +948,7 @@ namespace Opm {
             std::vector<Scalar> B_avg(numEq, 0.0);
             auto report = getReservoirConvergence(timer.currentStepLength(), iteration, B_avg, residual_norms);
             report += wellModel().getWellConvergence(B_avg);
+            B_avg_ = B_avg;
 
             return report;
         }
@@ -907,6 +1038,22 @@ namespace Opm {
         BVector dx_old_;
 
         std::vector<StepReport> convergence_reports_;
+
+        // the average inverse formation volume factors of the last convergence check
+        std::vector<Scalar> B_avg_;
+
+        // the cells of the subdomains of the nonlinear domain decomposition
+        std::vector<std::vector<unsigned>> nldd_subdomains_;
+
+        // the matrices of the pressure and the transport steps of the
+        // sequential implicit method, which are set up once
+        std::unique_ptr<PressureMatrix> pressureMatrix_;
+        std::unique_ptr<TransportMatrix> transportMatrix_;
+        int sequentialWellSparsityRevision_ = -1;
+
+        // the elements of the cells, for the reordered transport step
+        std::vector<Element> elements_;
+        std::vector<unsigned> elementPos_;
     public:
         /// return the StandardWells object
         BlackoilWellModel<TypeTag>&
@@ -927,6 +1074,794 @@ namespace Opm {
 
     private:
 
+        // Linearize the reservoir equations with a single thread first and
+        // then with all threads, and check that both linearizations are
+        // bitwise identical. Each element writes only its own residual and its
+        // own blocks of the Jacobian, so the order of the floating point
+        // operations does not depend on the number of threads. The reference
+        // linearization comes first so that the state left behind in the
+        // problem (e.g. by the aquifers) and in the intensive quantity cache is
+        // the one of the multithreaded linearization, like without the check.
+        void linearizeDomainVerified_()
+        {
+            auto& linearizer = ebosSimulator_.model().linearizer();
+#ifdef _OPENMP
+            const int numThreads = omp_get_max_threads();
+            if (grid_.comm().max(numThreads) < 2) {
+                linearizer.linearizeDomain();
+                return;
+            }
+
+            omp_set_num_threads(1);
+            linearizer.linearizeDomain();
+            omp_set_num_threads(numThreads);
+            const auto serialJacobian = linearizer.jacobian().istlMatrix();
+            const auto serialResidual = linearizer.residual();
+
+            linearizer.linearizeDomain();
+
+            const auto bitwiseEqual = [](const double a, const double b) {
+                return std::memcmp(&a, &b, sizeof(double)) == 0;
+            };
+            const auto& jacobian = linearizer.jacobian().istlMatrix();
+            const auto& residual = linearizer.residual();
+            long long numDifferent = 0;
+            for (auto row = jacobian.begin(); row != jacobian.end(); ++row) {
+                for (auto col = row->begin(); col != row->end(); ++col) {
+                    const auto& serialBlock = serialJacobian[row.index()][col.index()];
+                    for (int i = 0; i < numEq; ++i)
+                        for (int j = 0; j < numEq; ++j)
+                            numDifferent += !bitwiseEqual((*col)[i][j], serialBlock[i][j]);
+                }
+                for (int i = 0; i < numEq; ++i)
+                    numDifferent += !bitwiseEqual(residual[row.index()][i], serialResidual[row.index()][i]);
+            }
+
+            numDifferent = grid_.comm().sum(numDifferent);
+            if (numDifferent > 0) {
+                OPM_THROW(std::logic_error, "The linearization with " << numThreads << " threads differs from the "
+                          "single-threaded one in " << numDifferent << " entries");
+            }
+#else
+            linearizer.linearizeDomain();
+#endif
+        }
+
+        // The largest CNV error of the equations of a cell, computed like in
+        // getReservoirConvergence() using the averages of its last call.
+        Scalar cellCnvError_(const unsigned cellIdx, const VectorBlockType& resid, const double dt) const
+        {
+            const Scalar pv = ebosSimulator_.problem().referencePorosity(cellIdx, /*timeIdx=*/0)
+                * ebosSimulator_.model().dofTotalVolume(cellIdx);
+            Scalar error = 0.0;
+            for (int compIdx = 0; compIdx < numEq; ++compIdx) {
+                Scalar r = resid[compIdx];
+                if (has_polymermw_ && compIdx == contiPolymerMWEqIdx)
+                    r /= 100.;
+                error = std::max(error, B_avg_[compIdx] * dt * std::abs(r) / pv);
+            }
+            return error;
+        }
+
+        // Mark the cells of this process which are not seen by other processes,
+        // i.e., the interior cells without non-interior neighbors. Only these
+        // cells can be changed by a solve on a subdomain without making the
+        // processes inconsistent.
+        std::vector<char> locallySolvableCells_() const
+        {
+            const auto& jacobian = ebosSimulator_.model().linearizer().jacobian().istlMatrix();
+            const auto& elemMapper = ebosSimulator_.model().elementMapper();
+            const auto& gridView = ebosSimulator_.gridView();
+            const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
+
+            std::vector<char> isInterior(jacobian.N(), 0);
+            for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
+                 elemIt != elemEndIt;
+                 ++elemIt)
+                isInterior[elemMapper.index(*elemIt)] = 1;
+
+            std::vector<char> solvable(isInterior);
+            for (auto row = jacobian.begin(); row != jacobian.end(); ++row)
+                for (auto col = row->begin(); col != row->end(); ++col)
+                    if (!isInterior[col.index()])
+                        solvable[row.index()] = 0;
+            return solvable;
+        }
+
+        // Do Newton iterations on a subdomain, while the remaining cells and the
+        // wells are frozen, until the CNV criterion is met in all its cells or
+        // the given number of linearizations has been done.
+        //
+        // The local system is linearized element by element, using the same
+        // local linearizer as the global linearization, and solved by an ILU(0)
+        // preconditioned BiCGSTAB method. Returns false if the solve throws, its
+        // linear solver fails or it does not reduce the largest CNV error of the
+        // cells. The solution of the cells is not restored in this case.
+        //
+        // localIdx must have an entry of -1 for every cell of the process. It
+        // is used as scratch space and reset before returning.
+        bool solveSubdomain_(const std::vector<unsigned>& cells,
+                             std::vector<int>& localIdx,
+                             const double dt,
+                             const double tol_cnv,
+                             const int maxIter,
+                             SimulatorReport& report)
+        {
+            if (cells.empty())
+                return true;
+
+            const auto& jacobian = ebosSimulator_.model().linearizer().jacobian().istlMatrix();
+            const auto& elemMapper = ebosSimulator_.model().elementMapper();
+            const auto& gridView = ebosSimulator_.gridView();
+            const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
+            const unsigned nc = localIdx.size();
+            for (std::size_t i = 0; i < cells.size(); ++i)
+                localIdx[cells[i]] = i;
+
+            // the sparsity pattern of the local system
+            Mat localJac(cells.size(), cells.size(), Mat::random);
+            for (std::size_t i = 0; i < cells.size(); ++i) {
+                std::size_t rowSize = 0;
+                for (auto col = jacobian[cells[i]].begin(); col != jacobian[cells[i]].end(); ++col)
+                    rowSize += (localIdx[col.index()] >= 0);
+                localJac.setrowsize(i, rowSize);
+            }
+            localJac.endrowsizes();
+            for (std::size_t i = 0; i < cells.size(); ++i)
+                for (auto col = jacobian[cells[i]].begin(); col != jacobian[cells[i]].end(); ++col)
+                    if (localIdx[col.index()] >= 0)
+                        localJac.addindex(i, localIdx[col.index()]);
+            localJac.endindices();
+
+            ElementContext elemCtx(ebosSimulator_);
+            auto& localLinearizer = ebosSimulator_.model().localLinearizer(ThreadManager::threadId());
+            BVector localResid(cells.size());
+            BVector x(nc);
+            Scalar initialError = std::numeric_limits<Scalar>::max();
+            Scalar error = initialError;
+            bool success = true;
+            try {
+                for (int localIter = 0; localIter < maxIter; ++localIter) {
+                    Dune::Timer perfTimer;
+                    perfTimer.start();
+                    localJac = 0.0;
+                    error = 0.0;
+                    for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
+                         elemIt != elemEndIt;
+                         ++elemIt)
+                    {
+                        const auto& elem = *elemIt;
+                        const int i = localIdx[elemMapper.index(elem)];
+                        if (i < 0)
+                            continue;
+
+                        localLinearizer.linearize(elemCtx, elem);
+                        localResid[i] = localLinearizer.residual(/*dofIdx=*/0);
+                        // jacobian(j, 0) is the derivative of the residual of the
+                        // j-th DOF of the stencil w.r.t. the primary variables of
+                        // the element's own DOF, i.e., block (j, i) of the Jacobian
+                        for (unsigned dofIdx = 0; dofIdx < elemCtx.numDof(/*timeIdx=*/0); ++dofIdx) {
+                            const int j = localIdx[elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0)];
+                            if (j >= 0)
+                                localJac[j][i] = localLinearizer.jacobian(dofIdx, /*rangeDofIdx=*/0);
+                        }
+                        error = std::max(error, cellCnvError_(cells[i], localResid[i], dt));
+                    }
+                    report.assemble_time += perfTimer.stop();
+                    report.total_local_linearizations += 1;
+                    report.local_linearization_cells += double(cells.size()) / nc;
+
+                    if (localIter == 0)
+                        initialError = error;
+                    if (error <= tol_cnv || localIter + 1 == maxIter)
+                        break;
+
+                    perfTimer.reset();
+                    perfTimer.start();
+                    BVector localX(cells.size());
+                    localX = 0.0;
+                    Dune::MatrixAdapter<Mat, BVector, BVector> op(localJac);
+                    Dune::SeqILU0<Mat, BVector, BVector> precond(localJac, 1.0);
+                    Dune::BiCGSTABSolver<BVector> solver(op, precond, 1e-4, 200, /*verbose=*/0);
+                    Dune::InverseOperatorResult result;
+                    solver.apply(localX, localResid, result);
+                    report.linear_solve_time += perfTimer.stop();
+                    report.total_linear_iterations += result.iterations;
+                    if (!result.converged) {
+                        success = false;
+                        break;
+                    }
+
+                    perfTimer.reset();
+                    perfTimer.start();
+                    x = 0.0;
+                    for (std::size_t i = 0; i < cells.size(); ++i)
+                        x[cells[i]] = localX[i];
+                    updateSolution(x);
+                    report.update_time += perfTimer.stop();
+                }
+            }
+            catch (const Opm::NumericalIssue&) {
+                success = false;
+            }
+            catch (const Dune::Exception&) {
+                success = false;
+            }
+
+            for (const unsigned cellIdx : cells)
+                localIdx[cellIdx] = -1;
+
+            return success && std::isfinite(error) && (error < initialError || error <= tol_cnv);
+        }
+
+        // Do Newton iterations on the cells which violate the CNV criterion and
+        // the given number of layers of their neighbors, if the violating cells
+        // make up at most the given fraction of the pore volume. The local solve
+        // is rejected and the previous solution restored if solveSubdomain_()
+        // fails on any process. Returns false in this case, or if the subdomain
+        // is empty on all processes, so the caller continues with a global
+        // iteration.
+        bool localSolve_(const SimulatorTimerInterface& timer, const int iteration, SimulatorReport& report)
+        {
+            const auto& comm = grid_.comm();
+            const double dt = timer.currentStepLength();
+            const double tol_cnv = (iteration < param_.max_strict_iter_) ? param_.tolerance_cnv_ : param_.tolerance_cnv_relaxed_;
+            const auto& jacobian = ebosSimulator_.model().linearizer().jacobian().istlMatrix();
+            const auto& ebosResid = ebosSimulator_.model().linearizer().residual();
+            const unsigned nc = ebosResid.size();
+
+            // find the cells which violate the CNV criterion. the cells seen by
+            // other processes are frozen, but count for the pore volume
+            const std::vector<char> solvable = locallySolvableCells_();
+            std::vector<char> inSubdomain(nc, 0);
+            double pv[2] = { 0.0, 0.0 }; // violating and total pore volume
+            const auto& elemMapper = ebosSimulator_.model().elementMapper();
+            const auto& gridView = ebosSimulator_.gridView();
+            const auto& elemEndIt = gridView.template end</*codim=*/0, Dune::Interior_Partition>();
+            for (auto elemIt = gridView.template begin</*codim=*/0, Dune::Interior_Partition>();
+                 elemIt != elemEndIt;
+                 ++elemIt)
+            {
+                const unsigned cellIdx = elemMapper.index(*elemIt);
+                const double cellPv = ebosSimulator_.problem().referencePorosity(cellIdx, /*timeIdx=*/0)
+                    * ebosSimulator_.model().dofTotalVolume(cellIdx);
+                pv[1] += cellPv;
+                if (cellCnvError_(cellIdx, ebosResid[cellIdx], dt) > tol_cnv) {
+                    inSubdomain[cellIdx] = 1;
+                    pv[0] += cellPv;
+                }
+            }
+            comm.sum(pv, 2);
+            if (pv[0] > param_.local_solve_max_pv_fraction_ * pv[1])
+                return false;
+
+            // add the halo
+            for (int layer = 0; layer < param_.local_solve_halo_layers_; ++layer) {
+                std::vector<char> grown(inSubdomain);
+                for (auto row = jacobian.begin(); row != jacobian.end(); ++row)
+                    if (inSubdomain[row.index()])
+                        for (auto col = row->begin(); col != row->end(); ++col)
+                            grown[col.index()] = 1;
+                inSubdomain.swap(grown);
+            }
+            std::vector<unsigned> cells;
+            for (unsigned cellIdx = 0; cellIdx < nc; ++cellIdx)
+                if (inSubdomain[cellIdx] && solvable[cellIdx])
+                    cells.push_back(cellIdx);
+
+            // nothing can be solved locally if all violating cells are seen by
+            // other processes
+            if (comm.max(cells.empty() ? 0 : 1) == 0)
+                return false;
+
+            SolutionVector& solution = ebosSimulator_.model().solution(/*timeIdx=*/0);
+            std::vector<PrimaryVariables> savedSolution;
+            savedSolution.reserve(cells.size());
+            for (const unsigned cellIdx : cells)
+                savedSolution.push_back(solution[cellIdx]);
+
+            std::vector<int> localIdx(nc, -1);
+            const bool success = solveSubdomain_(cells, localIdx, dt, tol_cnv, param_.local_solve_max_iter_, report);
+
+            // all processes must either accept or reject, since a rejection
+            // is followed by a global iteration for the state before the
+            // local solve
+            if (comm.min(success ? 1 : 0) == 1)
+                return true;
+
+            for (std::size_t i = 0; i < cells.size(); ++i)
+                solution[cells[i]] = savedSolution[i];
+            ebosSimulator_.model().invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
+            report.total_local_solve_failures += 1;
+            if (terminal_output_)
+                OpmLog::debug("Local solve rejected, continuing with a global iteration");
+            return false;
+        }
+
+        // Split the cells of this process which can be solved locally into
+        // about param_.nldd_num_subdomains_ blocks of grid columns, using the
+        // logical Cartesian coordinates of the cells.
+        void setupNlddSubdomains_()
+        {
+            const auto& vanguard = ebosSimulator_.vanguard();
+            const std::vector<char> solvable = locallySolvableCells_();
+            const unsigned nc = solvable.size();
+
+            const int numSubdomains = std::max(param_.nldd_num_subdomains_, 1);
+            const int nbx = static_cast<int>(std::ceil(std::sqrt(double(numSubdomains))));
+            const int nby = (numSubdomains + nbx - 1) / nbx;
+            const auto& dims = vanguard.cartesianDimensions();
+
+            nldd_subdomains_.assign(nbx*nby, std::vector<unsigned>());
+            for (unsigned cellIdx = 0; cellIdx < nc; ++cellIdx) {
+                if (!solvable[cellIdx])
+                    continue;
+                std::array<int, 3> ijk;
+                vanguard.cartesianCoordinate(cellIdx, ijk);
+                const int bx = ijk[0]*nbx/dims[0];
+                const int by = ijk[1]*nby/dims[1];
+                nldd_subdomains_[bx + nbx*by].push_back(cellIdx);
+            }
+            nldd_subdomains_.erase(std::remove_if(nldd_subdomains_.begin(), nldd_subdomains_.end(),
+                                                  [](const std::vector<unsigned>& cells) { return cells.empty(); }),
+                                   nldd_subdomains_.end());
+        }
+
+        // Nonlinear domain decomposition: solve the subdomains which violate the
+        // CNV criterion one after the other, each with the rest of the reservoir
+        // frozen at its current state. The solution of a subdomain whose solve
+        // fails is restored. The caller then takes a global Newton step from the
+        // resulting state. Returns whether the solve of any subdomain of this
+        // process has been accepted.
+        bool solveNlddSubdomains_(const SimulatorTimerInterface& timer, const int iteration, SimulatorReport& report)
+        {
+            if (nldd_subdomains_.empty())
+                setupNlddSubdomains_();
+
+            const double dt = timer.currentStepLength();
+            const double tol_cnv = (iteration < param_.max_strict_iter_) ? param_.tolerance_cnv_ : param_.tolerance_cnv_relaxed_;
+            const auto& ebosResid = ebosSimulator_.model().linearizer().residual();
+            SolutionVector& solution = ebosSimulator_.model().solution(/*timeIdx=*/0);
+            std::vector<int> localIdx(ebosResid.size(), -1);
+            std::vector<PrimaryVariables> savedSolution;
+            bool changed = false;
+
+            for (const auto& cells : nldd_subdomains_) {
+                // the residual of the global linearization decides which
+                // subdomains need to be solved
+                const bool violated = std::any_of(cells.begin(), cells.end(),
+                                                  [&](const unsigned cellIdx)
+                                                  { return cellCnvError_(cellIdx, ebosResid[cellIdx], dt) > tol_cnv; });
+                if (!violated)
+                    continue;
+
+                savedSolution.clear();
+                for (const unsigned cellIdx : cells)
+                    savedSolution.push_back(solution[cellIdx]);
+
+                if (!solveSubdomain_(cells, localIdx, dt, tol_cnv, param_.nldd_max_local_iter_, report)) {
+                    for (std::size_t i = 0; i < cells.size(); ++i)
+                        solution[cells[i]] = savedSolution[i];
+                    ebosSimulator_.model().invalidateIntensiveQuantitiesCache(/*timeIdx=*/0);
+                    report.total_local_solve_failures += 1;
+                }
+                else
+                    changed = true;
+            }
+
+            return changed;
+        }
+
+        // Linearize the reservoir again after its state has been changed within
+        // a Newton iteration. The well model prepares the time step in the
+        // first linearization of the time step only, hence the iteration index
+        // passed on is at least one.
+        void relinearize_(const SimulatorTimerInterface& timer, const int iteration, SimulatorReport& report)
+        {
+            Dune::Timer perfTimer;
+            perfTimer.start();
+            try {
+                PerformanceProfile::ScopedTimer profileTimer("assembly");
+                report.total_linearizations += 1;
+                report += assembleReservoir(timer, std::max(iteration, 1));
+                report.assemble_time += perfTimer.stop();
+            }
+            catch (...) {
+                report.assemble_time += perfTimer.stop();
+                throw;
+            }
+        }
+
+        // Set up a matrix with the sparsity pattern of the Jacobian, unless
+        // this has already been done.
+        template <class SubMatrix>
+        static void setupSubMatrix_(const Mat& jacobian, std::unique_ptr<SubMatrix>& matrix)
+        {
+            if (matrix && matrix->N() == jacobian.N() && matrix->nonzeroes() == jacobian.nonzeroes())
+                return;
+
+            matrix.reset(new SubMatrix(jacobian.N(), jacobian.M(), SubMatrix::row_wise));
+            auto createIter = matrix->createbegin();
+            for (const auto& row : jacobian) {
+                for (auto col = row.begin(); col != row.end(); ++col)
+                    createIter.insert(col.index());
+                ++createIter;
+            }
+        }
+
+        // the indices of the equations and the primary variables of the
+        // transport system in the full system
+        static int transportEqIdx_(const int idx)
+        { return (idx < sequentialPressureEqIdx) ? idx : idx + 1; }
+
+        static int transportVarIdx_(const int idx)
+        { return (idx < Indices::pressureSwitchIdx) ? idx : idx + 1; }
+
+        // One iteration of the sequential implicit method: Newton iterations for
+        // the pressure equation with the other primary variables fixed, followed
+        // by Newton iterations for the transport equations with the pressure
+        // fixed.
+        //
+        // The pressure equation of a cell is the combination of its conservation
+        // equations with the quasi-IMPES weights, which removes the dependence
+        // on the other primary variables of the cell. It replaces one of the
+        // conservation equations like in the CPR preconditioner, and the others
+        // are the transport equations. The iterations of the nonlinear solver
+        // form the outer loop, i.e., they check the convergence of the fully
+        // implicit system. The wells are part of both systems via their
+        // contributions to the Jacobian.
+        //
+        // The reservoir must be linearized for the current state when this
+        // method is called.
+        void sequentialIteration_(const SimulatorTimerInterface& timer, const int iteration, SimulatorReport& report)
+        {
+            const double dt = timer.currentStepLength();
+            const double tol_cnv = (iteration < param_.max_strict_iter_) ? param_.tolerance_cnv_ : param_.tolerance_cnv_relaxed_;
+            auto& ebosJac = ebosSimulator_.model().linearizer().jacobian();
+            auto& ebosResid = ebosSimulator_.model().linearizer().residual();
+            const auto& jacobian = ebosJac.istlMatrix();
+            const unsigned nc = ebosResid.size();
+            const int pressureVarIdx = Indices::pressureSwitchIdx;
+            BVector x(nc);
+            Dune::Timer stageTimer;
+            Dune::Timer perfTimer;
+
+            // the sparsity pattern changes with the wells
+            if (wellModel().wellSparsityRevision() != sequentialWellSparsityRevision_) {
+                pressureMatrix_.reset();
+                transportMatrix_.reset();
+                sequentialWellSparsityRevision_ = wellModel().wellSparsityRevision();
+            }
+
+            typedef Dune::MatrixAdapter<PressureMatrix, PressureVector, PressureVector> PressureOperator;
+            typedef Dune::SeqSSOR<PressureMatrix, PressureVector, PressureVector> PressureSmoother;
+            typedef Dune::Amg::CoarsenCriterion<Dune::Amg::SymmetricCriterion<PressureMatrix, Dune::Amg::FirstDiagonal>> PressureCriterion;
+            typedef Dune::MatrixAdapter<TransportMatrix, TransportVector, TransportVector> TransportOperator;
+
+            // pressure step
+            stageTimer.start();
+            for (int pressureIter = 0; pressureIter < param_.sequential_max_pressure_iter_; ++pressureIter) {
+                if (pressureIter > 0)
+                    relinearize_(timer, iteration, report);
+                {
+                    PerformanceProfile::ScopedTimer profileTimer("wellLinearization");
+                    wellModel().linearize(ebosJac, ebosResid);
+                }
+
+                perfTimer.reset();
+                perfTimer.start();
+                setupSubMatrix_(jacobian, pressureMatrix_);
+                PressureVector pressureResid(nc);
+                for (unsigned rowIdx = 0; rowIdx < nc; ++rowIdx) {
+                    VectorBlockType weights;
+                    Opm::Amg::getQuasiImpesWeight(jacobian[rowIdx], rowIdx, pressureVarIdx, /*transpose=*/false, weights);
+                    pressureResid[rowIdx] = weights.dot(ebosResid[rowIdx]);
+                    auto pressureCol = (*pressureMatrix_)[rowIdx].begin();
+                    for (auto col = jacobian[rowIdx].begin(); col != jacobian[rowIdx].end(); ++col, ++pressureCol) {
+                        Scalar value = 0.0;
+                        for (int eqIdx = 0; eqIdx < numEq; ++eqIdx)
+                            value += weights[eqIdx] * (*col)[eqIdx][pressureVarIdx];
+                        *pressureCol = value;
+                    }
+                }
+
+                PressureVector dp(nc);
+                dp = 0.0;
+                PressureOperator op(*pressureMatrix_);
+                typename Dune::Amg::SmootherTraits<PressureSmoother>::Arguments smootherArgs;
+                smootherArgs.iterations = 1;
+                PressureCriterion criterion(/*maxLevel=*/15, /*coarsenTarget=*/2000);
+                criterion.setDefaultValuesIsotropic(2);
+                Dune::Amg::AMG<PressureOperator, PressureVector, PressureSmoother> amg(op, criterion, smootherArgs);
+                Dune::BiCGSTABSolver<PressureVector> solver(op, amg, 1e-4, 200, /*verbose=*/0);
+                Dune::InverseOperatorResult result;
+                solver.apply(dp, pressureResid, result);
+                report.linear_solve_time += perfTimer.stop();
+                report.total_linear_iterations += result.iterations;
+                if (!result.converged)
+                    OPM_THROW_NOLOG(NumericalIssue, "Convergence failure for the linear solver of the pressure step.");
+
+                perfTimer.reset();
+                perfTimer.start();
+                Scalar maxDp = 0.0;
+                x = 0.0;
+                for (unsigned cellIdx = 0; cellIdx < nc; ++cellIdx) {
+                    x[cellIdx][pressureVarIdx] = dp[cellIdx];
+                    maxDp = std::max(maxDp, std::abs(dp[cellIdx][0]));
+                }
+                wellModel().postSolve(x);
+                updateSolution(x);
+                report.update_time += perfTimer.stop();
+
+                if (maxDp < param_.sequential_pressure_change_tolerance_)
+                    break;
+            }
+            report.pressure_time += stageTimer.stop();
+
+            // transport step
+            stageTimer.reset();
+            stageTimer.start();
+            if (param_.sequential_reorder_transport_) {
+                reorderedTransport_(timer, iteration, report);
+            }
+            else {
+                for (int transportIter = 0; transportIter < param_.sequential_max_transport_iter_; ++transportIter) {
+                    relinearize_(timer, iteration, report);
+                    {
+                        PerformanceProfile::ScopedTimer profileTimer("wellLinearization");
+                        wellModel().linearize(ebosJac, ebosResid);
+                    }
+
+                    // the residual of the pressure equation is not reduced by
+                    // this step, hence only the transport equations are checked
+                    Scalar error = 0.0;
+                    for (unsigned cellIdx = 0; cellIdx < nc; ++cellIdx) {
+                        VectorBlockType resid = ebosResid[cellIdx];
+                        resid[sequentialPressureEqIdx] = 0.0;
+                        error = std::max(error, cellCnvError_(cellIdx, resid, dt));
+                    }
+                    if (error <= tol_cnv)
+                        break;
+
+                    perfTimer.reset();
+                    perfTimer.start();
+                    setupSubMatrix_(jacobian, transportMatrix_);
+                    TransportVector transportResid(nc);
+                    for (unsigned rowIdx = 0; rowIdx < nc; ++rowIdx) {
+                        for (int eqIdx = 0; eqIdx < numTransportEq; ++eqIdx)
+                            transportResid[rowIdx][eqIdx] = ebosResid[rowIdx][transportEqIdx_(eqIdx)];
+                        auto transportCol = (*transportMatrix_)[rowIdx].begin();
+                        for (auto col = jacobian[rowIdx].begin(); col != jacobian[rowIdx].end(); ++col, ++transportCol)
+                            for (int eqIdx = 0; eqIdx < numTransportEq; ++eqIdx)
+                                for (int varIdx = 0; varIdx < numTransportEq; ++varIdx)
+                                    (*transportCol)[eqIdx][varIdx] = (*col)[transportEqIdx_(eqIdx)][transportVarIdx_(varIdx)];
+                    }
+
+                    TransportVector ds(nc);
+                    ds = 0.0;
+                    TransportOperator op(*transportMatrix_);
+                    Dune::SeqILU0<TransportMatrix, TransportVector, TransportVector> precond(*transportMatrix_, 1.0);
+                    Dune::BiCGSTABSolver<TransportVector> solver(op, precond, 1e-4, 200, /*verbose=*/0);
+                    Dune::InverseOperatorResult result;
+                    solver.apply(ds, transportResid, result);
+                    report.linear_solve_time += perfTimer.stop();
+                    report.total_linear_iterations += result.iterations;
+                    if (!result.converged)
+                        OPM_THROW_NOLOG(NumericalIssue, "Convergence failure for the linear solver of the transport step.");
+
+                    perfTimer.reset();
+                    perfTimer.start();
+                    x = 0.0;
+                    for (unsigned cellIdx = 0; cellIdx < nc; ++cellIdx)
+                        for (int varIdx = 0; varIdx < numTransportEq; ++varIdx)
+                            x[cellIdx][transportVarIdx_(varIdx)] = ds[cellIdx][varIdx];
+                    wellModel().postSolve(x);
+                    updateSolution(x);
+                    report.update_time += perfTimer.stop();
+                }
+            }
+            report.transport_time += stageTimer.stop();
+        }
+
+        // Transport step of the sequential implicit method by a nonlinear
+        // Gauss-Seidel method. With upstream weighting, the transport equations
+        // of a cell only depend on the transport variables of the neighbors
+        // which are upwind for some phase. The upwind graph of the current
+        // phase fluxes is built face by face. Its strongly connected
+        // components, i.e. single cells where the flow is cocurrent and groups
+        // of cells with countercurrent flow, are solved in upwind order by
+        // Newton's method with all other cells and the wells fixed.
+        void reorderedTransport_(const SimulatorTimerInterface& timer, const int iteration, SimulatorReport& report)
+        {
+            const double dt = timer.currentStepLength();
+            const double tol_cnv = (iteration < param_.max_strict_iter_) ? param_.tolerance_cnv_ : param_.tolerance_cnv_relaxed_;
+
+            relinearize_(timer, iteration, report);
+            const unsigned nc = ebosSimulator_.model().linearizer().residual().size();
+
+            // the row of a cell contains the cell itself and its neighbors
+            // which are upwind of it for at least one phase
+            std::vector<std::vector<unsigned>> upwindNeighbors(nc);
+            ElementContext elemCtx(ebosSimulator_);
+            const auto& gridView = ebosSimulator_.gridView();
+            const auto& elemEndIt = gridView.template end</*codim=*/0>();
+            for (auto elemIt = gridView.template begin</*codim=*/0>(); elemIt != elemEndIt; ++elemIt) {
+                elemCtx.updateAll(*elemIt);
+                const unsigned cellIdx = elemCtx.globalSpaceIndex(/*dofIdx=*/0, /*timeIdx=*/0);
+                for (unsigned scvfIdx = 0; scvfIdx < elemCtx.numInteriorFaces(/*timeIdx=*/0); ++scvfIdx) {
+                    const auto& extQuants = elemCtx.extensiveQuantities(scvfIdx, /*timeIdx=*/0);
+                    const unsigned exteriorIdx = extQuants.exteriorIndex();
+                    for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+                        if (FluidSystem::phaseIsActive(phaseIdx)
+                            && extQuants.upstreamIndex(phaseIdx) == exteriorIdx)
+                        {
+                            upwindNeighbors[cellIdx].push_back(elemCtx.globalSpaceIndex(exteriorIdx, /*timeIdx=*/0));
+                            break;
+                        }
+                    }
+                }
+            }
+
+            PressureMatrix upwind(nc, nc, PressureMatrix::row_wise);
+            for (auto createIter = upwind.createbegin(); createIter != upwind.createend(); ++createIter) {
+                const unsigned rowIdx = createIter.index();
+                createIter.insert(rowIdx);
+                for (const unsigned colIdx : upwindNeighbors[rowIdx])
+                    createIter.insert(colIdx);
+            }
+            typedef Dune::Amg::MatrixGraph<const PressureMatrix> UpwindGraph;
+            const auto components = Opm::stronglyConnectedComponents(UpwindGraph(upwind));
+            const auto& orderedCells = components.first;
+            const auto& offsets = components.second;
+
+            if (elements_.empty()) {
+                const auto& elemMapper = ebosSimulator_.model().elementMapper();
+                elementPos_.resize(nc);
+                for (auto elemIt = gridView.template begin</*codim=*/0>(); elemIt != elemEndIt; ++elemIt) {
+                    elementPos_[elemMapper.index(*elemIt)] = elements_.size();
+                    elements_.push_back(*elemIt);
+                }
+            }
+
+            std::vector<int> localIdx(nc, -1);
+            std::size_t cellLinearizations = 0;
+            for (std::size_t compIdx = 0; compIdx + 1 < offsets.size(); ++compIdx) {
+                const std::vector<unsigned> cells(orderedCells.begin() + offsets[compIdx],
+                                                  orderedCells.begin() + offsets[compIdx + 1]);
+                cellLinearizations += solveTransportComponent_(cells, localIdx, dt, tol_cnv, report);
+            }
+            report.total_local_linearizations += 1;
+            report.local_linearization_cells += double(cellLinearizations) / nc;
+        }
+
+        // Newton's method for the transport equations of a strongly connected
+        // component of the upwind graph. The solution of the cells is restored
+        // if the method fails, the convergence is checked by the global
+        // iteration. Returns the number of cell linearizations.
+        std::size_t solveTransportComponent_(const std::vector<unsigned>& cells,
+                                             std::vector<int>& localIdx,
+                                             const double dt,
+                                             const double tol_cnv,
+                                             SimulatorReport& report)
+        {
+            typedef Dune::FieldMatrix<Scalar, numTransportEq, numTransportEq> TransportBlock;
+
+            SolutionVector& solution = ebosSimulator_.model().solution(/*timeIdx=*/0);
+            std::vector<PrimaryVariables> savedSolution;
+            savedSolution.reserve(cells.size());
+            for (std::size_t i = 0; i < cells.size(); ++i) {
+                localIdx[cells[i]] = i;
+                savedSolution.push_back(solution[cells[i]]);
+            }
+
+            ElementContext elemCtx(ebosSimulator_);
+            auto& localLinearizer = ebosSimulator_.model().localLinearizer(ThreadManager::threadId());
+            TransportVector resid(cells.size());
+            TransportVector ds(cells.size());
+            std::size_t cellLinearizations = 0;
+            try {
+                for (int iter = 0; iter < param_.sequential_max_transport_iter_; ++iter) {
+                    TransportMatrix jac(cells.size(), cells.size(), 7, 0.4, TransportMatrix::implicit);
+                    Scalar error = 0.0;
+                    for (std::size_t i = 0; i < cells.size(); ++i) {
+                        localLinearizer.linearize(elemCtx, elements_[elementPos_[cells[i]]]);
+                        VectorBlockType cellResid = localLinearizer.residual(/*dofIdx=*/0);
+                        for (int eqIdx = 0; eqIdx < numTransportEq; ++eqIdx)
+                            resid[i][eqIdx] = cellResid[transportEqIdx_(eqIdx)];
+                        cellResid[sequentialPressureEqIdx] = 0.0;
+                        error = std::max(error, cellCnvError_(cells[i], cellResid, dt));
+
+                        // the derivatives of the residual of the j-th cell w.r.t.
+                        // the primary variables of the i-th one
+                        for (unsigned dofIdx = 0; dofIdx < elemCtx.numDof(/*timeIdx=*/0); ++dofIdx) {
+                            const int j = localIdx[elemCtx.globalSpaceIndex(dofIdx, /*timeIdx=*/0)];
+                            if (j < 0)
+                                continue;
+                            const auto& block = localLinearizer.jacobian(dofIdx, /*rangeDofIdx=*/0);
+                            TransportBlock& transportBlock = jac.entry(j, i);
+                            for (int eqIdx = 0; eqIdx < numTransportEq; ++eqIdx)
+                                for (int varIdx = 0; varIdx < numTransportEq; ++varIdx)
+                                    transportBlock[eqIdx][varIdx] = block[transportEqIdx_(eqIdx)][transportVarIdx_(varIdx)];
+                        }
+                    }
+                    jac.compress();
+                    cellLinearizations += cells.size();
+                    if (error <= tol_cnv)
+                        break;
+
+                    if (cells.size() == 1) {
+                        jac[0][0].solve(ds[0], resid[0]);
+                    }
+                    else {
+                        ds = 0.0;
+                        Dune::MatrixAdapter<TransportMatrix, TransportVector, TransportVector> op(jac);
+                        Dune::SeqILU0<TransportMatrix, TransportVector, TransportVector> precond(jac, 1.0);
+                        Dune::BiCGSTABSolver<TransportVector> solver(op, precond, 1e-4, 200, /*verbose=*/0);
+                        Dune::InverseOperatorResult result;
+                        solver.apply(ds, resid, result);
+                        report.total_linear_iterations += result.iterations;
+                        if (!result.converged)
+                            OPM_THROW_NOLOG(NumericalIssue, "Convergence failure for the linear solver of a transport component.");
+                    }
+
+                    for (std::size_t i = 0; i < cells.size(); ++i)
+                        updateCellTransport_(cells[i], ds[i]);
+                }
+            }
+            catch (const Opm::NumericalIssue&) {
+                for (std::size_t i = 0; i < cells.size(); ++i) {
+                    solution[cells[i]] = savedSolution[i];
+                    ebosSimulator_.model().setIntensiveQuantitiesCacheEntryValidity(cells[i], /*timeIdx=*/0, false);
+                }
+                report.total_local_solve_failures += 1;
+            }
+            catch (const Dune::Exception&) {
+                for (std::size_t i = 0; i < cells.size(); ++i) {
+                    solution[cells[i]] = savedSolution[i];
+                    ebosSimulator_.model().setIntensiveQuantitiesCacheEntryValidity(cells[i], /*timeIdx=*/0, false);
+                }
+                report.total_local_solve_failures += 1;
+            }
+
+            for (const unsigned cellIdx : cells)
+                localIdx[cellIdx] = -1;
+            return cellLinearizations;
+        }
+
+        // Apply a Newton update to the transport variables of a single cell. As
+        // in the update of the black-oil Newton method, the change of the
+        // saturations is limited to 0.2 and the primary variables are switched
+        // if a phase appears or disappears.
+        template <class TransportVectorBlock>
+        void updateCellTransport_(const unsigned cellIdx, const TransportVectorBlock& ds)
+        {
+            const Scalar maxSaturationChange = 0.2;
+            PrimaryVariables& priVars = ebosSimulator_.model().solution(/*timeIdx=*/0)[cellIdx];
+
+            VectorBlockType delta(0.0);
+            for (int varIdx = 0; varIdx < numTransportEq; ++varIdx)
+                delta[transportVarIdx_(varIdx)] = ds[varIdx];
+
+            std::vector<int> saturationIdx;
+            if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx))
+                saturationIdx.push_back(Indices::waterSaturationIdx);
+            if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)
+                && priVars.primaryVarsMeaning() == PrimaryVariables::Sw_po_Sg)
+                saturationIdx.push_back(Indices::compositionSwitchIdx);
+
+            Scalar maxSaturationDelta = 0.0;
+            for (const int varIdx : saturationIdx)
+                maxSaturationDelta = std::max(maxSaturationDelta, std::abs(delta[varIdx]));
+            if (maxSaturationDelta > maxSaturationChange)
+                for (const int varIdx : saturationIdx)
+                    delta[varIdx] *= maxSaturationChange / maxSaturationDelta;
+
+            for (int varIdx = 0; varIdx < numEq; ++varIdx)
+                priVars[varIdx] -= delta[varIdx];
+            priVars.adaptPrimaryVariables(ebosSimulator_.problem(), cellIdx);
+            ebosSimulator_.model().setIntensiveQuantitiesCacheEntryValidity(cellIdx, /*timeIdx=*/0, false);
+        }
+
         double dpMaxRel() const { return param_.dp_max_rel_; }
         double dsMax() const { return param_.ds_max_; }
         double drMaxRel() const { return param_.dr_max_rel_; }
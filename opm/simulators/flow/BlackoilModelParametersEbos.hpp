@@ -49,6 +49,17 @@ NEW_PROP_TAG(UpdateEquationsScaling);
 NEW_PROP_TAG(UseUpdateStabilization);
 NEW_PROP_TAG(MatrixAddWellContributions);
 NEW_PROP_TAG(EnableWellOperabilityCheck);
+NEW_PROP_TAG(VerifyThreadedLinearization);
+NEW_PROP_TAG(LocalSolveMaxPvFraction);
+NEW_PROP_TAG(LocalSolveHaloLayers);
+NEW_PROP_TAG(LocalSolveMaxIter);
+NEW_PROP_TAG(NlddNumSubdomains);
+NEW_PROP_TAG(NlddMaxLocalIter);
+NEW_PROP_TAG(SequentialImplicit);
+NEW_PROP_TAG(SequentialMaxPressureIter);
+NEW_PROP_TAG(SequentialMaxTransportIter);
+NEW_PROP_TAG(SequentialPressureChangeTolerance);
+NEW_PROP_TAG(SequentialReorderTransport);
 
 // parameters for multisegment wells
 NEW_PROP_TAG(TolerancePressureMsWells);
@@ -77,6 +88,17 @@ SET_SCALAR_PROP(FlowModelParameters, MaxPressureChangeMsWells, 10*1e5);
 SET_BOOL_PROP(FlowModelParameters, UseInnerIterationsMsWells, true);
 SET_INT_PROP(FlowModelParameters, MaxInnerIterMsWells, 100);
 SET_BOOL_PROP(FlowModelParameters, EnableWellOperabilityCheck, true);
+SET_BOOL_PROP(FlowModelParameters, VerifyThreadedLinearization, false);
+SET_SCALAR_PROP(FlowModelParameters, LocalSolveMaxPvFraction, 0.0);
+SET_INT_PROP(FlowModelParameters, LocalSolveHaloLayers, 1);
+SET_INT_PROP(FlowModelParameters, LocalSolveMaxIter, 5);
+SET_INT_PROP(FlowModelParameters, NlddNumSubdomains, 0);
+SET_INT_PROP(FlowModelParameters, NlddMaxLocalIter, 10);
+SET_BOOL_PROP(FlowModelParameters, SequentialImplicit, false);
+SET_INT_PROP(FlowModelParameters, SequentialMaxPressureIter, 10);
+SET_INT_PROP(FlowModelParameters, SequentialMaxTransportIter, 10);
+SET_SCALAR_PROP(FlowModelParameters, SequentialPressureChangeTolerance, 1.0e3);
+SET_BOOL_PROP(FlowModelParameters, SequentialReorderTransport, false);
 
 // if openMP is available, determine the number threads per process automatically.
 #if _OPENMP
@@ -155,6 +177,49 @@ namespace Opm
         // Whether to add influences of wells between cells to the matrix and preconditioner matrix
         bool matrix_add_well_contributions_;
 
+        /// Whether to linearize every Newton iteration first using a single
+        /// thread and to abort unless the multithreaded linearization is
+        /// bitwise identical.
+        bool verify_threaded_linearization_;
+
+        /// Largest fraction of the pore volume violating the CNV criterion for
+        /// which Newton iterations are done on the violating cells only. 0
+        /// disables these local solves.
+        double local_solve_max_pv_fraction_;
+
+        /// Number of layers of neighbors added to the violating cells of a
+        /// local solve.
+        int local_solve_halo_layers_;
+
+        /// Maximum number of linearizations of a local solve.
+        int local_solve_max_iter_;
+
+        /// Number of subdomains of each process which are solved before every
+        /// global Newton iteration. 0 disables the nonlinear domain
+        /// decomposition.
+        int nldd_num_subdomains_;
+
+        /// Maximum number of linearizations of a subdomain per Newton iteration.
+        int nldd_max_local_iter_;
+
+        /// Whether to replace the linear solve of every Newton iteration by a
+        /// pressure step followed by a transport step.
+        bool sequential_implicit_;
+
+        /// Maximum number of linearizations of the pressure step.
+        int sequential_max_pressure_iter_;
+
+        /// Maximum number of linearizations of the transport step.
+        int sequential_max_transport_iter_;
+
+        /// Largest pressure change (in Pascal) of the last iteration for which
+        /// the pressure step is converged.
+        double sequential_pressure_change_tolerance_;
+
+        /// Whether to solve the transport step cell by cell in upwind order
+        /// instead of by Newton's method for all cells.
+        bool sequential_reorder_transport_;
+
         /// Construct from user parameters or defaults.
         BlackoilModelParametersEbos()
         {
@@ -178,6 +243,17 @@ namespace Opm
             update_equations_scaling_ = EWOMS_GET_PARAM(TypeTag, bool, UpdateEquationsScaling);
             use_update_stabilization_ = EWOMS_GET_PARAM(TypeTag, bool, UseUpdateStabilization);
             matrix_add_well_contributions_ = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
+            verify_threaded_linearization_ = EWOMS_GET_PARAM(TypeTag, bool, VerifyThreadedLinearization);
+            local_solve_max_pv_fraction_ = EWOMS_GET_PARAM(TypeTag, Scalar, LocalSolveMaxPvFraction);
+            local_solve_halo_layers_ = EWOMS_GET_PARAM(TypeTag, int, LocalSolveHaloLayers);
+            local_solve_max_iter_ = EWOMS_GET_PARAM(TypeTag, int, LocalSolveMaxIter);
+            nldd_num_subdomains_ = EWOMS_GET_PARAM(TypeTag, int, NlddNumSubdomains);
+            nldd_max_local_iter_ = EWOMS_GET_PARAM(TypeTag, int, NlddMaxLocalIter);
+            sequential_implicit_ = EWOMS_GET_PARAM(TypeTag, bool, SequentialImplicit);
+            sequential_max_pressure_iter_ = EWOMS_GET_PARAM(TypeTag, int, SequentialMaxPressureIter);
+            sequential_max_transport_iter_ = EWOMS_GET_PARAM(TypeTag, int, SequentialMaxTransportIter);
+            sequential_pressure_change_tolerance_ = EWOMS_GET_PARAM(TypeTag, Scalar, SequentialPressureChangeTolerance);
+            sequential_reorder_transport_ = EWOMS_GET_PARAM(TypeTag, bool, SequentialReorderTransport);
 
             deck_file_name_ = EWOMS_GET_PARAM(TypeTag, std::string, EclDeckFileName);
         }
@@ -205,6 +281,17 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseUpdateStabilization, "Try to detect and correct oscillations or stagnation during the Newton method");
             EWOMS_REGISTER_PARAM(TypeTag, bool, MatrixAddWellContributions, "Explicitly specify the influences of wells between cells in the Jacobian and preconditioner matrices");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableWellOperabilityCheck, "Enable the well operability checking");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, VerifyThreadedLinearization, "Check that the multithreaded linearization of the reservoir equations is bitwise identical to the single-threaded one. This is a debugging aid which doubles the cost of the linearization");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, LocalSolveMaxPvFraction, "Largest fraction of the pore volume violating the CNV criterion for which Newton iterations are restricted to the violating cells and their neighbors (0 disables local solves)");
+            EWOMS_REGISTER_PARAM(TypeTag, int, LocalSolveHaloLayers, "Number of layers of neighboring cells added to the violating cells of a local solve");
+            EWOMS_REGISTER_PARAM(TypeTag, int, LocalSolveMaxIter, "Maximum number of linearizations of a local solve before falling back to a global Newton iteration");
+            EWOMS_REGISTER_PARAM(TypeTag, int, NlddNumSubdomains, "Number of subdomains per process which are solved nonlinearly before every global Newton iteration (0 disables the nonlinear domain decomposition)");
+            EWOMS_REGISTER_PARAM(TypeTag, int, NlddMaxLocalIter, "Maximum number of linearizations of a subdomain of the nonlinear domain decomposition per Newton iteration");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, SequentialImplicit, "Solve every Newton iteration sequentially, i.e., a pressure step with fixed saturations followed by a transport step with fixed pressure (serial runs only, requires --matrix-add-well-contributions=true)");
+            EWOMS_REGISTER_PARAM(TypeTag, int, SequentialMaxPressureIter, "Maximum number of linearizations of the pressure step of the sequential implicit method");
+            EWOMS_REGISTER_PARAM(TypeTag, int, SequentialMaxTransportIter, "Maximum number of linearizations of the transport step of the sequential implicit method");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, SequentialPressureChangeTolerance, "Largest pressure change in Pascal for which the pressure step of the sequential implicit method is converged");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, SequentialReorderTransport, "Solve the transport step of the sequential implicit method by a nonlinear Gauss-Seidel method in upwind order");
         }
     };
 } // namespace Opm
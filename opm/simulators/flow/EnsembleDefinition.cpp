@@ -0,0 +1,136 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/flow/EnsembleDefinition.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace Opm {
+
+    std::vector<EnsembleMember> readEnsembleDefinition(std::istream& is)
+    {
+        const std::set<std::string> supported = { "PERMX", "PERMY", "PERMZ", "PORO" };
+
+        std::vector<EnsembleMember> members;
+        std::set<std::string> names;
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(is, line)) {
+            ++lineNumber;
+            std::istringstream tokens(line);
+            EnsembleMember member;
+            if (!(tokens >> member.name) || member.name.compare(0, 2, "--") == 0 || member.name[0] == '#')
+                continue;
+
+            const std::string where = "Line " + std::to_string(lineNumber) + " of the ensemble definition: ";
+            if (!names.insert(member.name).second)
+                throw std::invalid_argument(where + "duplicate realization '" + member.name + "'");
+
+            std::string entry;
+            while (tokens >> entry) {
+                const auto pos = entry.find('=');
+                if (pos == std::string::npos)
+                    throw std::invalid_argument(where + "expected KEYWORD=FACTOR or KEYWORD=@FILE, got '" + entry + "'");
+
+                const std::string keyword = entry.substr(0, pos);
+                if (supported.count(keyword) == 0)
+                    throw std::invalid_argument(where + "unsupported keyword '" + keyword + "'");
+                if (member.multipliers.count(keyword) > 0 || member.arrayFiles.count(keyword) > 0)
+                    throw std::invalid_argument(where + "repeated keyword '" + keyword + "'");
+
+                if (entry.compare(pos + 1, 1, "@") == 0) {
+                    if (entry.size() == pos + 2)
+                        throw std::invalid_argument(where + "missing file name in '" + entry + "'");
+                    member.arrayFiles[keyword] = entry.substr(pos + 2);
+                    continue;
+                }
+
+                double factor;
+                std::size_t end = 0;
+                try {
+                    factor = std::stod(entry.substr(pos + 1), &end);
+                }
+                catch (const std::exception&) {
+                    end = 0;
+                }
+                if (end == 0 || end != entry.size() - pos - 1 || !(factor > 0.0))
+                    throw std::invalid_argument(where + "invalid factor in '" + entry + "'");
+
+                member.multipliers[keyword] = factor;
+            }
+            members.push_back(member);
+        }
+
+        return members;
+    }
+
+    std::vector<double> cellMultipliers(const std::vector<double>& deckValues,
+                                        const std::vector<double>& values)
+    {
+        if (values.size() != deckValues.size())
+            throw std::invalid_argument("The array has " + std::to_string(values.size())
+                                        + " values, but the grid has " + std::to_string(deckValues.size())
+                                        + " cells");
+
+        std::vector<double> multipliers(values.size(), 1.0);
+        for (std::size_t cellIdx = 0; cellIdx < values.size(); ++cellIdx) {
+            if (!(values[cellIdx] >= 0.0))
+                throw std::invalid_argument("Invalid value " + std::to_string(values[cellIdx])
+                                            + " of cell " + std::to_string(cellIdx + 1));
+            if (deckValues[cellIdx] > 0.0)
+                multipliers[cellIdx] = values[cellIdx]/deckValues[cellIdx];
+            else if (values[cellIdx] > 0.0)
+                throw std::invalid_argument("The value of cell " + std::to_string(cellIdx + 1)
+                                            + " is zero in the deck and cannot be replaced");
+        }
+        return multipliers;
+    }
+
+    double connectionFactorMultiplier(const double permxMult, const double permyMult, const double permzMult,
+                                      const Connection::Direction direction)
+    {
+        double mult1, mult2;
+        switch (direction) {
+        case Connection::Direction::X:
+            mult1 = permyMult;
+            mult2 = permzMult;
+            break;
+        case Connection::Direction::Y:
+            mult1 = permxMult;
+            mult2 = permzMult;
+            break;
+        default:
+            mult1 = permxMult;
+            mult2 = permyMult;
+            break;
+        }
+
+        // the factors derived from the arrays of a realization differ by
+        // rounding errors even if the array scales both permeabilities alike
+        if (std::abs(mult1 - mult2) > 1e-10*std::max(mult1, mult2))
+            throw std::invalid_argument("The permeabilities perpendicular to a well connection whose "
+                                        "transmissibility factor is computed from them must be "
+                                        "multiplied by the same factor");
+        return (mult1 == mult2) ? mult1 : std::sqrt(mult1*mult2);
+    }
+
+} // namespace Opm
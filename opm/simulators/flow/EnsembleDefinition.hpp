@@ -0,0 +1,85 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ENSEMBLEDEFINITION_HEADER_INCLUDED
+#define OPM_ENSEMBLEDEFINITION_HEADER_INCLUDED
+
+#include <opm/parser/eclipse/EclipseState/Schedule/Well/Connection.hpp>
+
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    /// A realization of an ensemble, i.e. the base model with some field
+    /// properties multiplied by constant factors or replaced by the arrays
+    /// of include files.
+    struct EnsembleMember
+    {
+        std::string name;
+        std::map<std::string, double> multipliers;
+        std::map<std::string, std::string> arrayFiles;
+    };
+
+    /// Read the members of an ensemble.
+    ///
+    /// Every non-empty line which does not start with '--' or '#' defines
+    /// one member: its name, which is also the name of its output
+    /// directory, followed by any number of KEYWORD=FACTOR and KEYWORD=@FILE
+    /// entries, e.g.
+    ///
+    ///     -- name   properties
+    ///     BASE
+    ///     R001      PERMX=1.5 PERMY=1.5 PORO=0.9
+    ///     R002      PERMX=@perm/R002.INC PERMY=@perm/R002.INC
+    ///
+    /// A factor multiplies all values of the property in the deck. A file is
+    /// an include file of the deck which contains the keyword; its array
+    /// replaces the values of the deck. The supported keywords are PERMX,
+    /// PERMY, PERMZ and PORO, each of which may appear once per member.
+    /// Throws std::invalid_argument for malformed lines, unsupported or
+    /// repeated keywords, non-positive factors and duplicate names.
+    std::vector<EnsembleMember> readEnsembleDefinition(std::istream& is);
+
+    /// The factors by which the values of a property in the deck have to be
+    /// multiplied to obtain the values of a realization, cell by cell.
+    ///
+    /// Cells with a value of zero in the deck get a factor of one if the
+    /// realization has a value of zero as well. Throws std::invalid_argument
+    /// if the sizes of the arrays differ, if a value of the realization is
+    /// negative or if it is positive where the one of the deck is zero.
+    std::vector<double> cellMultipliers(const std::vector<double>& deckValues,
+                                        const std::vector<double>& values);
+
+    /// The factor by which the multipliers of the permeabilities of a cell
+    /// scale the transmissibility factor of a well connection in the cell
+    /// which is computed from the permeabilities of the deck.
+    ///
+    /// The Peaceman factor of a connection is proportional to the geometric
+    /// mean of the two permeabilities perpendicular to it, while their ratio
+    /// enters the equivalent radius. The factor is thus only scaled exactly if
+    /// both permeabilities are multiplied by the same factor, which is
+    /// returned. Factors which only differ by rounding errors are accepted.
+    /// Throws std::invalid_argument otherwise.
+    double connectionFactorMultiplier(double permxMult, double permyMult, double permzMult,
+                                      Connection::Direction direction);
+
+} // namespace Opm
+
+#endif // OPM_ENSEMBLEDEFINITION_HEADER_INCLUDED
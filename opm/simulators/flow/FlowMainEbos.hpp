@@ -30,6 +30,7 @@
 #include <opm/simulators/flow/SimulatorFullyImplicitBlackoilEbos.hpp>
 #include <opm/simulators/utils/ParallelFileMerger.hpp>
 #include <opm/simulators/utils/moduleVersion.hpp>
+#include <opm/simulators/utils/PerformanceProfile.hpp>
 #include <opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp>
 
 #include <opm/core/props/satfunc/RelpermDiagnostics.hpp>
@@ -54,12 +55,14 @@ NEW_PROP_TAG(EnableDryRun);
 NEW_PROP_TAG(OutputInterval);
 NEW_PROP_TAG(UseAmg);
 NEW_PROP_TAG(EnableLoggingFalloutWarning);
+NEW_PROP_TAG(EnablePerformanceProfile);
 
 // TODO: enumeration parameters. we use strings for now.
 SET_STRING_PROP(EclFlowProblem, EnableDryRun, "auto");
 // Do not merge parallel output files or warn about them
 SET_BOOL_PROP(EclFlowProblem, EnableLoggingFalloutWarning, false);
 SET_INT_PROP(EclFlowProblem, OutputInterval, 1);
+SET_BOOL_PROP(EclFlowProblem, EnablePerformanceProfile, false);
 
 END_PROPERTIES
 
@@ -90,6 +93,8 @@ namespace Opm
                                  "Specify the number of report steps between two consecutive writes of restart data");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableLoggingFalloutWarning,
                                  "Developer option to see whether logging was on non-root processors. In that case it will be appended to the *.DBG or *.PRT files");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, EnablePerformanceProfile,
+                                 "Record timers and counters of the simulator phases on every process and write their statistics over the processes to the PRT file and to <CASE>.PROFILE.json at the end of the run");
 
             Simulator::registerParameters();
 
@@ -251,6 +256,25 @@ namespace Opm
                 int status = setupParameters_(argc, argv);
                 if (status)
                     return status;
+            }
+            catch (const std::exception& e) {
+                reportException_(e, output_cout);
+                return EXIT_FAILURE;
+            }
+
+            return executeWithParameters(output_cout, output_to_files);
+        }
+
+        /// Run a complete simulation with the command-line parameters read by
+        /// a previous call of execute(). This allows to run several simulations
+        /// in one process, e.g. the realizations of an ensemble which share the
+        /// externally specified input objects of the vanguard.
+        int executeWithParameters(bool output_cout, bool output_to_files)
+        {
+            try {
+                // the simulator of a previous run refers to its ebos simulator
+                simulator_.reset();
+                ebosSimulator_.reset();
 
                 setupParallelism();
                 setupEbosSimulator(output_cout);
@@ -266,24 +290,83 @@ namespace Opm
                 return EXIT_SUCCESS;
             }
             catch (const std::exception& e) {
-                std::ostringstream message;
-                message  << "Program threw an exception: " << e.what();
+                reportException_(e, output_cout);
+                return EXIT_FAILURE;
+            }
+        }
 
-                if (output_cout) {
-                    // in some cases exceptions are thrown before the logging system is set
-                    // up.
-                    if (OpmLog::hasBackend("STREAMLOG")) {
-                        OpmLog::error(message.str());
-                    }
-                    else {
-                        std::cout << message.str() << "\n";
-                    }
-                }
+        /// Set up a simulation like execute(), but only prepare the report
+        /// steps instead of running them. The report steps are then simulated
+        /// one by one via executeStep() until executeStepsDone() is true, and
+        /// the run is finished by executeStepsCleanup(). Between two steps,
+        /// the state of the simulation can be inspected and modified through
+        /// ebosSimulator() and simulatorTimer().
+        int executeInitStep(int argc, char** argv, bool output_cout)
+        {
+            try {
+                int status = setupParameters_(argc, argv);
+                if (status)
+                    return status;
+
+                simulator_.reset();
+                ebosSimulator_.reset();
+
+                setupParallelism();
+                setupEbosSimulator(output_cout);
+                runDiagnostics(output_cout);
+                createSimulator();
+
+                stepsActive_ = runSimulatorInit_(output_cout);
+                return EXIT_SUCCESS;
+            }
+            catch (const std::exception& e) {
+                reportException_(e, output_cout);
+                return EXIT_FAILURE;
+            }
+        }
+
+        /// Simulate the next report step of a run prepared by
+        /// executeInitStep().
+        int executeStep(bool output_cout)
+        {
+            try {
+                if (!executeStepsDone())
+                    simulator_->runStep(*simtimer_);
+                return EXIT_SUCCESS;
+            }
+            catch (const std::exception& e) {
+                reportException_(e, output_cout);
+                return EXIT_FAILURE;
+            }
+        }
+
+        /// Whether all report steps of a run prepared by executeInitStep()
+        /// have been simulated.
+        bool executeStepsDone() const
+        { return !stepsActive_ || simtimer_->done(); }
 
+        /// Finish a run prepared by executeInitStep().
+        int executeStepsCleanup(bool output_cout, bool output_to_files)
+        {
+            try {
+                if (stepsActive_)
+                    runSimulatorFinalize_(output_cout);
+                stepsActive_ = false;
+                mergeParallelLogFiles(output_to_files);
+                return EXIT_SUCCESS;
+            }
+            catch (const std::exception& e) {
+                reportException_(e, output_cout);
                 return EXIT_FAILURE;
             }
         }
 
+        EbosSimulator& ebosSimulator()
+        { return *ebosSimulator_; }
+
+        const SimulatorTimer& simulatorTimer() const
+        { return *simtimer_; }
+
         // Print an ASCII-art header to the PRT and DEBUG files.
         // \return Whether unkown keywords were seen during parsing.
         static void printPRTHeader(bool output_cout)
@@ -459,15 +542,28 @@ namespace Opm
 
         // Run the simulator.
         void runSimulator(bool output_cout)
+        {
+            if (!runSimulatorInit_(output_cout))
+                return;
+
+            while (!simtimer_->done())
+                simulator_->runStep(*simtimer_);
+
+            runSimulatorFinalize_(output_cout);
+        }
+
+        // Prepare the simulation of all report steps. Returns false if the
+        // simulation is turned off.
+        bool runSimulatorInit_(bool output_cout)
         {
             const auto& schedule = this->schedule();
             const auto& timeMap = schedule.getTimeMap();
             auto& ioConfig = eclState().getIOConfig();
-            SimulatorTimer simtimer;
+            simtimer_.reset(new SimulatorTimer);
 
             // initialize variables
             const auto& initConfig = eclState().getInitConfig();
-            simtimer.init(timeMap, (size_t)initConfig.getRestartStep());
+            simtimer_->init(timeMap, (size_t)initConfig.getRestartStep());
 
             if (output_cout) {
                 std::ostringstream oss;
@@ -481,34 +577,49 @@ namespace Opm
                 }
             }
 
-            if (!ioConfig.initOnly()) {
+            if (ioConfig.initOnly()) {
                 if (output_cout) {
-                    std::string msg;
-                    msg = "\n\n================ Starting main simulation loop ===============\n";
-                    OpmLog::info(msg);
+                    std::cout << "\n\n================ Simulation turned off ===============\n" << std::flush;
                 }
+                return false;
+            }
 
-                SimulatorReport successReport = simulator_->run(simtimer);
-                SimulatorReport failureReport = simulator_->failureReport();
-                if (output_cout) {
-                    std::ostringstream ss;
-                    ss << "\n\n================    End of simulation     ===============\n\n";
-                    ss << "Number of MPI processes: " << std::setw(6) << mpi_size_ << "\n";
+            if (output_cout) {
+                std::string msg;
+                msg = "\n\n================ Starting main simulation loop ===============\n";
+                OpmLog::info(msg);
+            }
+
+            PerformanceProfile::setEnabled(EWOMS_GET_PARAM(TypeTag, bool, EnablePerformanceProfile));
+            simulator_->init(*simtimer_);
+            return true;
+        }
+
+        // Finish the simulation after the last report step.
+        void runSimulatorFinalize_(bool output_cout)
+        {
+            const auto& ioConfig = eclState().getIOConfig();
+            SimulatorReport successReport = simulator_->finalize();
+            SimulatorReport failureReport = simulator_->failureReport();
+            ebosSimulator_->vanguard().reportLoadBalance(successReport.assemble_time + failureReport.assemble_time);
+            if (output_cout) {
+                std::ostringstream ss;
+                ss << "\n\n================    End of simulation     ===============\n\n";
+                ss << "Number of MPI processes: " << std::setw(6) << mpi_size_ << "\n";
 #if _OPENMP
-                    int threads = omp_get_max_threads();
+                int threads = omp_get_max_threads();
 #else
-                    int threads = 1;
+                int threads = 1;
 #endif
-                    ss << "Threads per MPI process:  " << std::setw(5) << threads << "\n";
-                    successReport.reportFullyImplicit(ss, &failureReport);
-                    OpmLog::info(ss.str());
-                }
-
-            } else {
-                if (output_cout) {
-                    std::cout << "\n\n================ Simulation turned off ===============\n" << std::flush;
-                }
+                ss << "Threads per MPI process:  " << std::setw(5) << threads << "\n";
+                successReport.reportFullyImplicit(ss, &failureReport);
+                OpmLog::info(ss.str());
+            }
 
+            if (PerformanceProfile::enabled()) {
+                const std::string profileFile = ioConfig.getOutputDir() + "/" + ioConfig.getBaseName() + ".PROFILE.json";
+                PerformanceProfile::report(Dune::MPIHelper::getCollectiveCommunication(), profileFile);
+                PerformanceProfile::setEnabled(false);
             }
         }
 
@@ -522,6 +633,23 @@ namespace Opm
             simulator_.reset(new Simulator(*ebosSimulator_));
         }
 
+        static void reportException_(const std::exception& e, bool output_cout)
+        {
+            std::ostringstream message;
+            message  << "Program threw an exception: " << e.what();
+
+            if (output_cout) {
+                // in some cases exceptions are thrown before the logging system is set
+                // up.
+                if (OpmLog::hasBackend("STREAMLOG")) {
+                    OpmLog::error(message.str());
+                }
+                else {
+                    std::cout << message.str() << "\n";
+                }
+            }
+        }
+
         static unsigned long long getTotalSystemMemory()
         {
             long pages = sysconf(_SC_PHYS_PAGES);
@@ -539,6 +667,8 @@ namespace Opm
         int  mpi_size_ = 1;
         boost::any parallel_information_;
         std::unique_ptr<Simulator> simulator_;
+        std::unique_ptr<SimulatorTimer> simtimer_;
+        bool stepsActive_ = false;
     };
 } // namespace Opm
 
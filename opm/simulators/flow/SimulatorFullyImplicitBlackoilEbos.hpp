@@ -28,21 +28,33 @@
 #include <opm/simulators/wells/WellStateFullyImplicitBlackoil.hpp>
 #include <opm/simulators/aquifers/BlackoilAquiferModel.hpp>
 #include <opm/simulators/utils/moduleVersion.hpp>
+#include <opm/simulators/utils/Checkpoint.hpp>
 #include <opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp>
 #include <opm/grid/utility/StopWatch.hpp>
 
 #include <opm/common/Exceptions.hpp>
 #include <opm/common/ErrorMacros.hpp>
 
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
 BEGIN_PROPERTIES
 
 NEW_PROP_TAG(EnableTerminalOutput);
 NEW_PROP_TAG(EnableAdaptiveTimeStepping);
 NEW_PROP_TAG(EnableTuning);
+NEW_PROP_TAG(CheckpointInterval);
+NEW_PROP_TAG(CheckpointFile);
+NEW_PROP_TAG(ResumeFromCheckpoint);
 
 SET_BOOL_PROP(EclFlowProblem, EnableTerminalOutput, true);
 SET_BOOL_PROP(EclFlowProblem, EnableAdaptiveTimeStepping, true);
 SET_BOOL_PROP(EclFlowProblem, EnableTuning, false);
+SET_SCALAR_PROP(EclFlowProblem, CheckpointInterval, 0.0);
+SET_STRING_PROP(EclFlowProblem, CheckpointFile, "");
+SET_BOOL_PROP(EclFlowProblem, ResumeFromCheckpoint, false);
 
 END_PROPERTIES
 
@@ -120,6 +132,12 @@ public:
                              "Use adaptive time stepping between report steps");
         EWOMS_REGISTER_PARAM(TypeTag, bool, EnableTuning,
                              "Honor some aspects of the TUNING keyword.");
+        EWOMS_REGISTER_PARAM(TypeTag, double, CheckpointInterval,
+                             "Wall clock time in seconds between two checkpoints written at the end of a report step. 0 disables checkpointing");
+        EWOMS_REGISTER_PARAM(TypeTag, std::string, CheckpointFile,
+                             "Base name of the checkpoint files. The default is the case name in the output directory");
+        EWOMS_REGISTER_PARAM(TypeTag, bool, ResumeFromCheckpoint,
+                             "Continue the simulation from the last checkpoint written by a run with the same deck and number of processes");
     }
 
     /// Run the simulation.
@@ -129,169 +147,213 @@ public:
     /// \param[in,out] state       state of reservoir: pressure, fluxes
     /// \return                    simulation report, with timing data
     SimulatorReport run(SimulatorTimer& timer)
+    {
+        init(timer);
+        while (!timer.done())
+            runStep(timer);
+        return finalize();
+    }
+
+    /// Prepare the simulation of the report steps governed by the timer.
+    /// run() is init() followed by runStep() until timer.done() is true and
+    /// finalize(). Calling these methods separately allows to inspect and
+    /// modify the simulator between two report steps.
+    void init(SimulatorTimer& timer)
     {
         failureReport_ = SimulatorReport();
+        report_ = SimulatorReport();
 
         ebosSimulator_.setEpisodeIndex(-1);
 
         // Create timers and file for writing timing info.
-        Opm::time::StopWatch solverTimer;
-        Opm::time::StopWatch totalTimer;
-        totalTimer.start();
+        totalTimer_.start();
 
         // adaptive time stepping
-        const auto& events = schedule().getEvents();
-        std::unique_ptr<TimeStepper > adaptiveTimeStepping;
+        adaptiveTimeStepping_.reset();
         bool enableAdaptive = EWOMS_GET_PARAM(TypeTag, bool, EnableAdaptiveTimeStepping);
         bool enableTUNING = EWOMS_GET_PARAM(TypeTag, bool, EnableTuning);
         if (enableAdaptive) {
             if (enableTUNING) {
-                adaptiveTimeStepping.reset(new TimeStepper(schedule().getTuning(timer.currentStepNum()), terminalOutput_));
+                adaptiveTimeStepping_.reset(new TimeStepper(schedule().getTuning(timer.currentStepNum()), terminalOutput_));
             }
             else {
-                adaptiveTimeStepping.reset(new TimeStepper(terminalOutput_));
+                adaptiveTimeStepping_.reset(new TimeStepper(terminalOutput_));
             }
 
             if (isRestart()) {
                 // For restarts the ebosSimulator may have gotten some information
                 // about the next timestep size from the OPMEXTRA field
-                adaptiveTimeStepping->setSuggestedNextStep(ebosSimulator_.timeStepSize());
+                adaptiveTimeStepping_->setSuggestedNextStep(ebosSimulator_.timeStepSize());
             }
         }
 
-        SimulatorReport report;
-        SimulatorReport stepReport;
-
-        // Main simulation loop.
-        while (!timer.done()) {
-            // Report timestep.
-            if (terminalOutput_) {
-                std::ostringstream ss;
-                timer.report(ss);
-                OpmLog::debug(ss.str());
-            }
-
-            if (terminalOutput_) {
-                std::ostringstream stepMsg;
-                boost::posix_time::time_facet* facet = new boost::posix_time::time_facet("%d-%b-%Y");
-                stepMsg.imbue(std::locale(std::locale::classic(), facet));
-                stepMsg << "\nReport step " << std::setw(2) <<timer.currentStepNum()
-                         << "/" << timer.numSteps()
-                         << " at day " << (double)unit::convert::to(timer.simulationTimeElapsed(), unit::day)
-                         << "/" << (double)unit::convert::to(timer.totalTime(), unit::day)
-                         << ", date = " << timer.currentDateTime();
-                OpmLog::info(stepMsg.str());
-            }
+        checkpointInterval_ = EWOMS_GET_PARAM(TypeTag, double, CheckpointInterval);
+        lastCheckpointTime_ = 0.0;
 
-            // write the inital state at the report stage
-            if (timer.initialStep()) {
-                Dune::Timer perfTimer;
-                perfTimer.start();
+        const bool resume = EWOMS_GET_PARAM(TypeTag, bool, ResumeFromCheckpoint);
+        if (resume || checkpointInterval_ > 0.0)
+            deckHash_ = computeDeckHash_();
 
-                ebosSimulator_.setEpisodeIndex(-1);
-                ebosSimulator_.setEpisodeLength(0.0);
-                ebosSimulator_.setTimeStepSize(0.0);
-
-                wellModel_().beginReportStep(timer.currentStepNum());
-                ebosSimulator_.problem().writeOutput();
+        if (resume)
+            resumeFromCheckpoint_(timer, adaptiveTimeStepping_.get());
+    }
 
-                report.output_write_time += perfTimer.stop();
-            }
+    /// Simulate the current report step of the timer and advance the timer
+    /// to the next one.
+    /// \return the report of the step
+    SimulatorReport runStep(SimulatorTimer& timer)
+    {
+        const auto& events = schedule().getEvents();
+        const bool enableTUNING = EWOMS_GET_PARAM(TypeTag, bool, EnableTuning);
+        SimulatorReport stepReport;
+        Opm::time::StopWatch solverTimer;
 
-            // Run a multiple steps of the solver depending on the time step control.
-            solverTimer.start();
-
-            auto solver = createSolver(wellModel_());
-
-            ebosSimulator_.startNextEpisode(ebosSimulator_.startTime() + schedule().getTimeMap().getTimePassedUntil(timer.currentStepNum()),
-                                            timer.currentStepLength());
-            ebosSimulator_.setEpisodeIndex(timer.currentStepNum());
-            solver->model().beginReportStep();
-
-            // If sub stepping is enabled allow the solver to sub cycle
-            // in case the report steps are too large for the solver to converge
-            //
-            // \Note: The report steps are met in any case
-            // \Note: The sub stepping will require a copy of the state variables
-            if (adaptiveTimeStepping) {
-                if (enableTUNING) {
-                    if (events.hasEvent(ScheduleEvents::TUNING_CHANGE,timer.currentStepNum())) {
-                        adaptiveTimeStepping->updateTUNING(schedule().getTuning(timer.currentStepNum()));
-                    }
-                }
+        // Report timestep.
+        if (terminalOutput_) {
+            std::ostringstream ss;
+            timer.report(ss);
+            OpmLog::debug(ss.str());
+        }
 
-                bool event = events.hasEvent(ScheduleEvents::NEW_WELL, timer.currentStepNum()) ||
-                        events.hasEvent(ScheduleEvents::PRODUCTION_UPDATE, timer.currentStepNum()) ||
-                        events.hasEvent(ScheduleEvents::INJECTION_UPDATE, timer.currentStepNum()) ||
-                        events.hasEvent(ScheduleEvents::WELL_STATUS_CHANGE, timer.currentStepNum());
-                stepReport = adaptiveTimeStepping->step(timer, *solver, event, nullptr);
-                report += stepReport;
-                failureReport_ += adaptiveTimeStepping->failureReport();
-            }
-            else {
-                // solve for complete report step
-                stepReport = solver->step(timer);
-                report += stepReport;
-                failureReport_ += solver->failureReport();
-
-                if (terminalOutput_) {
-                    std::ostringstream ss;
-                    stepReport.reportStep(ss);
-                    OpmLog::info(ss.str());
-                }
-            }
+        if (terminalOutput_) {
+            std::ostringstream stepMsg;
+            boost::posix_time::time_facet* facet = new boost::posix_time::time_facet("%d-%b-%Y");
+            stepMsg.imbue(std::locale(std::locale::classic(), facet));
+            stepMsg << "\nReport step " << std::setw(2) <<timer.currentStepNum()
+                     << "/" << timer.numSteps()
+                     << " at day " << (double)unit::convert::to(timer.simulationTimeElapsed(), unit::day)
+                     << "/" << (double)unit::convert::to(timer.totalTime(), unit::day)
+                     << ", date = " << timer.currentDateTime();
+            OpmLog::info(stepMsg.str());
+        }
 
-            // write simulation state at the report stage
+        // write the inital state at the report stage
+        if (timer.initialStep()) {
             Dune::Timer perfTimer;
             perfTimer.start();
-            const double nextstep = adaptiveTimeStepping ? adaptiveTimeStepping->suggestedNextStep() : -1.0;
-            ebosSimulator_.problem().setNextTimeStepSize(nextstep);
-            ebosSimulator_.problem().writeOutput();
-            report.output_write_time += perfTimer.stop();
 
-            solver->model().endReportStep();
+            ebosSimulator_.setEpisodeIndex(-1);
+            ebosSimulator_.setEpisodeLength(0.0);
+            ebosSimulator_.setTimeStepSize(0.0);
+
+            wellModel_().beginReportStep(timer.currentStepNum());
+            ebosSimulator_.problem().writeOutput();
 
-            // take time that was used to solve system for this reportStep
-            solverTimer.stop();
+            report_.output_write_time += perfTimer.stop();
+        }
 
-            // update timing.
-            report.solver_time += solverTimer.secsSinceStart();
+        // Run a multiple steps of the solver depending on the time step control.
+        solverTimer.start();
 
-            // Increment timer, remember well state.
-            ++timer;
+        auto solver = createSolver(wellModel_());
 
+        ebosSimulator_.startNextEpisode(ebosSimulator_.startTime() + schedule().getTimeMap().getTimePassedUntil(timer.currentStepNum()),
+                                        timer.currentStepLength());
+        ebosSimulator_.setEpisodeIndex(timer.currentStepNum());
+        solver->model().beginReportStep();
 
-            if (terminalOutput_) {
-                if (!timer.initialStep()) {
-                    const std::string version = moduleVersionName();
-                    outputTimestampFIP(timer, version);
+        // If sub stepping is enabled allow the solver to sub cycle
+        // in case the report steps are too large for the solver to converge
+        //
+        // \Note: The report steps are met in any case
+        // \Note: The sub stepping will require a copy of the state variables
+        if (adaptiveTimeStepping_) {
+            if (enableTUNING) {
+                if (events.hasEvent(ScheduleEvents::TUNING_CHANGE,timer.currentStepNum())) {
+                    adaptiveTimeStepping_->updateTUNING(schedule().getTuning(timer.currentStepNum()));
                 }
             }
 
+            bool event = events.hasEvent(ScheduleEvents::NEW_WELL, timer.currentStepNum()) ||
+                    events.hasEvent(ScheduleEvents::PRODUCTION_UPDATE, timer.currentStepNum()) ||
+                    events.hasEvent(ScheduleEvents::INJECTION_UPDATE, timer.currentStepNum()) ||
+                    events.hasEvent(ScheduleEvents::WELL_STATUS_CHANGE, timer.currentStepNum());
+            stepReport = adaptiveTimeStepping_->step(timer, *solver, event, nullptr);
+            report_ += stepReport;
+            failureReport_ += adaptiveTimeStepping_->failureReport();
+        }
+        else {
+            // solve for complete report step
+            stepReport = solver->step(timer);
+            report_ += stepReport;
+            failureReport_ += solver->failureReport();
+
             if (terminalOutput_) {
-                std::string msg =
-                    "Time step took " + std::to_string(solverTimer.secsSinceStart()) + " seconds; "
-                    "total solver time " + std::to_string(report.solver_time) + " seconds.";
-                OpmLog::debug(msg);
+                std::ostringstream ss;
+                stepReport.reportStep(ss);
+                OpmLog::info(ss.str());
+            }
+        }
+
+        // write simulation state at the report stage
+        Dune::Timer perfTimer;
+        perfTimer.start();
+        const double nextstep = adaptiveTimeStepping_ ? adaptiveTimeStepping_->suggestedNextStep() : -1.0;
+        ebosSimulator_.problem().setNextTimeStepSize(nextstep);
+        ebosSimulator_.problem().writeOutput();
+        report_.output_write_time += perfTimer.stop();
+
+        solver->model().endReportStep();
+
+        // take time that was used to solve system for this reportStep
+        solverTimer.stop();
+
+        // update timing.
+        report_.solver_time += solverTimer.secsSinceStart();
+
+        // Increment timer, remember well state.
+        ++timer;
+
+        // all processes must agree on writing a checkpoint, hence the
+        // decision is based on the largest elapsed wall clock time
+        if (checkpointInterval_ > 0.0 && !timer.done()) {
+            const double elapsed = grid().comm().max(totalTimer_.secsSinceStart());
+            if (elapsed - lastCheckpointTime_ >= checkpointInterval_) {
+                Dune::Timer checkpointTimer;
+                checkpointTimer.start();
+                writeCheckpoint_(timer, adaptiveTimeStepping_.get());
+                report_.output_write_time += checkpointTimer.stop();
+                lastCheckpointTime_ = elapsed;
             }
+        }
+
+        if (terminalOutput_) {
+            if (!timer.initialStep()) {
+                const std::string version = moduleVersionName();
+                outputTimestampFIP(timer, version);
+            }
+        }
 
+        if (terminalOutput_) {
+            std::string msg =
+                "Time step took " + std::to_string(solverTimer.secsSinceStart()) + " seconds; "
+                "total solver time " + std::to_string(report_.solver_time) + " seconds.";
+            OpmLog::debug(msg);
         }
 
+        return stepReport;
+    }
+
+    /// Finish the simulation after the last report step.
+    /// \return simulation report of all steps, with timing data
+    SimulatorReport finalize()
+    {
         // make sure all output is written to disk before run is finished
         {
             Dune::Timer finalOutputTimer;
             finalOutputTimer.start();
 
+            checkpoint_.wait();
             ebosSimulator_.problem().finalizeOutput();
-            report.output_write_time += finalOutputTimer.stop();
+            report_.output_write_time += finalOutputTimer.stop();
         }
 
         // Stop timer and create timing report
-        totalTimer.stop();
-        report.total_time = totalTimer.secsSinceStart();
-        report.converged = true;
+        totalTimer_.stop();
+        report_.total_time = totalTimer_.secsSinceStart();
+        report_.converged = true;
 
-        return report;
+        return report_;
     }
 
     /** \brief Returns the simulator report for the failed substeps of the simulation.
@@ -341,6 +403,145 @@ protected:
         return initconfig.restartRequested();
     }
 
+    std::string checkpointFileName_() const
+    {
+        std::string baseName = EWOMS_GET_PARAM(TypeTag, std::string, CheckpointFile);
+        if (baseName.empty()) {
+            const auto& ioConfig = eclState().getIOConfig();
+            baseName = ioConfig.getOutputDir() + "/" + ioConfig.getBaseName();
+        }
+        return baseName + "-" + std::to_string(grid().comm().rank()) + ".ckpt";
+    }
+
+    // Writes the state at the beginning of the current report step of the
+    // timer. The file is written in the background while the simulation
+    // continues.
+    void writeCheckpoint_(const SimulatorTimer& timer, TimeStepper* adaptiveTimeStepping)
+    {
+        const auto& comm = grid().comm();
+        auto& model = ebosSimulator_.model();
+        const auto& solution = model.solution(/*timeIdx=*/0);
+
+        checkpoint_.serializeBegin();
+
+        checkpoint_.serializeSectionBegin("Simulator");
+        auto& os = checkpoint_.serializeStream();
+        Checkpoint::write(os, comm.size());
+        Checkpoint::write(os, static_cast<std::uint64_t>(model.numGridDof()));
+        Checkpoint::write(os, deckHash_);
+        Checkpoint::write(os, timer.currentStepNum());
+        Checkpoint::write(os, ebosSimulator_.time());
+        Checkpoint::write(os, ebosSimulator_.vanguard().summaryState().serialize());
+        checkpoint_.serializeSectionEnd();
+
+        checkpoint_.serializeSectionBegin("Solution");
+        for (unsigned dofIdx = 0; dofIdx < solution.size(); ++dofIdx) {
+            const auto& priVars = solution[dofIdx];
+            for (unsigned eqIdx = 0; eqIdx < priVars.size(); ++eqIdx)
+                Checkpoint::write(os, priVars[eqIdx]);
+            Checkpoint::write(os, static_cast<int>(priVars.primaryVarsMeaning()));
+            Checkpoint::write(os, priVars.pvtRegionIndex());
+        }
+        checkpoint_.serializeSectionEnd();
+
+        ebosSimulator_.problem().serialize(checkpoint_);
+        if (adaptiveTimeStepping)
+            adaptiveTimeStepping->serialize(checkpoint_);
+
+        const std::string fileName = checkpointFileName_();
+        checkpoint_.serializeEnd(fileName);
+
+        if (terminalOutput_)
+            OpmLog::info("Writing checkpoint for report step " + std::to_string(timer.currentStepNum())
+                         + " to " + fileName);
+    }
+
+    // Restores the state written by writeCheckpoint_() and moves the timer to
+    // the report step at which the checkpoint was written.
+    void resumeFromCheckpoint_(SimulatorTimer& timer, TimeStepper* adaptiveTimeStepping)
+    {
+        const auto& comm = grid().comm();
+        auto& model = ebosSimulator_.model();
+        const std::string fileName = checkpointFileName_();
+
+        CheckpointFile checkpoint;
+        checkpoint.deserializeBegin(fileName);
+
+        checkpoint.deserializeSectionBegin("Simulator");
+        auto& is = checkpoint.deserializeStream();
+        int numProcs;
+        std::uint64_t numGridDof;
+        std::uint64_t deckHash;
+        int reportStep;
+        double time;
+        std::vector<char> summaryBuffer;
+        Checkpoint::read(is, numProcs);
+        Checkpoint::read(is, numGridDof);
+        Checkpoint::read(is, deckHash);
+        Checkpoint::read(is, reportStep);
+        Checkpoint::read(is, time);
+        Checkpoint::read(is, summaryBuffer);
+        checkpoint.deserializeSectionEnd();
+
+        // all processes must give up if the checkpoint of one of them does not
+        // fit, otherwise the others would wait for it in the next collective
+        // operation
+        const bool compatible =
+            numProcs == comm.size()
+            && numGridDof == model.numGridDof()
+            && deckHash == deckHash_;
+        if (comm.min(static_cast<int>(compatible)) == 0)
+            OPM_THROW(std::runtime_error, "Checkpoint " << fileName << " or the one of another process"
+                      << " was written for a different deck, number of processes or grid");
+
+        // every process renames its file on its own, so a run which was
+        // interrupted while writing a checkpoint may have left files of
+        // different report steps behind
+        if (comm.min(reportStep) != comm.max(reportStep) || comm.min(time) != comm.max(time))
+            OPM_THROW(std::runtime_error, "The checkpoint files of the processes were written at different"
+                      " report steps, probably because writing the last checkpoint was interrupted");
+
+        timer.setCurrentStepNum(reportStep);
+        ebosSimulator_.setTime(time);
+        ebosSimulator_.setEpisodeIndex(reportStep);
+        ebosSimulator_.vanguard().summaryState().deserialize(summaryBuffer);
+
+        checkpoint.deserializeSectionBegin("Solution");
+        auto& solution = model.solution(/*timeIdx=*/0);
+        for (unsigned dofIdx = 0; dofIdx < solution.size(); ++dofIdx) {
+            auto& priVars = solution[dofIdx];
+            for (unsigned eqIdx = 0; eqIdx < priVars.size(); ++eqIdx)
+                Checkpoint::read(is, priVars[eqIdx]);
+            int meaning;
+            Checkpoint::read(is, meaning);
+            priVars.setPrimaryVarsMeaning(static_cast<typename PrimaryVariables::PrimaryVarsMeaning>(meaning));
+            unsigned pvtRegionIdx;
+            Checkpoint::read(is, pvtRegionIdx);
+            priVars.setPvtRegionIndex(pvtRegionIdx);
+        }
+        checkpoint.deserializeSectionEnd();
+        model.solution(/*timeIdx=*/1) = solution;
+
+        ebosSimulator_.problem().deserializeState(checkpoint);
+        if (adaptiveTimeStepping)
+            adaptiveTimeStepping->deserialize(checkpoint);
+
+        checkpoint.deserializeEnd();
+
+        if (terminalOutput_)
+            OpmLog::info("Resuming from checkpoint " + fileName + " at report step " + std::to_string(reportStep));
+    }
+
+    // A hash of the textual representation of the parsed deck. It
+    // distinguishes all changes of the input which matter for the
+    // simulation, but not the ones of formatting or comments.
+    std::uint64_t computeDeckHash_() const
+    {
+        std::ostringstream os;
+        os << ebosSimulator_.vanguard().deck();
+        return Checkpoint::hash(os.str());
+    }
+
     WellModel& wellModel_()
     { return ebosSimulator_.problem().wellModel(); }
 
@@ -359,6 +560,15 @@ protected:
     PhaseUsage phaseUsage_;
     // Misc. data
     bool terminalOutput_;
+    CheckpointFile checkpoint_;
+
+    // state of a run between init() and finalize()
+    std::unique_ptr<TimeStepper> adaptiveTimeStepping_;
+    Opm::time::StopWatch totalTimer_;
+    SimulatorReport report_;
+    double checkpointInterval_ = 0.0;
+    double lastCheckpointTime_ = 0.0;
+    std::uint64_t deckHash_ = 0;
 };
 
 } // namespace Opm
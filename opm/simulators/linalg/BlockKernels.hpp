@@ -0,0 +1,474 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_BLOCK_KERNELS_HEADER_INCLUDED
+#define OPM_BLOCK_KERNELS_HEADER_INCLUDED
+
+#include <opm/simulators/linalg/MatrixBlock.hpp>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+// The SIMD kernels use the GCC/Clang vector extensions, restricted to the
+// vector registers of the target so that no vector is split or passed
+// in memory. Other compilers (or -DOPM_BLOCK_KERNELS_NO_SIMD) get the scalar
+// loops, which have compile-time trip counts and are unrolled by the compiler.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(OPM_BLOCK_KERNELS_NO_SIMD)
+#  if defined(__AVX512F__)
+#    define OPM_BLOCK_KERNELS_SIMD_BYTES 64
+#  elif defined(__AVX__)
+#    define OPM_BLOCK_KERNELS_SIMD_BYTES 32
+#  elif defined(__SSE2__) || defined(__ARM_NEON)
+#    define OPM_BLOCK_KERNELS_SIMD_BYTES 16
+#  else
+#    define OPM_BLOCK_KERNELS_SIMD_BYTES 0
+#  endif
+#else
+#  define OPM_BLOCK_KERNELS_SIMD_BYTES 0
+#endif
+
+namespace Opm
+{
+
+/// Compile-time specialized kernels for the small square blocks of the
+/// reservoir Jacobian (block sizes 1 to 6 depending on the model).
+///
+/// All functions take Dune::FieldMatrix / Dune::FieldVector arguments, so
+/// they accept MatrixBlock as well. Blocks whose size fits a vector
+/// register (2, 4 and 8 lanes, smaller sizes padded to the next one) use
+/// compiler vector types, everything else uses plain loops.
+namespace BlockKernels
+{
+
+namespace detail
+{
+    //! number of SIMD lanes used for a block of size n
+    constexpr int simdWidth(int n)
+    {
+        return n <= 2 ? 2 : (n <= 4 ? 4 : 8);
+    }
+
+    template <class K, int width>
+    struct SimdRegister
+    {
+        static constexpr bool available = false;
+    };
+
+#if OPM_BLOCK_KERNELS_SIMD_BYTES >= 16
+    template <>
+    struct SimdRegister<double, 2>
+    {
+        typedef double type __attribute__((vector_size(2*sizeof(double))));
+        static constexpr bool available = true;
+    };
+
+    template <>
+    struct SimdRegister<float, 4>
+    {
+        typedef float type __attribute__((vector_size(4*sizeof(float))));
+        static constexpr bool available = true;
+    };
+#endif
+
+#if OPM_BLOCK_KERNELS_SIMD_BYTES >= 32
+    template <>
+    struct SimdRegister<double, 4>
+    {
+        typedef double type __attribute__((vector_size(4*sizeof(double))));
+        static constexpr bool available = true;
+    };
+
+    template <>
+    struct SimdRegister<float, 8>
+    {
+        typedef float type __attribute__((vector_size(8*sizeof(float))));
+        static constexpr bool available = true;
+    };
+#endif
+
+#if OPM_BLOCK_KERNELS_SIMD_BYTES >= 64
+    template <>
+    struct SimdRegister<double, 8>
+    {
+        typedef double type __attribute__((vector_size(8*sizeof(double))));
+        static constexpr bool available = true;
+    };
+#endif
+
+    //! pivot indices of an LU factorization. The size is not deduced from
+    //! this type since std::array uses std::size_t for it.
+    template <int n>
+    struct Pivots
+    {
+        typedef std::array<int, n> type;
+    };
+
+    template <class K, int n>
+    struct UseSimd
+    {
+        static constexpr bool value = n > 1 && n <= 8 && SimdRegister<K, simdWidth(n)>::available;
+    };
+
+    //! scalar kernels, used for 1x1 blocks and when no vector type is available
+    template <class K, int n, bool simd = UseSimd<K, n>::value>
+    struct SquareKernels
+    {
+        typedef Dune::FieldMatrix<K, n, n> Block;
+        typedef Dune::FieldVector<K, n> Vector;
+
+        static void mv(const Block& A, const Vector& x, Vector& y)
+        {
+            for (int i = 0; i < n; ++i) {
+                K sum = 0.0;
+                for (int j = 0; j < n; ++j)
+                    sum += A[i][j] * x[j];
+                y[i] = sum;
+            }
+        }
+
+        static void umv(const Block& A, const Vector& x, Vector& y)
+        {
+            for (int i = 0; i < n; ++i)
+                for (int j = 0; j < n; ++j)
+                    y[i] += A[i][j] * x[j];
+        }
+
+        static void usmv(const K alpha, const Block& A, const Vector& x, Vector& y)
+        {
+            for (int i = 0; i < n; ++i) {
+                K sum = 0.0;
+                for (int j = 0; j < n; ++j)
+                    sum += A[i][j] * x[j];
+                y[i] += alpha * sum;
+            }
+        }
+
+        static void mmv(const Block& A, const Vector& x, Vector& y)
+        {
+            for (int i = 0; i < n; ++i)
+                for (int j = 0; j < n; ++j)
+                    y[i] -= A[i][j] * x[j];
+        }
+
+        static void multiply(const Block& A, const Block& B, Block& C)
+        {
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    K sum = 0.0;
+                    for (int k = 0; k < n; ++k)
+                        sum += A[i][k] * B[k][j];
+                    C[i][j] = sum;
+                }
+            }
+        }
+
+        static void multiplySubtract(const Block& A, const Block& B, Block& C)
+        {
+            for (int i = 0; i < n; ++i)
+                for (int k = 0; k < n; ++k)
+                    for (int j = 0; j < n; ++j)
+                        C[i][j] -= A[i][k] * B[k][j];
+        }
+    };
+
+#if OPM_BLOCK_KERNELS_SIMD_BYTES > 0
+    //! kernels operating on whole rows/columns held in a vector register
+    template <class K, int n>
+    struct SquareKernels<K, n, true>
+    {
+        typedef Dune::FieldMatrix<K, n, n> Block;
+        typedef Dune::FieldVector<K, n> Vector;
+        static constexpr int width = simdWidth(n);
+        typedef typename SimdRegister<K, width>::type Reg;
+
+        // the element-wise loops are turned into (masked) vector loads and
+        // stores by the compiler, the padding lanes stay zero.
+        template <class Row>
+        static Reg load(const Row& row)
+        {
+            Reg r = {};
+            for (int i = 0; i < n; ++i)
+                r[i] = row[i];
+            return r;
+        }
+
+        template <class Row>
+        static void store(const Reg& r, Row& row)
+        {
+            for (int i = 0; i < n; ++i)
+                row[i] = r[i];
+        }
+
+        static Reg column(const Block& A, int j)
+        {
+            Reg c = {};
+            for (int i = 0; i < n; ++i)
+                c[i] = A[i][j];
+            return c;
+        }
+
+        //! A*x accumulated column by column: sum_j A[:, j] * x[j]
+        static Reg product(const Block& A, const Vector& x)
+        {
+            Reg acc = column(A, 0) * x[0];
+            for (int j = 1; j < n; ++j)
+                acc += column(A, j) * x[j];
+            return acc;
+        }
+
+        static void mv(const Block& A, const Vector& x, Vector& y)
+        {
+            store(product(A, x), y);
+        }
+
+        static void umv(const Block& A, const Vector& x, Vector& y)
+        {
+            store(load(y) + product(A, x), y);
+        }
+
+        static void usmv(const K alpha, const Block& A, const Vector& x, Vector& y)
+        {
+            store(load(y) + alpha * product(A, x), y);
+        }
+
+        static void mmv(const Block& A, const Vector& x, Vector& y)
+        {
+            store(load(y) - product(A, x), y);
+        }
+
+        //! row i of A*B is sum_k A[i][k] * B[k, :], i.e. whole rows of B are combined
+        static void multiply(const Block& A, const Block& B, Block& C)
+        {
+            std::array<Reg, n> rowsB;
+            for (int k = 0; k < n; ++k)
+                rowsB[k] = load(B[k]);
+
+            for (int i = 0; i < n; ++i) {
+                Reg acc = rowsB[0] * A[i][0];
+                for (int k = 1; k < n; ++k)
+                    acc += rowsB[k] * A[i][k];
+                store(acc, C[i]);
+            }
+        }
+
+        static void multiplySubtract(const Block& A, const Block& B, Block& C)
+        {
+            std::array<Reg, n> rowsB;
+            for (int k = 0; k < n; ++k)
+                rowsB[k] = load(B[k]);
+
+            for (int i = 0; i < n; ++i) {
+                Reg acc = load(C[i]);
+                for (int k = 0; k < n; ++k)
+                    acc -= rowsB[k] * A[i][k];
+                store(acc, C[i]);
+            }
+        }
+    };
+#endif
+
+} // namespace detail
+
+/// \brief y = A x
+template <class K, int n>
+inline void mv(const Dune::FieldMatrix<K, n, n>& A, const Dune::FieldVector<K, n>& x, Dune::FieldVector<K, n>& y)
+{
+    detail::SquareKernels<K, n>::mv(A, x, y);
+}
+
+/// \brief y += A x
+template <class K, int n>
+inline void umv(const Dune::FieldMatrix<K, n, n>& A, const Dune::FieldVector<K, n>& x, Dune::FieldVector<K, n>& y)
+{
+    detail::SquareKernels<K, n>::umv(A, x, y);
+}
+
+/// \brief y += alpha A x
+template <class K, int n>
+inline void usmv(const K alpha, const Dune::FieldMatrix<K, n, n>& A, const Dune::FieldVector<K, n>& x, Dune::FieldVector<K, n>& y)
+{
+    detail::SquareKernels<K, n>::usmv(alpha, A, x, y);
+}
+
+/// \brief y -= A x
+template <class K, int n>
+inline void mmv(const Dune::FieldMatrix<K, n, n>& A, const Dune::FieldVector<K, n>& x, Dune::FieldVector<K, n>& y)
+{
+    detail::SquareKernels<K, n>::mmv(A, x, y);
+}
+
+/// \brief C = A B. C must not alias A or B.
+template <class K, int n>
+inline void multiply(const Dune::FieldMatrix<K, n, n>& A, const Dune::FieldMatrix<K, n, n>& B, Dune::FieldMatrix<K, n, n>& C)
+{
+    detail::SquareKernels<K, n>::multiply(A, B, C);
+}
+
+/// \brief C -= A B. C must not alias A or B.
+template <class K, int n>
+inline void multiplySubtract(const Dune::FieldMatrix<K, n, n>& A, const Dune::FieldMatrix<K, n, n>& B, Dune::FieldMatrix<K, n, n>& C)
+{
+    detail::SquareKernels<K, n>::multiplySubtract(A, B, C);
+}
+
+/// \brief A = A B
+template <class K, int n>
+inline void rightmultiply(Dune::FieldMatrix<K, n, n>& A, const Dune::FieldMatrix<K, n, n>& B)
+{
+    Dune::FieldMatrix<K, n, n> C;
+    multiply(A, B, C);
+    A = C;
+}
+
+/// \brief LU factorization with partial pivoting in place.
+///
+/// Throws Dune::FMatrixError if the block is singular.
+template <class K, int n>
+inline void luFactor(Dune::FieldMatrix<K, n, n>& A, typename detail::Pivots<n>::type& piv)
+{
+    for (int k = 0; k < n; ++k) {
+        int p = k;
+        K maxAbs = std::abs(A[k][k]);
+        for (int i = k + 1; i < n; ++i) {
+            if (std::abs(A[i][k]) > maxAbs) {
+                maxAbs = std::abs(A[i][k]);
+                p = i;
+            }
+        }
+        if (maxAbs < 1e-40)
+            DUNE_THROW(Dune::FMatrixError, "matrix is singular");
+
+        piv[k] = p;
+        if (p != k)
+            std::swap(A[k], A[p]);
+
+        const K invPivot = 1.0 / A[k][k];
+        for (int i = k + 1; i < n; ++i) {
+            A[i][k] *= invPivot;
+            const K l = A[i][k];
+            for (int j = k + 1; j < n; ++j)
+                A[i][j] -= l * A[k][j];
+        }
+    }
+}
+
+/// \brief Solve LU x = b in place, using the result of luFactor().
+template <class K, int n>
+inline void luSolve(const Dune::FieldMatrix<K, n, n>& LU, const typename detail::Pivots<n>::type& piv, Dune::FieldVector<K, n>& b)
+{
+    for (int k = 0; k < n; ++k) {
+        if (piv[k] != k)
+            std::swap(b[k], b[piv[k]]);
+    }
+    // forward substitution, L has unit diagonal
+    for (int i = 1; i < n; ++i)
+        for (int j = 0; j < i; ++j)
+            b[i] -= LU[i][j] * b[j];
+    // backward substitution
+    for (int i = n - 1; i >= 0; --i) {
+        for (int j = i + 1; j < n; ++j)
+            b[i] -= LU[i][j] * b[j];
+        b[i] /= LU[i][i];
+    }
+}
+
+namespace detail
+{
+    //! inversion through an LU factorization, for blocks without closed form
+    template <class K, int n>
+    void luInvert(Dune::FieldMatrix<K, n, n>& A)
+    {
+        std::array<int, n> piv;
+        luFactor(A, piv);
+
+        Dune::FieldMatrix<K, n, n> inverse(0.0);
+        for (int j = 0; j < n; ++j) {
+            Dune::FieldVector<K, n> e(0.0);
+            e[j] = 1.0;
+            luSolve(A, piv, e);
+            for (int i = 0; i < n; ++i)
+                inverse[i][j] = e[i];
+        }
+        A = inverse;
+    }
+
+    template <class K, int n>
+    void invert(Dune::FieldMatrix<K, n, n>& A, std::true_type /* closed form */)
+    {
+        // the closed forms do not detect singular blocks. the determinant is
+        // compared to the product of the row norms, which bounds it
+        K scale = 1.0;
+        for (int i = 0; i < n; ++i)
+            scale *= A[i].infinity_norm();
+        if (!(std::abs(A.determinant()) > 1e-40 * scale))
+            DUNE_THROW(Dune::FMatrixError, "matrix is singular");
+
+        Dune::ISTLUtility::invertMatrix(A);
+    }
+
+    template <class K, int n>
+    void invert(Dune::FieldMatrix<K, n, n>& A, std::false_type /* closed form */)
+    {
+        luInvert(A);
+    }
+} // namespace detail
+
+/// \brief Invert a block in place.
+///
+/// Blocks up to 4x4 use the closed forms of ISTLUtility::invertMatrix,
+/// larger blocks an LU factorization with partial pivoting. Both throw
+/// Dune::FMatrixError for singular blocks like FieldMatrix::invert().
+template <class K, int n>
+inline void invert(Dune::FieldMatrix<K, n, n>& A)
+{
+    detail::invert(A, std::integral_constant<bool, (n <= 4)>());
+}
+
+/// \brief y = A x for a BCRS matrix of square blocks.
+template <class Matrix, class X, class Y>
+void spmv(const Matrix& A, const X& x, Y& y)
+{
+    for (auto row = A.begin(), rowEnd = A.end(); row != rowEnd; ++row) {
+        auto& yi = y[row.index()];
+        yi = 0.0;
+        for (auto col = row->begin(), colEnd = row->end(); col != colEnd; ++col)
+            umv(*col, x[col.index()], yi);
+    }
+}
+
+/// \brief y += alpha A x for a BCRS matrix of square blocks.
+template <class Matrix, class X, class Y, class K>
+void spusmv(const K alpha, const Matrix& A, const X& x, Y& y)
+{
+    for (auto row = A.begin(), rowEnd = A.end(); row != rowEnd; ++row) {
+        typename Y::block_type sum(0.0);
+        for (auto col = row->begin(), colEnd = row->end(); col != colEnd; ++col)
+            umv(*col, x[col.index()], sum);
+        y[row.index()].axpy(alpha, sum);
+    }
+}
+
+} // namespace BlockKernels
+} // namespace Opm
+
+#endif // OPM_BLOCK_KERNELS_HEADER_INCLUDED
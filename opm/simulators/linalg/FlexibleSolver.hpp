@@ -21,6 +21,7 @@
 #ifndef OPM_FLEXIBLE_SOLVER_HEADER_INCLUDED
 #define OPM_FLEXIBLE_SOLVER_HEADER_INCLUDED
 
+#include <opm/simulators/linalg/KrylovSolvers.hpp>
 #include <opm/simulators/linalg/PreconditionerFactory.hpp>
 
 #include <dune/common/fmatrix.hh>
@@ -98,6 +99,9 @@ private:
         preconditioner_
             = Opm::PreconditionerFactory<ParOperatorType, Comm>::create(*linop, prm.get_child("preconditioner"), comm);
         scalarproduct_ = Dune::createScalarProduct<VectorType, Comm>(comm, linearoperator_->category());
+#if HAVE_MPI
+        reduction_ = std::make_shared<Opm::ParallelFusedReduction<VectorType, Comm>>(comm);
+#endif
     }
 
     void initOpPrecSp(const MatrixType& matrix, const boost::property_tree::ptree& prm, const Dune::Amg::SequentialInformation&)
@@ -108,6 +112,7 @@ private:
         linearoperator_ = linop;
         preconditioner_ = Opm::PreconditionerFactory<SeqOperatorType>::create(*linop, prm.get_child("preconditioner"));
         scalarproduct_ = std::make_shared<Dune::SeqScalarProduct<VectorType>>();
+        reduction_ = std::make_shared<Opm::FusedReduction<VectorType>>();
     }
 
     void initSolver(const boost::property_tree::ptree& prm)
@@ -139,6 +144,22 @@ private:
                                                                         restart, // desired residual reduction factor
                                                                         maxiter, // maximum number of iterations
                                                                         verbosity));
+        } else if (solver_type == "pipelined_bicgstab") {
+            linsolver_.reset(new Opm::PipelinedBiCGSTABSolver<VectorType>(*linearoperator_,
+                                                                          reduction_,
+                                                                          *preconditioner_,
+                                                                          tol,
+                                                                          maxiter,
+                                                                          verbosity));
+        } else if (solver_type == "fgmres") {
+            int restart = prm.get<int>("restart");
+            linsolver_.reset(new Opm::FlexibleGMResSolver<VectorType>(*linearoperator_,
+                                                                      reduction_,
+                                                                      *preconditioner_,
+                                                                      tol,
+                                                                      restart,
+                                                                      maxiter,
+                                                                      verbosity));
 #if HAVE_SUITESPARSE_UMFPACK
         } else if (solver_type == "umfpack") {
             bool dummy = false;
@@ -164,6 +185,9 @@ private:
     std::shared_ptr<AbstractOperatorType> linearoperator_;
     std::shared_ptr<AbstractPrecondType> preconditioner_;
     std::shared_ptr<AbstractScalarProductType> scalarproduct_;
+    // Scalar products with one global reduction per call, used by the
+    // pipelined and flexible solvers.
+    std::shared_ptr<Opm::FusedReduction<VectorType>> reduction_;
     std::shared_ptr<AbstractSolverType> linsolver_;
 };
 
@@ -68,6 +68,8 @@ NEW_PROP_TAG(CprEllSolvetype);
 NEW_PROP_TAG(CprReuseSetup);
 NEW_PROP_TAG(LinearSolverConfigurationJsonFile);
 NEW_PROP_TAG(UseGpu);
+NEW_PROP_TAG(LinearSystemDumpDirectory);
+NEW_PROP_TAG(LinearSystemDumpCount);
 
 SET_SCALAR_PROP(FlowIstlSolverParams, LinearSolverReduction, 1e-2);
 SET_SCALAR_PROP(FlowIstlSolverParams, IluRelaxation, 0.9);
@@ -94,6 +96,8 @@ SET_INT_PROP(FlowIstlSolverParams, CprEllSolvetype, 0);
 SET_INT_PROP(FlowIstlSolverParams, CprReuseSetup, 0);
 SET_STRING_PROP(FlowIstlSolverParams, LinearSolverConfigurationJsonFile, "none");
 SET_BOOL_PROP(FlowIstlSolverParams, UseGpu, false);
+SET_STRING_PROP(FlowIstlSolverParams, LinearSystemDumpDirectory, "");
+SET_INT_PROP(FlowIstlSolverParams, LinearSystemDumpCount, 1);
 
 
 
@@ -166,6 +170,8 @@ namespace Opm
         bool scale_linear_system_;
         std::string linear_solver_configuration_json_file_;
         bool use_gpu_;
+        std::string linear_system_dump_directory_;
+        int linear_system_dump_count_;
 
         template <class TypeTag>
         void init()
@@ -194,6 +200,8 @@ namespace Opm
             cpr_reuse_setup_  =  EWOMS_GET_PARAM(TypeTag, int, CprReuseSetup);
             linear_solver_configuration_json_file_ = EWOMS_GET_PARAM(TypeTag, std::string, LinearSolverConfigurationJsonFile);
             use_gpu_ = EWOMS_GET_PARAM(TypeTag, bool, UseGpu);
+            linear_system_dump_directory_ = EWOMS_GET_PARAM(TypeTag, std::string, LinearSystemDumpDirectory);
+            linear_system_dump_count_ = EWOMS_GET_PARAM(TypeTag, int, LinearSystemDumpCount);
         }
 
         template <class TypeTag>
@@ -222,6 +230,8 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, int, CprReuseSetup, "Reuse Amg Setup");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, LinearSolverConfigurationJsonFile, "Filename of JSON configuration for flexible linear solver system.");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseGpu, "Use GPU cusparseSolver as the linear solver");
+            EWOMS_REGISTER_PARAM(TypeTag, std::string, LinearSystemDumpDirectory, "Directory to which the linear systems are dumped for replaying them with linearsolver_benchmark. No systems are dumped if empty");
+            EWOMS_REGISTER_PARAM(TypeTag, int, LinearSystemDumpCount, "The number of linear systems to dump, starting with the first one");
         }
 
         FlowLinearSolverParameters() { reset(); }
@@ -244,6 +254,7 @@ namespace Opm
             ilu_redblack_             = false;
             ilu_reorder_sphere_       = true;
             use_gpu_                  = false;
+            linear_system_dump_count_ = 1;
         }
     };
 
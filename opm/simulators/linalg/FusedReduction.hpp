@@ -0,0 +1,151 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_FUSEDREDUCTION_HEADER_INCLUDED
+#define OPM_FUSEDREDUCTION_HEADER_INCLUDED
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#if HAVE_MPI
+#include <dune/istl/owneroverlapcopy.hh>
+#include <mpi.h>
+#endif
+
+namespace Opm
+{
+
+    /// Computes several scalar products of distributed vectors with a
+    /// single global reduction.
+    ///
+    /// The Dune scalar products perform one allreduce per product, which
+    /// dominates the cost of an iteration of a Krylov solver on many
+    /// processes. Here the local parts of all products needed at one point
+    /// of an algorithm are summed in one allreduce. In parallel runs the
+    /// reduction is nonblocking, such that the solver can apply the operator
+    /// and the preconditioner between start() and wait().
+    template <class X>
+    class FusedReduction
+    {
+    public:
+        typedef std::pair<const X*, const X*> DotPair;
+
+        virtual ~FusedReduction() = default;
+
+        /// Start the computation of the products (x, y) of the given pairs.
+        /// The results are written to result by wait(), which must be
+        /// called before the next start().
+        void start(std::initializer_list<DotPair> dots, double* result)
+        {
+            start_(dots.begin(), dots.end(), result);
+        }
+
+        void start(const std::vector<DotPair>& dots, double* result)
+        {
+            start_(dots.begin(), dots.end(), result);
+        }
+
+        /// Wait for the products requested by the last start().
+        virtual void wait()
+        {
+        }
+
+        /// The number of reductions started.
+        long long numReductions() const
+        { return numReductions_; }
+
+    protected:
+        virtual double localDot_(const X& x, const X& y) const
+        {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < x.size(); ++i) {
+                sum += x[i] * y[i];
+            }
+            return sum;
+        }
+
+        virtual void startSum_(double* /* values */, int /* n */)
+        {
+        }
+
+    private:
+        template <class Iterator>
+        void start_(Iterator begin, Iterator end, double* result)
+        {
+            int n = 0;
+            for (auto dot = begin; dot != end; ++dot) {
+                result[n++] = localDot_(*dot->first, *dot->second);
+            }
+            ++numReductions_;
+            startSum_(result, n);
+        }
+
+        long long numReductions_ = 0;
+    };
+
+#if HAVE_MPI
+    /// Fused reduction for vectors distributed according to an
+    /// OwnerOverlapCopyCommunication. Only the rows owned by a process
+    /// contribute to its local products, as for the Dune scalar product.
+    template <class X, class Comm>
+    class ParallelFusedReduction : public FusedReduction<X>
+    {
+    public:
+        explicit ParallelFusedReduction(const Comm& comm)
+            : comm_(comm.communicator())
+        {
+            for (const auto& idx : comm.indexSet()) {
+                if (idx.local().attribute() != Dune::OwnerOverlapCopyAttributeSet::owner) {
+                    notOwned_.push_back(idx.local().local());
+                }
+            }
+        }
+
+        virtual void wait() override
+        {
+            if (request_ != MPI_REQUEST_NULL) {
+                MPI_Wait(&request_, MPI_STATUS_IGNORE);
+            }
+        }
+
+    protected:
+        virtual double localDot_(const X& x, const X& y) const override
+        {
+            double sum = FusedReduction<X>::localDot_(x, y);
+            for (const auto i : notOwned_) {
+                sum -= x[i] * y[i];
+            }
+            return sum;
+        }
+
+        virtual void startSum_(double* values, int n) override
+        {
+            MPI_Iallreduce(MPI_IN_PLACE, values, n, MPI_DOUBLE, MPI_SUM, comm_, &request_);
+        }
+
+    private:
+        MPI_Comm comm_;
+        MPI_Request request_ = MPI_REQUEST_NULL;
+        std::vector<std::size_t> notOwned_;
+    };
+#endif
+
+} // namespace Opm
+
+#endif // OPM_FUSEDREDUCTION_HEADER_INCLUDED
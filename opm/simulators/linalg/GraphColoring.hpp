@@ -26,6 +26,8 @@
 #include <numeric>
 #include <queue>
 #include <cstddef>
+#include <limits>
+#include <utility>
 
 namespace Opm
 {
@@ -241,5 +243,91 @@ reorderVerticesSpheres(const std::vector<int>& colors, int noColors,
     }
     return indices;
 }
+
+/// \brief Compute the strongly connected components of a directed graph.
+///
+/// It uses a non-recursive variant of the algorithm of Tarjan. An edge
+/// from u to v means that u depends on v, e.g. that v is upwind of u.
+/// \param graph The graph. Must adhere to the graph interface of dune-istl.
+/// \return A pair of the vertices ordered by component and the offsets of the
+///         components in this vector, including the end of the last one. A
+///         component never depends on one following it.
+template<class Graph>
+std::pair<std::vector<typename Graph::VertexDescriptor>, std::vector<std::size_t> >
+stronglyConnectedComponents(const Graph& graph)
+{
+    using Vertex = typename Graph::VertexDescriptor;
+    using EdgeIterator = typename Graph::ConstEdgeIterator;
+    const auto noVertices = graph.maxVertex() + 1;
+    const auto notVisitedTag = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> indices(noVertices, notVisitedTag);
+    std::vector<std::size_t> lowLinks(noVertices, 0);
+    std::vector<char> onStack(noVertices, false);
+    std::vector<Vertex> stack;
+    std::vector<std::pair<Vertex, EdgeIterator> > callStack;
+    std::size_t nextIndex = 0;
+
+    std::vector<Vertex> vertices;
+    vertices.reserve(noVertices);
+    std::vector<std::size_t> offsets(1, 0);
+
+    auto visit = [&](Vertex vertex)
+        {
+            indices[vertex] = lowLinks[vertex] = nextIndex++;
+            stack.push_back(vertex);
+            onStack[vertex] = true;
+            callStack.emplace_back(vertex, graph.beginEdges(vertex));
+        };
+
+    for(const auto& root: graph)
+    {
+        if ( indices[root] != notVisitedTag )
+        {
+            continue;
+        }
+        visit(root);
+
+        while( !callStack.empty() )
+        {
+            const Vertex current = callStack.back().first;
+            auto& edge = callStack.back().second;
+            if ( edge != graph.endEdges(current) )
+            {
+                const Vertex target = edge.target();
+                ++edge;
+                if ( indices[target] == notVisitedTag )
+                {
+                    visit(target);
+                }
+                else if ( onStack[target] )
+                {
+                    lowLinks[current] = std::min(lowLinks[current], indices[target]);
+                }
+                continue;
+            }
+
+            // all dependencies of current are done
+            callStack.pop_back();
+            if ( lowLinks[current] == indices[current] )
+            {
+                Vertex vertex;
+                do
+                {
+                    vertex = stack.back();
+                    stack.pop_back();
+                    onStack[vertex] = false;
+                    vertices.push_back(vertex);
+                } while ( vertex != current );
+                offsets.push_back(vertices.size());
+            }
+            if ( !callStack.empty() )
+            {
+                const Vertex caller = callStack.back().first;
+                lowLinks[caller] = std::min(lowLinks[caller], lowLinks[current]);
+            }
+        }
+    }
+    return std::make_pair(vertices, offsets);
+}
 } // end namespace Opm
 #endif
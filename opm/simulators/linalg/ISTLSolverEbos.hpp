@@ -22,12 +22,14 @@
 #define OPM_ISTLSOLVER_EBOS_HEADER_INCLUDED
 
 #include <opm/simulators/linalg/MatrixBlock.hpp>
+#include <opm/simulators/linalg/BlockKernels.hpp>
 #include <opm/simulators/linalg/BlackoilAmg.hpp>
 #include <opm/simulators/linalg/CPRPreconditioner.hpp>
 #include <opm/simulators/linalg/ParallelRestrictedAdditiveSchwarz.hpp>
 #include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
 #include <opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp>
 #include <opm/simulators/linalg/findOverlapRowsAndColumns.hpp>
+#include <opm/simulators/linalg/LinearSystemDump.hpp>
 #include <opm/common/Exceptions.hpp>
 #include <opm/simulators/linalg/ParallelIstlInformation.hpp>
 #include <opm/common/utility/platform_dependent/disable_warnings.h>
@@ -146,7 +148,7 @@ public:
 
   virtual void apply( const X& x, Y& y ) const override
   {
-    A_.mv( x, y );
+    BlockKernels::spmv( A_, x, y );
 
     // add well model modification to y
     wellMod_.apply(x, y );
@@ -160,7 +162,7 @@ public:
   // y += \alpha * A * x
   virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const override
   {
-    A_.usmv(alpha,x,y);
+    BlockKernels::spusmv( alpha, A_, x, y );
 
     // add scaled well model modification to y
     wellMod_.applyScaleAdd( alpha, x, y );
@@ -272,6 +274,9 @@ protected:
 
         void prepare(const SparseMatrixAdapter& M, Vector& b)
         {
+            if (isParallel()) {
+                updateWellConnections();
+            }
             matrix_.reset(new Matrix(M.istlMatrix()));
             rhs_ = &b;
             this->scaleSystem();
@@ -340,6 +345,19 @@ protected:
 
             const WellModel& wellModel = simulator_.problem().wellModel();
 
+            if (!parameters_.linear_system_dump_directory_.empty()
+                && numDumpedSystems_ < parameters_.linear_system_dump_count_) {
+                // in parallel runs every process writes its part of the system,
+                // including the overlap rows
+                const auto fileName = LinearSystemDump::fileName(parameters_.linear_system_dump_directory_,
+                                                                 simulator_.gridView().comm().rank(),
+                                                                 numDumpedSystems_++);
+                const auto* wells = wellModel.schurComplement();
+                if (!wells)
+                    OpmLog::warning("linear_system_dump", "The well matrices are not included in the linear system dumped to '" + fileName + "'");
+                LinearSystemDump::write(fileName, *matrix_, *rhs_, wells);
+            }
+
             if( isParallel() )
             {
                 typedef WellModelMatrixAdapter< Matrix, Vector, Vector, WellModel, true > Operator;
@@ -660,12 +678,60 @@ protected:
 #endif
         }
 
+        /// Update the well connections of the matrix without off-diagonal
+        /// ghost entries to the couplings of the current wells of the well
+        /// model, if they have changed.
+        void updateWellConnections()
+        {
+            const bool useWellConn = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
+            const auto& wellModel = simulator_.problem().wellModel();
+            if (!useWellConn || wellModel.wellSparsityRevision() == wellSparsityRevision_) {
+                return;
+            }
+            wellSparsityRevision_ = wellModel.wellSparsityRevision();
+
+            std::vector<std::set<int>> wellGraph(wellConnectionsGraph_.size());
+            for (const auto& wellCells : wellModel.wellSparsityCells()) {
+                for (int cell : wellCells) {
+                    for (int otherCell : wellCells) {
+                        if (otherCell != cell) {
+                            wellGraph[cell].insert(otherCell);
+                        }
+                    }
+                }
+            }
+
+            std::vector<char> changedRows(wellGraph.size(), false);
+            bool changed = false;
+            for (std::size_t idx = 0; idx < wellGraph.size(); ++idx) {
+                if (wellGraph[idx] != wellConnectionsGraph_[idx]) {
+                    changedRows[idx] = true;
+                    changed = true;
+                }
+            }
+            wellConnectionsGraph_.swap(wellGraph);
+            if (changed) {
+                noGhostAdjacency(changedRows);
+                setGhostsInNoGhost(*noGhostMat_);
+            }
+        }
+
         /// Create sparsity pattern of matrix without off-diagonal ghost entries.
         void noGhostAdjacency()
+        {
+            const auto& grid = simulator_.vanguard().grid();
+            noGhostAdjacency(std::vector<char>(grid.size(0), true));
+        }
+
+        /// Update the sparsity pattern of the matrix without off-diagonal ghost
+        /// entries. Only the pattern of the given rows is recomputed, the
+        /// other rows are copied from the current matrix.
+        void noGhostAdjacency(const std::vector<char>& changedRows)
         {
             const auto& grid = simulator_.vanguard().grid();
             typedef typename Matrix::size_type size_type;
             size_type numCells = grid.size( 0 );
+            std::unique_ptr<Matrix> oldMat(std::move(noGhostMat_));
             noGhostMat_.reset(new Matrix(numCells, numCells, Matrix::random));
 
             std::vector<std::set<size_type>> pattern;
@@ -681,6 +747,11 @@ protected:
             {
                 const auto& elem = *elemIt;
                 size_type idx = lid.id(elem);
+                if (!changedRows[idx])
+                {
+                    noGhostMat_->setrowsize(idx, (*oldMat)[idx].size());
+                    continue;
+                }
                 pattern[idx].insert(idx);
 
                 // Add well non-zero connections
@@ -709,6 +780,15 @@ protected:
             noGhostMat_->endrowsizes();
             for (size_type dofId = 0; dofId < numCells; ++dofId)
             {
+                if (!changedRows[dofId])
+                {
+                    const auto& oldRow = (*oldMat)[dofId];
+                    for (auto col = oldRow.begin(); col != oldRow.end(); ++col)
+                    {
+                        noGhostMat_->addindex(dofId, col.index());
+                    }
+                    continue;
+                }
                 auto nabIdx = pattern[dofId].begin();
                 auto endNab = pattern[dofId].end();
                 for (; nabIdx != endNab; ++nabIdx)
@@ -949,9 +1029,12 @@ protected:
         std::vector<int> overlapRows_;
         std::vector<int> interiorRows_;
         std::vector<std::set<int>> wellConnectionsGraph_;
+        // the revision of the well couplings of the well model in wellConnectionsGraph_
+        int wellSparsityRevision_ = -1;
         FlowLinearSolverParameters parameters_;
         Vector weights_;
         bool scale_variables_;
+        int numDumpedSystems_ = 0;
     }; // end ISTLSolver
 
 } // namespace Opm
@@ -23,6 +23,7 @@
 #include <opm/simulators/linalg/matrixblock.hh>
 #include <opm/simulators/linalg/findOverlapRowsAndColumns.hpp>
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/LinearSystemDump.hpp>
 #include <opm/simulators/linalg/setupPropertyTree.hpp>
 
 #include <memory>
@@ -106,6 +107,14 @@ public:
         }
         makeOverlapRowsInvalid(mat.istlMatrix());
 #endif
+        if (!parameters_.linear_system_dump_directory_.empty()
+            && numDumpedSystems_ < parameters_.linear_system_dump_count_) {
+            // the well contributions are part of the matrix, if any
+            const auto fileName = LinearSystemDump::fileName(parameters_.linear_system_dump_directory_,
+                                                             simulator_.gridView().comm().rank(),
+                                                             numDumpedSystems_++);
+            LinearSystemDump::write(fileName, mat.istlMatrix(), b, nullptr);
+        }
         // Decide if we should recreate the solver or just do
         // a minimal preconditioner update.
         const int newton_iteration = this->simulator_.model().newtonMethod().numIterations();
@@ -129,6 +138,14 @@ public:
             // Never recreate solver.
         }
 
+        // The solver refers to the matrix of the linearizer, which is
+        // recreated if the well couplings of its sparsity pattern change.
+        const int wellSparsityRevision = simulator_.problem().wellModel().wellSparsityRevision();
+        if (wellSparsityRevision != wellSparsityRevision_) {
+            recreate_solver = true;
+            wellSparsityRevision_ = wellSparsityRevision;
+        }
+
         if (recreate_solver || !solver_) {
             if (isParallel()) {
 #if HAVE_MPI
@@ -201,6 +218,7 @@ protected:
     const Simulator& simulator_;
 
     std::unique_ptr<SolverType> solver_;
+    int wellSparsityRevision_ = -1;
     FlowLinearSolverParameters parameters_;
     boost::property_tree::ptree prm_;
     VectorType rhs_;
@@ -211,6 +229,7 @@ protected:
 #endif
     std::vector<int> overlapRows_;
     std::vector<int> interiorRows_;
+    int numDumpedSystems_ = 0;
 }; // end ISTLSolverEbosFlexible
 
 } // namespace Opm
@@ -0,0 +1,361 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_KRYLOVSOLVERS_HEADER_INCLUDED
+#define OPM_KRYLOVSOLVERS_HEADER_INCLUDED
+
+#include <opm/simulators/linalg/FusedReduction.hpp>
+#include <opm/simulators/utils/PerformanceProfile.hpp>
+
+#include <dune/common/timer.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/solver.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace Opm
+{
+
+    namespace Detail
+    {
+        /// Fill in the result of a solve, record the number of global
+        /// reductions in the performance profile and report if requested.
+        inline void finishKrylov(Dune::InverseOperatorResult& res, const char* name, int verbose,
+                                 int iterations, double def0, double def, bool converged,
+                                 double elapsed, long long numReductions)
+        {
+            res.iterations = iterations;
+            res.reduction = def0 > 0.0 ? def/def0 : 0.0;
+            res.conv_rate = iterations > 0 ? std::pow(res.reduction, 1.0/iterations) : 0.0;
+            res.converged = converged || def0 == 0.0;
+            res.elapsed = elapsed;
+            PerformanceProfile::count("reductions", numReductions);
+            if (verbose > 0) {
+                std::cout << "=== " << name << ": IT=" << res.iterations
+                          << " reduction=" << res.reduction
+                          << " rate=" << res.conv_rate
+                          << " reductions=" << numReductions
+                          << " T=" << res.elapsed
+                          << (res.converged ? "" : " (not converged)") << std::endl;
+            }
+        }
+    } // namespace Detail
+
+    /// Pipelined BiCGSTAB with right preconditioning, following Cools and
+    /// Vanroose, "The communication-hiding pipelined BiCGStab method for the
+    /// parallel solution of large unsymmetric linear systems", Parallel
+    /// Computing 65, 2017.
+    ///
+    /// Each iteration needs two global reductions of two and five scalar
+    /// products, where the standard BiCGSTAB needs six. Each reduction is
+    /// overlapped with one application of the preconditioner and the
+    /// operator. The price is the storage of 15 vectors and a residual that
+    /// is only updated by recurrences, as for the standard method.
+    template <class X>
+    class PipelinedBiCGSTABSolver : public Dune::InverseOperator<X, X>
+    {
+    public:
+        PipelinedBiCGSTABSolver(Dune::LinearOperator<X, X>& op,
+                                std::shared_ptr<FusedReduction<X>> reduction,
+                                Dune::Preconditioner<X, X>& prec,
+                                double tol, int maxit, int verbose)
+            : op_(op), reduction_(reduction), prec_(prec), tol_(tol), maxit_(maxit), verbose_(verbose)
+        {
+        }
+
+        virtual void apply(X& x, X& b, double reduction, Dune::InverseOperatorResult& res) override
+        {
+            const double tol = tol_;
+            tol_ = reduction;
+            apply(x, b, res);
+            tol_ = tol;
+        }
+
+        virtual void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+        {
+            Dune::Timer watch;
+            res.clear();
+            const long long reductionsBefore = reduction_->numReductions();
+
+            X r(b), rt(b), rh(b), w(b), wh(b), t(b), ph(b), s(b), sh(b), z(b), zh(b), v(b), q(b), qh(b), y(b);
+            prec_.pre(x, b);
+
+            // r = b - A x, r^ = M^-1 r, w = A r^, w^ = M^-1 w, t = A w^
+            r = b;
+            op_.applyscaleadd(-1.0, x, r);
+            rt = r;
+            rh = 0.0;
+            prec_.apply(rh, r);
+            op_.apply(rh, w);
+            wh = 0.0;
+            prec_.apply(wh, w);
+            op_.apply(wh, t);
+
+            double dots[5];
+            reduction_->start({{&rt, &r}, {&rt, &w}, {&r, &r}}, dots);
+            reduction_->wait();
+            double rho = dots[0];
+            double alpha = dots[1] != 0.0 ? rho/dots[1] : 0.0;
+            double beta = 0.0;
+            double omega = 0.0;
+            const double def0 = std::sqrt(dots[2]);
+            double def = def0;
+            ph = 0.0; s = 0.0; sh = 0.0; z = 0.0; zh = 0.0; v = 0.0;
+
+            int it = 0;
+            bool breakdown = def0 == 0.0 || alpha == 0.0;
+            while (!breakdown && def > tol_*def0 && it < maxit_) {
+                ++it;
+                // p^ = r^ + beta (p^ - omega s^), s = A p^, s^ = M^-1 s, z = A s^
+                ph.axpy(-omega, sh); ph *= beta; ph += rh;
+                s.axpy(-omega, z); s *= beta; s += w;
+                sh.axpy(-omega, zh); sh *= beta; sh += wh;
+                z.axpy(-omega, v); z *= beta; z += t;
+                // q = r - alpha s, q^ = M^-1 q, y = A q^
+                q = r; q.axpy(-alpha, s);
+                qh = rh; qh.axpy(-alpha, sh);
+                y = w; y.axpy(-alpha, z);
+
+                reduction_->start({{&q, &y}, {&y, &y}}, dots);
+                zh = 0.0;
+                prec_.apply(zh, z);
+                op_.apply(zh, v);
+                reduction_->wait();
+
+                omega = dots[1] > 0.0 ? dots[0]/dots[1] : 0.0;
+                x.axpy(alpha, ph);
+                x.axpy(omega, qh);
+                // r = q - omega y, r^ = q^ - omega (w^ - alpha z^), w = y - omega (t - alpha v)
+                r = q; r.axpy(-omega, y);
+                rh = qh; rh.axpy(-omega, wh); rh.axpy(omega*alpha, zh);
+                w = y; w.axpy(-omega, t); w.axpy(omega*alpha, v);
+
+                reduction_->start({{&rt, &r}, {&rt, &w}, {&rt, &s}, {&rt, &z}, {&r, &r}}, dots);
+                wh = 0.0;
+                prec_.apply(wh, w);
+                op_.apply(wh, t);
+                reduction_->wait();
+
+                def = std::sqrt(std::max(dots[4], 0.0));
+                if (verbose_ > 1) {
+                    std::cout << "=== PipelinedBiCGSTABSolver: iteration " << it << " defect " << def << std::endl;
+                }
+                if (omega == 0.0 || rho == 0.0 || dots[0] == 0.0) {
+                    breakdown = def > tol_*def0;
+                    break;
+                }
+                beta = alpha/omega * dots[0]/rho;
+                const double denominator = dots[1] + beta*dots[2] - beta*omega*dots[3];
+                rho = dots[0];
+                if (denominator == 0.0) {
+                    breakdown = def > tol_*def0;
+                    break;
+                }
+                alpha = rho/denominator;
+            }
+
+            prec_.post(x);
+            Detail::finishKrylov(res, "PipelinedBiCGSTABSolver", verbose_, it, def0, def,
+                                 !breakdown && def <= tol_*def0, watch.elapsed(),
+                                 reduction_->numReductions() - reductionsBefore);
+        }
+
+        virtual Dune::SolverCategory::Category category() const override
+        {
+            return op_.category();
+        }
+
+    private:
+        Dune::LinearOperator<X, X>& op_;
+        std::shared_ptr<FusedReduction<X>> reduction_;
+        Dune::Preconditioner<X, X>& prec_;
+        double tol_;
+        int maxit_;
+        int verbose_;
+    };
+
+    /// Restarted flexible GMRES, which allows the preconditioner to change
+    /// between iterations, as the CPR preconditioner with an iterative
+    /// pressure solver does.
+    ///
+    /// The Krylov basis is orthogonalized with classical Gram-Schmidt, such
+    /// that all products of an iteration, including the norm of the new
+    /// basis vector, are computed by a single global reduction. The modified
+    /// Gram-Schmidt of the Dune GMRES needs one reduction per basis vector.
+    /// When the norm shows a loss of orthogonality the vector is
+    /// orthogonalized a second time, at the cost of one more reduction.
+    template <class X>
+    class FlexibleGMResSolver : public Dune::InverseOperator<X, X>
+    {
+    public:
+        FlexibleGMResSolver(Dune::LinearOperator<X, X>& op,
+                            std::shared_ptr<FusedReduction<X>> reduction,
+                            Dune::Preconditioner<X, X>& prec,
+                            double tol, int restart, int maxit, int verbose)
+            : op_(op), reduction_(reduction), prec_(prec), tol_(tol),
+              restart_(std::max(restart, 1)), maxit_(maxit), verbose_(verbose)
+        {
+        }
+
+        virtual void apply(X& x, X& b, double reduction, Dune::InverseOperatorResult& res) override
+        {
+            const double tol = tol_;
+            tol_ = reduction;
+            apply(x, b, res);
+            tol_ = tol;
+        }
+
+        virtual void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+        {
+            Dune::Timer watch;
+            res.clear();
+            const long long reductionsBefore = reduction_->numReductions();
+            const int m = restart_;
+
+            std::vector<X> V(m + 1, b), Z(m, b);
+            std::vector<double> H((m + 1)*m, 0.0), cs(m, 0.0), sn(m, 0.0), g(m + 1, 0.0);
+            std::vector<double> dots(m + 2);
+            const auto h = [&H, m](int i, int j) -> double& { return H[i*m + j]; };
+
+            prec_.pre(x, b);
+            X& r = V[0];
+            r = b;
+            op_.applyscaleadd(-1.0, x, r);
+            reduction_->start({{&r, &r}}, dots.data());
+            reduction_->wait();
+            const double def0 = std::sqrt(dots[0]);
+            double def = def0;
+
+            int it = 0;
+            while (def > tol_*def0 && it < maxit_) {
+                V[0] *= 1.0/def;
+                std::fill(g.begin(), g.end(), 0.0);
+                g[0] = def;
+
+                int j = 0;
+                bool lucky = false;
+                for (; j < m && it < maxit_ && def > tol_*def0 && !lucky; ++j, ++it) {
+                    Z[j] = 0.0;
+                    prec_.apply(Z[j], V[j]);
+                    X& w = V[j + 1];
+                    op_.apply(Z[j], w);
+
+                    double norm2 = orthogonalize_(V, j, dots);
+                    for (int i = 0; i <= j; ++i)
+                        h(i, j) = dots[i];
+                    if (norm2 < 0.25*dots[j + 1]) {
+                        // cancellation in w: orthogonalize once more
+                        norm2 = orthogonalize_(V, j, dots);
+                        for (int i = 0; i <= j; ++i)
+                            h(i, j) += dots[i];
+                    }
+                    const double hNext = std::sqrt(std::max(norm2, 0.0));
+
+                    // apply the previous rotations to the new column and
+                    // eliminate its subdiagonal entry
+                    for (int i = 0; i < j; ++i) {
+                        const double tmp = cs[i]*h(i, j) + sn[i]*h(i + 1, j);
+                        h(i + 1, j) = -sn[i]*h(i, j) + cs[i]*h(i + 1, j);
+                        h(i, j) = tmp;
+                    }
+                    const double denominator = std::hypot(h(j, j), hNext);
+                    cs[j] = denominator > 0.0 ? h(j, j)/denominator : 1.0;
+                    sn[j] = denominator > 0.0 ? hNext/denominator : 0.0;
+                    h(j, j) = denominator;
+                    g[j + 1] = -sn[j]*g[j];
+                    g[j] = cs[j]*g[j];
+                    def = std::abs(g[j + 1]);
+                    if (verbose_ > 1) {
+                        std::cout << "=== FlexibleGMResSolver: iteration " << it + 1 << " defect " << def << std::endl;
+                    }
+
+                    lucky = hNext == 0.0;
+                    if (!lucky)
+                        w *= 1.0/hNext;
+                }
+
+                // x += Z y with H y = g
+                for (int i = j - 1; i >= 0; --i) {
+                    for (int k = i + 1; k < j; ++k)
+                        g[i] -= h(i, k)*g[k];
+                    g[i] = h(i, i) != 0.0 ? g[i]/h(i, i) : 0.0;
+                }
+                for (int i = 0; i < j; ++i)
+                    x.axpy(g[i], Z[i]);
+
+                if (lucky || def <= tol_*def0 || it >= maxit_)
+                    break;
+
+                // restart with the true residual
+                r = b;
+                op_.applyscaleadd(-1.0, x, r);
+                reduction_->start({{&r, &r}}, dots.data());
+                reduction_->wait();
+                def = std::sqrt(dots[0]);
+            }
+
+            prec_.post(x);
+            Detail::finishKrylov(res, "FlexibleGMResSolver", verbose_, it, def0, def,
+                                 def <= tol_*def0, watch.elapsed(),
+                                 reduction_->numReductions() - reductionsBefore);
+        }
+
+        virtual Dune::SolverCategory::Category category() const override
+        {
+            return op_.category();
+        }
+
+    private:
+        // One classical Gram-Schmidt pass of V[j + 1] against V[0..j]. The
+        // products (V[i], V[j + 1]) are left in dots[i] and the squared norm
+        // before the pass in dots[j + 1]. Returns the squared norm after the
+        // pass.
+        double orthogonalize_(std::vector<X>& V, int j, std::vector<double>& dots)
+        {
+            X& w = V[j + 1];
+            pairs_.clear();
+            for (int i = 0; i <= j; ++i)
+                pairs_.emplace_back(&V[i], &w);
+            pairs_.emplace_back(&w, &w);
+            reduction_->start(pairs_, dots.data());
+            reduction_->wait();
+            double norm2 = dots[j + 1];
+            for (int i = 0; i <= j; ++i) {
+                w.axpy(-dots[i], V[i]);
+                norm2 -= dots[i]*dots[i];
+            }
+            return norm2;
+        }
+
+        Dune::LinearOperator<X, X>& op_;
+        std::shared_ptr<FusedReduction<X>> reduction_;
+        Dune::Preconditioner<X, X>& prec_;
+        double tol_;
+        int restart_;
+        int maxit_;
+        int verbose_;
+        std::vector<typename FusedReduction<X>::DotPair> pairs_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_KRYLOVSOLVERS_HEADER_INCLUDED
@@ -0,0 +1,216 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_LINEARSYSTEMDUMP_HEADER_INCLUDED
+#define OPM_LINEARSYSTEMDUMP_HEADER_INCLUDED
+
+#include <opm/simulators/wells/WellSchurComplement.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+    /// Binary dumps of the linear systems of the reservoir equations, used to
+    /// replay the systems of a simulation run with other linear solvers.
+    ///
+    /// A dump holds a block sparse matrix, its right hand side and optionally
+    /// the well matrices B, C and D^-1 of the wells whose contribution
+    /// A - C^T D^-1 B is applied by the linear operator. All values are stored
+    /// as doubles in native byte order:
+    ///
+    ///     char[8]   "OPMLSYS1"
+    ///     int32     block size n
+    ///     uint64    number of block rows N
+    ///     uint64    number of nonzero blocks nnz
+    ///     uint64    row offsets, N + 1 entries
+    ///     int32     column indices, nnz entries
+    ///     double    matrix blocks, nnz*n*n entries, each block row major
+    ///     double    right hand side, N*n entries
+    ///     uint8     1 if the well matrices follow, 0 otherwise
+    ///     well matrices as written by WellSchurComplement::write()
+    namespace LinearSystemDump
+    {
+        const char magic[8] = { 'O', 'P', 'M', 'L', 'S', 'Y', 'S', '1' };
+
+        /// The name of the index-th dump of the given process.
+        inline std::string fileName(const std::string& directory, int rank, int index)
+        {
+            return directory + "/linear_system_" + std::to_string(rank) + "_" + std::to_string(index) + ".opmsys";
+        }
+
+        template <class Matrix, class Vector>
+        void write(const std::string& fileName, const Matrix& A, const Vector& b,
+                   const WellSchurComplement<double, Matrix::block_type::rows>* wells)
+        {
+            const int n = Matrix::block_type::rows;
+            std::ofstream os(fileName, std::ios::binary);
+            if (!os) {
+                throw std::runtime_error("Cannot write linear system to '" + fileName + "'");
+            }
+
+            const std::int32_t blockSize = n;
+            const std::uint64_t numRows = A.N();
+            const std::uint64_t numNonzeros = A.nonzeroes();
+            os.write(magic, sizeof(magic));
+            os.write(reinterpret_cast<const char*>(&blockSize), sizeof(blockSize));
+            os.write(reinterpret_cast<const char*>(&numRows), sizeof(numRows));
+            os.write(reinterpret_cast<const char*>(&numNonzeros), sizeof(numNonzeros));
+
+            std::vector<std::uint64_t> rowOffsets(1, 0);
+            std::vector<std::int32_t> columns;
+            std::vector<double> values;
+            columns.reserve(numNonzeros);
+            values.reserve(numNonzeros*n*n);
+            for (auto row = A.begin(); row != A.end(); ++row) {
+                for (auto col = row->begin(); col != row->end(); ++col) {
+                    columns.push_back(col.index());
+                    for (int i = 0; i < n; ++i)
+                        for (int j = 0; j < n; ++j)
+                            values.push_back((*col)[i][j]);
+                }
+                rowOffsets.push_back(columns.size());
+            }
+            std::vector<double> rhs;
+            rhs.reserve(numRows*n);
+            for (const auto& block : b)
+                for (int i = 0; i < n; ++i)
+                    rhs.push_back(block[i]);
+
+            os.write(reinterpret_cast<const char*>(rowOffsets.data()), rowOffsets.size()*sizeof(std::uint64_t));
+            os.write(reinterpret_cast<const char*>(columns.data()), columns.size()*sizeof(std::int32_t));
+            os.write(reinterpret_cast<const char*>(values.data()), values.size()*sizeof(double));
+            os.write(reinterpret_cast<const char*>(rhs.data()), rhs.size()*sizeof(double));
+
+            const std::uint8_t hasWells = wells != nullptr;
+            os.write(reinterpret_cast<const char*>(&hasWells), sizeof(hasWells));
+            if (wells)
+                wells->write(os);
+
+            if (!os) {
+                throw std::runtime_error("Cannot write linear system to '" + fileName + "'");
+            }
+        }
+
+        /// The block size of the system in a dump.
+        inline int blockSize(const std::string& fileName)
+        {
+            std::ifstream is(fileName, std::ios::binary);
+            char header[sizeof(magic)];
+            std::int32_t blockSize = 0;
+            is.read(header, sizeof(header));
+            is.read(reinterpret_cast<char*>(&blockSize), sizeof(blockSize));
+            if (!is || std::memcmp(header, magic, sizeof(magic)) != 0) {
+                throw std::runtime_error("'" + fileName + "' is not a linear system dump");
+            }
+            return blockSize;
+        }
+
+        /// Read a dump into A, b and wells. Returns whether the dump contains
+        /// well matrices.
+        template <class Matrix, class Vector>
+        bool read(const std::string& fileName, Matrix& A, Vector& b,
+                  WellSchurComplement<double, Matrix::block_type::rows>& wells)
+        {
+            const int n = Matrix::block_type::rows;
+            if (blockSize(fileName) != n) {
+                throw std::runtime_error("Unexpected block size in linear system dump '" + fileName + "'");
+            }
+
+            std::ifstream is(fileName, std::ios::binary);
+            is.seekg(sizeof(magic) + sizeof(std::int32_t));
+            std::uint64_t numRows = 0, numNonzeros = 0;
+            is.read(reinterpret_cast<char*>(&numRows), sizeof(numRows));
+            is.read(reinterpret_cast<char*>(&numNonzeros), sizeof(numNonzeros));
+
+            std::vector<std::uint64_t> rowOffsets(numRows + 1);
+            std::vector<std::int32_t> columns(numNonzeros);
+            std::vector<double> values(numNonzeros*n*n);
+            std::vector<double> rhs(numRows*n);
+            is.read(reinterpret_cast<char*>(rowOffsets.data()), rowOffsets.size()*sizeof(std::uint64_t));
+            is.read(reinterpret_cast<char*>(columns.data()), columns.size()*sizeof(std::int32_t));
+            is.read(reinterpret_cast<char*>(values.data()), values.size()*sizeof(double));
+            is.read(reinterpret_cast<char*>(rhs.data()), rhs.size()*sizeof(double));
+            std::uint8_t hasWells = 0;
+            is.read(reinterpret_cast<char*>(&hasWells), sizeof(hasWells));
+            if (!is || rowOffsets.back() != numNonzeros) {
+                throw std::runtime_error("Corrupt linear system dump '" + fileName + "'");
+            }
+
+            A.setSize(numRows, numRows, numNonzeros);
+            A.setBuildMode(Matrix::row_wise);
+            for (auto row = A.createbegin(); row != A.createend(); ++row)
+                for (std::uint64_t k = rowOffsets[row.index()]; k < rowOffsets[row.index() + 1]; ++k)
+                    row.insert(columns[k]);
+
+            const double* value = values.data();
+            for (auto row = A.begin(); row != A.end(); ++row)
+                for (auto col = row->begin(); col != row->end(); ++col)
+                    for (int i = 0; i < n; ++i)
+                        for (int j = 0; j < n; ++j)
+                            (*col)[i][j] = *value++;
+
+            b.resize(numRows);
+            for (std::uint64_t row = 0; row < numRows; ++row)
+                for (int i = 0; i < n; ++i)
+                    b[row][i] = rhs[row*n + i];
+
+            wells.clear();
+            if (hasWells)
+                wells.read(is);
+            return hasWells;
+        }
+
+        /// The matrix A - C^T D^-1 B, which includes the couplings of the
+        /// perforated cells introduced by the wells.
+        template <class Matrix>
+        Matrix addWellContributions(const Matrix& A,
+                                    const WellSchurComplement<double, Matrix::block_type::rows>& wells)
+        {
+            std::vector<std::set<int>> pattern(A.N());
+            for (auto row = A.begin(); row != A.end(); ++row)
+                for (auto col = row->begin(); col != row->end(); ++col)
+                    pattern[row.index()].insert(col.index());
+            wells.addCouplings(pattern);
+
+            std::size_t numNonzeros = 0;
+            for (const auto& columns : pattern)
+                numNonzeros += columns.size();
+
+            Matrix result(A.N(), A.M(), numNonzeros, Matrix::row_wise);
+            for (auto row = result.createbegin(); row != result.createend(); ++row)
+                for (const int col : pattern[row.index()])
+                    row.insert(col);
+
+            result = 0.0;
+            for (auto row = A.begin(); row != A.end(); ++row)
+                for (auto col = row->begin(); col != row->end(); ++col)
+                    result[row.index()][col.index()] = *col;
+            wells.subtractFromMatrix(result);
+            return result;
+        }
+    } // namespace LinearSystemDump
+
+} // namespace Opm
+
+#endif // OPM_LINEARSYSTEMDUMP_HEADER_INCLUDED
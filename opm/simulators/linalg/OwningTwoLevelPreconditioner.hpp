@@ -73,9 +73,8 @@ public:
         : linear_operator_(linearoperator)
         , finesmoother_(PrecFactory::create(linearoperator, prm.get_child("finesmoother")))
         , comm_(nullptr)
-        , weights_(Opm::Amg::getQuasiImpesWeights<MatrixType, VectorType>(
-              linearoperator.getmat(), prm.get<int>("pressure_var_index"), transpose))
-        , levelTransferPolicy_(dummy_comm_, weights_, prm.get<int>("pressure_var_index"))
+        , weights_(linearoperator.getmat().N())
+        , levelTransferPolicy_(dummy_comm_, weights_, prm.get<int>("pressure_var_index"), true)
         , coarseSolverPolicy_(prm.get_child("coarsesolver"))
         , twolevel_method_(linearoperator,
                            finesmoother_,
@@ -98,9 +97,8 @@ public:
         : linear_operator_(linearoperator)
         , finesmoother_(PrecFactory::create(linearoperator, prm.get_child("finesmoother"), comm))
         , comm_(&comm)
-        , weights_(Opm::Amg::getQuasiImpesWeights<MatrixType, VectorType>(
-              linearoperator.getmat(), prm.get<int>("pressure_var_index"), transpose))
-        , levelTransferPolicy_(*comm_, weights_, prm.get<int>("pressure_var_index"))
+        , weights_(linearoperator.getmat().N())
+        , levelTransferPolicy_(*comm_, weights_, prm.get<int>("pressure_var_index"), true)
         , coarseSolverPolicy_(prm.get_child("coarsesolver"))
         , twolevel_method_(linearoperator,
                            finesmoother_,
@@ -136,8 +134,8 @@ public:
 
     virtual void update() override
     {
-        Opm::Amg::getQuasiImpesWeights<MatrixType, VectorType>(
-            linear_operator_.getmat(), prm_.get<int>("pressure_var_index"), transpose, weights_);
+        // The quasi-IMPES weights are recomputed by the level transfer
+        // policy together with the coarse matrix entries.
         updateImpl(comm_);
     }
 
@@ -20,6 +20,7 @@
 #ifndef OPM_PARALLELOVERLAPPINGILU0_HEADER_INCLUDED
 #define OPM_PARALLELOVERLAPPINGILU0_HEADER_INCLUDED
 
+#include <opm/simulators/linalg/BlockKernels.hpp>
 #include <opm/simulators/linalg/GraphColoring.hpp>
 #include <opm/common/Exceptions.hpp>
 #include <opm/common/ErrorMacros.hpp>
@@ -338,6 +339,64 @@ namespace Opm
                             diagonal);
     }
 
+    /// \brief ILU(0) decomposition in place, same algorithm as Dune::bilu0_decomposition
+    ///        but using the block kernels of BlockKernels.hpp.
+    ///
+    /// The diagonal blocks are replaced by their inverses.
+    template<class M>
+    void ilu0_decomposition(M& A)
+    {
+        typename M::block_type modifier;
+
+        for ( auto irow = A.begin(), iend = A.end(); irow != iend; ++irow)
+        {
+            auto a_i_end = irow->end();
+            auto a_ik    = irow->begin();
+
+            for ( ; a_ik != a_i_end && a_ik.index() < irow.index(); ++a_ik )
+            {
+                auto k = a_ik.index();
+                auto a_kk = A[k].find(k);
+                // L_ik = A_ik * A_kk^-1, the diagonal is already inverted
+                BlockKernels::rightmultiply(*a_ik, *a_kk);
+
+                // a_ij -= L_ik * a_kj for all j > k present in both rows
+                auto a_k_end = A[k].end();
+                auto a_kj = a_kk, a_ij = a_ik;
+                ++a_kj; ++a_ij;
+
+                while ( a_ij != a_i_end && a_kj != a_k_end )
+                {
+                    if ( a_ij.index() == a_kj.index() )
+                    {
+                        BlockKernels::multiplySubtract(*a_ik, *a_kj, *a_ij);
+                        ++a_ij; ++a_kj;
+                    }
+                    else if ( a_ij.index() < a_kj.index() )
+                    {
+                        ++a_ij;
+                    }
+                    else
+                    {
+                        ++a_kj;
+                    }
+                }
+            }
+
+            if ( a_ik == a_i_end || a_ik.index() != irow.index() )
+                OPM_THROW(std::logic_error, "Matrix is missing diagonal for row " << irow.index());
+
+            try
+            {
+                BlockKernels::invert(*a_ik);   // compute inverse of diagonal block
+            }
+            catch (const Dune::FMatrixError&)
+            {
+                DUNE_THROW(Dune::MatrixBlockError, "ILU failed to invert matrix block of row " << irow.index());
+            }
+        }
+    }
+
     template<class M>
     void milun_decomposition(const M& A, int n, MILU_VARIANT milu, M& ILU,
                              Reorderer& ordering, Reorderer& inverseOrdering)
@@ -761,7 +820,7 @@ public:
 
           for( size_type col = rowI; col < rowINext; ++ col )
           {
-            lower_.values_[ col ].mmv( mv[ lower_.cols_[ col ] ], rhs );
+            BlockKernels::mmv( lower_.values_[ col ], mv[ lower_.cols_[ col ] ], rhs );
           }
 
           mv[ i ] = rhs;  // Lii = I
@@ -776,11 +835,11 @@ public:
 
             for( size_type col = rowI; col < rowINext; ++ col )
             {
-                upper_.values_[ col ].mmv( mv[ upper_.cols_[ col ] ], rhs );
+                BlockKernels::mmv( upper_.values_[ col ], mv[ upper_.cols_[ col ] ], rhs );
             }
 
             // apply inverse and store result
-            inv_[ i ].mv( rhs, vBlock);
+            BlockKernels::mv( inv_[ i ], rhs, vBlock );
         }
 
         copyOwnerToAll( mv );
@@ -911,7 +970,7 @@ protected:
                                                   detail::IsPositiveFunctor() );
                     break;
                 default:
-                    bilu0_decomposition( *ILU );
+                    detail::ilu0_decomposition( *ILU );
                     break;
                 }
             }
@@ -22,8 +22,11 @@
 #define OPM_PRESSURE_TRANSFER_POLICY_HEADER_INCLUDED
 
 
+#include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
 #include <opm/simulators/linalg/twolevelmethodcpr.hh>
 
+#include <exception>
+
 
 namespace Opm
 {
@@ -40,6 +43,20 @@ public:
     PressureTransferPolicy(const Communication& comm, const FineVectorType& weights, int pressure_var_index)
         : communication_(&const_cast<Communication&>(comm))
         , weights_(weights)
+        , quasi_impes_weights_(nullptr)
+        , pressure_var_index_(pressure_var_index)
+    {
+    }
+
+    /// Constructor for a policy that computes the quasi-IMPES weights
+    /// itself, in the same pass over the fine matrix that computes the
+    /// coarse entries. The weights are written to the given vector,
+    /// which must have the size of the fine system.
+    PressureTransferPolicy(const Communication& comm, FineVectorType& weights, int pressure_var_index,
+                           bool compute_quasi_impes_weights)
+        : communication_(&const_cast<Communication&>(comm))
+        , weights_(weights)
+        , quasi_impes_weights_(compute_quasi_impes_weights ? &weights : nullptr)
         , pressure_var_index_(pressure_var_index)
     {
     }
@@ -75,30 +92,65 @@ public:
 
     virtual void calculateCoarseEntries(const FineOperator& fineOperator) override
     {
+        // The sparsity pattern of the coarse matrix is the one of the fine
+        // matrix and is set up once in createCoarseLevelSystem(), only the
+        // values are recomputed here. The rows are independent and are
+        // distributed over the threads.
         const auto& fineMatrix = fineOperator.getmat();
-        *coarseLevelMatrix_ = 0;
-        auto rowCoarse = coarseLevelMatrix_->begin();
-        for (auto row = fineMatrix.begin(), rowEnd = fineMatrix.end(); row != rowEnd; ++row, ++rowCoarse) {
-            assert(row.index() == rowCoarse.index());
-            auto entryCoarse = rowCoarse->begin();
-            for (auto entry = row->begin(), entryEnd = row->end(); entry != entryEnd; ++entry, ++entryCoarse) {
+        auto& coarseMatrix = *coarseLevelMatrix_;
+        const int numRows = fineMatrix.N();
+        assert(coarseMatrix.N() == fineMatrix.N());
+
+        // In the transposed case a coarse entry needs the weights of its
+        // column, so all weights must be known before the entries are
+        // computed. Otherwise only the weights of the row itself are used
+        // and both are computed in a single pass.
+        const bool fused = quasi_impes_weights_ && !transpose;
+        if (quasi_impes_weights_ && transpose) {
+            Opm::Amg::getQuasiImpesWeights(fineMatrix, pressure_var_index_, transpose, *quasi_impes_weights_);
+        }
+
+        std::exception_ptr failure;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int rowIdx = 0; rowIdx < numRows; ++rowIdx) {
+            const auto& row = fineMatrix[rowIdx];
+            auto& rowCoarse = coarseMatrix[rowIdx];
+            if (fused) {
+                try {
+                    Opm::Amg::getQuasiImpesWeight(row, rowIdx, pressure_var_index_, transpose,
+                                                  (*quasi_impes_weights_)[rowIdx]);
+                } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(pressure_transfer_failure)
+#endif
+                    failure = std::current_exception();
+                    continue;
+                }
+            }
+            auto entryCoarse = rowCoarse.begin();
+            for (auto entry = row.begin(), entryEnd = row.end(); entry != entryEnd; ++entry, ++entryCoarse) {
                 assert(entry.index() == entryCoarse.index());
                 double matrix_el = 0;
                 if (transpose) {
-                    auto bw = weights_[entry.index()];
+                    const auto& bw = weights_[entry.index()];
                     for (size_t i = 0; i < bw.size(); ++i) {
                         matrix_el += (*entry)[pressure_var_index_][i] * bw[i];
                     }
                 } else {
-                    auto bw = weights_[row.index()];
+                    const auto& bw = weights_[rowIdx];
                     for (size_t i = 0; i < bw.size(); ++i) {
                         matrix_el += (*entry)[i][pressure_var_index_] * bw[i];
                     }
                 }
                 (*entryCoarse) = matrix_el;
             }
+            assert(entryCoarse == rowCoarse.end());
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
         }
-        assert(rowCoarse == coarseLevelMatrix_->end());
     }
 
     virtual void moveToCoarseLevel(const typename ParentType::FineRangeType& fine) override
@@ -153,6 +205,7 @@ public:
 private:
     Communication* communication_;
     const FineVectorType& weights_;
+    FineVectorType* quasi_impes_weights_;
     const int pressure_var_index_;
     std::shared_ptr<Communication> coarseLevelCommunication_;
     std::shared_ptr<typename CoarseOperator::matrix_type> coarseLevelMatrix_;
@@ -22,6 +22,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <exception>
 
 namespace Opm
 {
@@ -42,37 +44,57 @@ namespace Details
 
 namespace Amg
 {
+    /// Compute the quasi-IMPES weights of a single row, i.e. the pressure
+    /// row of the inverse (transposed) diagonal block, scaled to unit
+    /// maximum norm.
+    template <class Row, class VectorBlockType>
+    void getQuasiImpesWeight(const Row& row, const std::size_t rowIndex, const int pressureVarIndex,
+                             const bool transpose, VectorBlockType& bweights)
+    {
+        using MatrixBlockType = typename Row::block_type;
+        VectorBlockType rhs(0.0);
+        rhs[pressureVarIndex] = 1.0;
+        MatrixBlockType diag_block(0.0);
+        const auto diag = row.find(rowIndex);
+        if (diag != row.end()) {
+            diag_block = *diag;
+        }
+        if (transpose) {
+            diag_block.solve(bweights, rhs);
+        } else {
+            auto diag_block_transpose = Opm::Details::transposeDenseMatrix(diag_block);
+            diag_block_transpose.solve(bweights, rhs);
+        }
+        double abs_max = *std::max_element(
+            bweights.begin(), bweights.end(), [](double a, double b) { return std::fabs(a) < std::fabs(b); });
+        bweights /= std::fabs(abs_max);
+    }
+
     template <class Matrix, class Vector>
     void getQuasiImpesWeights(const Matrix& matrix, const int pressureVarIndex, const bool transpose, Vector& weights)
     {
-        using VectorBlockType = typename Vector::block_type;
-        using MatrixBlockType = typename Matrix::block_type;
         const Matrix& A = matrix;
-        VectorBlockType rhs(0.0);
-        rhs[pressureVarIndex] = 1.0;
-        const auto endi = A.end();
-        for (auto i = A.begin(); i != endi; ++i) {
-            const auto endj = (*i).end();
-            MatrixBlockType diag_block(0.0);
-            for (auto j = (*i).begin(); j != endj; ++j) {
-                if (i.index() == j.index()) {
-                    diag_block = (*j);
-                    break;
-                }
+        const int numRows = A.N();
+        // The rows are independent, so they are distributed over the threads.
+        // Exceptions must not escape the parallel region, so a failure of the
+        // block solve is forwarded after the loop.
+        std::exception_ptr failure;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int row = 0; row < numRows; ++row) {
+            try {
+                getQuasiImpesWeight(A[row], row, pressureVarIndex, transpose, weights[row]);
+            } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(quasi_impes_failure)
+#endif
+                failure = std::current_exception();
             }
-            VectorBlockType bweights;
-            if (transpose) {
-                diag_block.solve(bweights, rhs);
-            } else {
-                auto diag_block_transpose = Opm::Details::transposeDenseMatrix(diag_block);
-                diag_block_transpose.solve(bweights, rhs);
-            }
-            double abs_max = *std::max_element(
-                bweights.begin(), bweights.end(), [](double a, double b) { return std::fabs(a) < std::fabs(b); });
-            bweights /= std::fabs(abs_max);
-            weights[i.index()] = bweights;
         }
-        // return weights;
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
     }
 
     template <class Matrix, class Vector>
@@ -15,6 +15,7 @@
 #include <opm/simulators/timestepping/AdaptiveSimulatorTimer.hpp>
 #include <opm/simulators/timestepping/TimeStepControlInterface.hpp>
 #include <opm/simulators/timestepping/TimeStepControl.hpp>
+#include <opm/simulators/utils/Checkpoint.hpp>
 #include <opm/core/props/phaseUsageFromDeck.hpp>
 
 BEGIN_PROPERTIES
@@ -41,6 +42,7 @@ NEW_PROP_TAG(TimeStepControlTargetNewtonIterations);
 NEW_PROP_TAG(TimeStepControlDecayRate);
 NEW_PROP_TAG(TimeStepControlGrowthRate);
 NEW_PROP_TAG(TimeStepControlFileName);
+NEW_PROP_TAG(TimeStepControlHistorySize);
 NEW_PROP_TAG(MinTimeStepBeforeShuttingProblematicWellsInDays);
 
 SET_SCALAR_PROP(FlowTimeSteppingParameters, SolverRestartFactor, 0.33);
@@ -61,6 +63,7 @@ SET_INT_PROP(FlowTimeSteppingParameters, TimeStepControlTargetNewtonIterations,
 SET_SCALAR_PROP(FlowTimeSteppingParameters, TimeStepControlDecayRate, 0.75);
 SET_SCALAR_PROP(FlowTimeSteppingParameters, TimeStepControlGrowthRate, 1.25);
 SET_STRING_PROP(FlowTimeSteppingParameters, TimeStepControlFileName, "timesteps");
+SET_INT_PROP(FlowTimeSteppingParameters, TimeStepControlHistorySize, 8);
 SET_SCALAR_PROP(FlowTimeSteppingParameters, MinTimeStepBeforeShuttingProblematicWellsInDays, 0.25);
 
 
@@ -171,7 +174,7 @@ namespace Opm {
             EWOMS_REGISTER_PARAM(TypeTag, double, TimeStepAfterEventInDays,
                                  "Time step size of the first time step after an event occurs during the simulation in days");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, TimeStepControl,
-                                 "The algorithm used to determine time-step sizes. valid options are: 'pid' (default), 'pid+iteration', 'pid+newtoniteration', 'iterationcount' and 'hardcoded'");
+                                 "The algorithm used to determine time-step sizes. valid options are: 'pid' (default), 'pid+iteration', 'pid+newtoniteration', 'iterationcount', 'costaware' and 'hardcoded'");
             EWOMS_REGISTER_PARAM(TypeTag, double, TimeStepControlTolerance,
                                  "The tolerance used by the time step size control algorithm");
             EWOMS_REGISTER_PARAM(TypeTag, int, TimeStepControlTargetIterations,
@@ -184,6 +187,8 @@ namespace Opm {
                                  "The growth rate of the time step size of the number of target iterations is undercut");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, TimeStepControlFileName,
                                  "The name of the file which contains the hardcoded time steps sizes");
+            EWOMS_REGISTER_PARAM(TypeTag, int, TimeStepControlHistorySize,
+                                 "The number of substeps the 'costaware' time step control keeps in its history");
             EWOMS_REGISTER_PARAM(TypeTag, double, MinTimeStepBeforeShuttingProblematicWellsInDays,
                                  "The minimum time step size in days for which problematic wells are not shut");
         }
@@ -222,6 +227,9 @@ namespace Opm {
 
             // reset the statistics for the failed substeps
             failureReport_ = SimulatorReport();
+            if (costControl_) {
+                costControl_->resetStatistics();
+            }
 
             // counter for solver restarts
             int restarts = 0;
@@ -244,6 +252,8 @@ namespace Opm {
 
                 SimulatorReport substepReport;
                 std::string causeOfFailure = "";
+                Opm::time::StopWatch substepTimeWatch;
+                substepTimeWatch.start();
                 try {
                     substepReport = solver.step(substepTimer);
                     report += substepReport;
@@ -293,6 +303,17 @@ namespace Opm {
                     // this can be thrown by ISTL's ILU0 in block mode, yet is not an ISTLError
                 }
 
+                if (costControl_) {
+                    CostAwareTimeStepControl::SubStepCost cost;
+                    cost.dt = dt;
+                    cost.wallTime = substepTimeWatch.secsSinceStart();
+                    cost.newtonIterations = substepReport.total_newton_iterations;
+                    cost.linearIterations = substepReport.total_linear_iterations;
+                    cost.wellIterations = substepReport.total_well_iterations;
+                    cost.converged = substepReport.converged;
+                    costControl_->recordSubStep(cost);
+                }
+
                 if (substepReport.converged) {
                     // advance by current dt
                     ++substepTimer;
@@ -370,7 +391,8 @@ namespace Opm {
                     }
 
                     // The new, chopped timestep.
-                    const double newTimeStep = restartFactor_ * dt;
+                    const double newTimeStep = costControl_ ? costControl_->computeTimeStepSizeAfterFailure(dt)
+                        : restartFactor_ * dt;
 
 
                     // If we have restarted (i.e. cut the timestep) too
@@ -448,6 +470,19 @@ namespace Opm {
                 OpmLog::debug(ss.str());
             }
 
+            if (costControl_ && timestepVerbose_) {
+                const double useful = costControl_->usefulWork();
+                const double wasted = costControl_->wastedWork();
+                const double total = useful + wasted;
+                std::ostringstream ss;
+                ss << "Report step work: useful " << useful << " sec, wasted " << wasted << " sec in "
+                   << costControl_->numFailures() << " failed substep(s)";
+                if (total > 0.0) {
+                    ss << " (" << 100.0*wasted/total << "% wasted)";
+                }
+                OpmLog::info(ss.str());
+            }
+
             if (! std::isfinite(suggestedNextTimestep_)) { // check for NaN
                 suggestedNextTimestep_ = timestep;
             }
@@ -476,6 +511,41 @@ namespace Opm {
             timestepAfterEvent_ = tuning.TMAXWC;
         }
 
+        /** \brief Write the state which is carried over from one report step to
+         *         the next to a checkpoint. This includes the values which may
+         *         have been changed by TUNING.
+         */
+        template <class Restarter>
+        void serialize(Restarter& res)
+        {
+            res.serializeSectionBegin("AdaptiveTimeStepping");
+            auto& os = res.serializeStream();
+            Checkpoint::write(os, restartFactor_);
+            Checkpoint::write(os, growthFactor_);
+            Checkpoint::write(os, maxGrowth_);
+            Checkpoint::write(os, maxTimeStep_);
+            Checkpoint::write(os, suggestedNextTimestep_);
+            Checkpoint::write(os, timestepAfterEvent_);
+            timeStepControl_->serialize(os);
+            res.serializeSectionEnd();
+        }
+
+        /** \brief Restore the state written by serialize(). */
+        template <class Restarter>
+        void deserialize(Restarter& res)
+        {
+            res.deserializeSectionBegin("AdaptiveTimeStepping");
+            auto& is = res.deserializeStream();
+            Checkpoint::read(is, restartFactor_);
+            Checkpoint::read(is, growthFactor_);
+            Checkpoint::read(is, maxGrowth_);
+            Checkpoint::read(is, maxTimeStep_);
+            Checkpoint::read(is, suggestedNextTimestep_);
+            Checkpoint::read(is, timestepAfterEvent_);
+            timeStepControl_->deserialize(is);
+            res.deserializeSectionEnd();
+        }
+
 
     protected:
         void init_()
@@ -502,6 +572,11 @@ namespace Opm {
                 const double growthrate = EWOMS_GET_PARAM(TypeTag, double, TimeStepControlGrowthRate); // 1.25
                 timeStepControl_ = TimeStepControlType(new SimpleIterationCountTimeStepControl(iterations, decayrate, growthrate));
             }
+            else if (control == "costaware") {
+                const int historySize = EWOMS_GET_PARAM(TypeTag, int, TimeStepControlHistorySize); // 8
+                costControl_ = new CostAwareTimeStepControl(historySize, restartFactor_, maxGrowth_);
+                timeStepControl_ = TimeStepControlType(costControl_);
+            }
             else if (control == "hardcoded") {
                 const std::string filename = EWOMS_GET_PARAM(TypeTag, std::string, TimeStepControlFileName); // "timesteps"
                 timeStepControl_ = TimeStepControlType(new HardcodedTimeStepControl(filename));
@@ -573,6 +648,7 @@ namespace Opm {
 
         SimulatorReport failureReport_;       //!< statistics for the failed substeps of the last timestep
         TimeStepControlType timeStepControl_; //!< time step control object
+        CostAwareTimeStepControl* costControl_ = nullptr; //!< timeStepControl_ if it is cost aware, nullptr otherwise
         double restartFactor_;               //!< factor to multiply time step with when solver fails to converge
         double growthFactor_;                //!< factor to multiply time step when solver recovered from failed convergence
         double maxGrowth_;                   //!< factor that limits the maximum growth of a time step
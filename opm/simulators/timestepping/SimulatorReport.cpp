@@ -41,6 +41,9 @@ namespace Opm
           total_linearizations( 0 ),
           total_newton_iterations( 0 ),
           total_linear_iterations( 0 ),
+          total_local_linearizations( 0 ),
+          local_linearization_cells( 0.0 ),
+          total_local_solve_failures( 0 ),
           converged(false),
           verbose_(verbose)
     {
@@ -61,6 +64,9 @@ namespace Opm
         total_linearizations += sr.total_linearizations;
         total_newton_iterations += sr.total_newton_iterations;
         total_linear_iterations += sr.total_linear_iterations;
+        total_local_linearizations += sr.total_local_linearizations;
+        local_linearization_cells += sr.local_linearization_cells;
+        total_local_solve_failures += sr.total_local_solve_failures;
     }
 
     void SimulatorReport::report(std::ostream& os)
@@ -89,6 +95,9 @@ namespace Opm
                << " ("  << std::fixed << std::setprecision(3) << std::setw(6) << assemble_time << " sec), "
                << "linear its = " << std::setw(3) << total_linear_iterations
                << " ("  << std::fixed << std::setprecision(3) << std::setw(6) << linear_solve_time << " sec)";
+            if (total_local_linearizations != 0) {
+                ss << ", local linearizations = " << std::setw(2) << total_local_linearizations;
+            }
         }
     }
 
@@ -141,6 +150,26 @@ namespace Opm
                 os << " Output write time (seconds): " << t;
                 os << std::endl;
 
+                // the stages of the sequential implicit method include the
+                // assembly, linear solve and update times above
+                t = pressure_time + (failureReport ? failureReport->pressure_time : 0.0);
+                if (t > 0.0) {
+                    os << " Pressure time (seconds):     " << t;
+                    if (failureReport) {
+                        os << " (Failed: " << failureReport->pressure_time << "; "
+                           << 100*failureReport->pressure_time/t << "%)";
+                    }
+                    os << std::endl;
+
+                    t = transport_time + (failureReport ? failureReport->transport_time : 0.0);
+                    os << " Transport time (seconds):    " << t;
+                    if (failureReport) {
+                        os << " (Failed: " << failureReport->transport_time << "; "
+                           << 100*failureReport->transport_time/t << "%)";
+                    }
+                    os << std::endl;
+                }
+
             }
 
             int n = total_well_iterations + (failureReport ? failureReport->total_well_iterations : 0);
@@ -174,6 +203,18 @@ namespace Opm
                    << 100.0*failureReport->total_linear_iterations/n << "%)";
             }
             os << std::endl;
+
+            n = total_local_linearizations + (failureReport ? failureReport->total_local_linearizations : 0);
+            if (n > 0) {
+                // a local linearization of a fraction of the cells replaces the
+                // same fraction of the work of a global linearization and solve
+                const double cells = local_linearization_cells + (failureReport ? failureReport->local_linearization_cells : 0.0);
+                const int failures = total_local_solve_failures + (failureReport ? failureReport->total_local_solve_failures : 0);
+                os << "Overall Local Linearizations: " << n
+                   << " (work of " << std::fixed << std::setprecision(2) << cells << " global ones; "
+                   << failures << " local solves rejected)";
+                os << std::endl;
+            }
         }
     }
 
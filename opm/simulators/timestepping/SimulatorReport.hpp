@@ -43,6 +43,13 @@ namespace Opm
         unsigned int total_newton_iterations;
         unsigned int total_linear_iterations;
 
+        // Newton iterations restricted to the cells which violate the CNV
+        // criterion: the number of linearizations, their sum of the number of
+        // cells relative to the whole grid and the number of rejected solves.
+        unsigned int total_local_linearizations;
+        double local_linearization_cells;
+        unsigned int total_local_solve_failures;
+
         bool converged;
 
         /// Default constructor initializing all times to 0.0.
@@ -19,6 +19,7 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include <config.h>
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -30,6 +31,7 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/parser/eclipse/Units/Units.hpp>
 #include <opm/simulators/timestepping/TimeStepControl.hpp>
+#include <opm/simulators/utils/Checkpoint.hpp>
 
 namespace Opm
 {
@@ -162,6 +164,18 @@ namespace Opm
         }
     }
 
+    void PIDTimeStepControl::
+    serialize( std::ostream& os ) const
+    {
+        Checkpoint::write( os, errors_ );
+    }
+
+    void PIDTimeStepControl::
+    deserialize( std::istream& is )
+    {
+        Checkpoint::read( is, errors_ );
+    }
+
 
 
     ////////////////////////////////////////////////////////////
@@ -197,4 +211,224 @@ namespace Opm
         return std::min(dtEstimatePID, dtEstimateIter);
     }
 
+
+
+    ////////////////////////////////////////////////////////////
+    //
+    //  CostAwareTimeStepControl  Implementation
+    //
+    ////////////////////////////////////////////////////////////
+
+    CostAwareTimeStepControl::
+    CostAwareTimeStepControl( const int historySize,
+                              const double restartFactor,
+                              const double maxGrowth,
+                              const bool verbose )
+        : historySize_( std::max( historySize, 2 ) )
+        , restartFactor_( restartFactor )
+        , maxGrowth_( maxGrowth )
+        , verbose_( verbose )
+        , usefulWork_( 0.0 )
+        , wastedWork_( 0.0 )
+        , numFailures_( 0 )
+    {
+        if( restartFactor_ <= 0.0 || restartFactor_ >= 1.0 ) {
+            OPM_THROW(std::runtime_error,"CostAwareTimeStepControl: restart factor should be in (0, 1) " << restartFactor_ );
+        }
+        if( maxGrowth_ < 1.0 ) {
+            OPM_THROW(std::runtime_error,"CostAwareTimeStepControl: max growth should be >= 1 " << maxGrowth_ );
+        }
+    }
+
+    void CostAwareTimeStepControl::
+    recordSubStep( const SubStepCost& cost )
+    {
+        if( cost.dt <= 0.0 ) {
+            return;
+        }
+
+        if( cost.converged ) {
+            usefulWork_ += cost.wallTime;
+        }
+        else {
+            wastedWork_ += cost.wallTime;
+            ++numFailures_;
+        }
+
+        history_.push_back( cost );
+        while( history_.size() > historySize_ ) {
+            history_.pop_front();
+        }
+    }
+
+    void CostAwareTimeStepControl::
+    resetStatistics()
+    {
+        usefulWork_ = 0.0;
+        wastedWork_ = 0.0;
+        numFailures_ = 0;
+    }
+
+    void CostAwareTimeStepControl::
+    serialize( std::ostream& os ) const
+    {
+        Checkpoint::write( os, history_ );
+        Checkpoint::write( os, usefulWork_ );
+        Checkpoint::write( os, wastedWork_ );
+        Checkpoint::write( os, numFailures_ );
+    }
+
+    void CostAwareTimeStepControl::
+    deserialize( std::istream& is )
+    {
+        Checkpoint::read( is, history_ );
+        Checkpoint::read( is, usefulWork_ );
+        Checkpoint::read( is, wastedWork_ );
+        Checkpoint::read( is, numFailures_ );
+    }
+
+    double CostAwareTimeStepControl::
+    workUnits_( const SubStepCost& cost )
+    {
+        // one linearization and linear solve per Newton iteration, plus the
+        // linear iterations themselves and the local well solves.
+        return (cost.newtonIterations + 1) + 0.1 * cost.linearIterations + 0.01 * cost.wellIterations;
+    }
+
+    void CostAwareTimeStepControl::
+    fitCostModel_( double& k, double& alpha ) const
+    {
+        // default: cost grows with the square root of the step size, which
+        // is what the iteration count of a typical Newton solve does
+        alpha = 0.5;
+        k = 0.0;
+
+        // the wall time is only usable if all converged entries measured it
+        bool useWallTime = true;
+        int n = 0;
+        for( const auto& entry : history_ ) {
+            if( entry.converged ) {
+                ++n;
+                useWallTime = useWallTime && entry.wallTime > 0.0;
+            }
+        }
+        if( n == 0 ) {
+            return;
+        }
+
+        // least squares fit of log(w) = log(k) + alpha * log(dt)
+        double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+        for( const auto& entry : history_ ) {
+            if( !entry.converged ) {
+                continue;
+            }
+            const double x = std::log( entry.dt );
+            const double y = std::log( useWallTime ? entry.wallTime : workUnits_( entry ) );
+            sx += x;
+            sy += y;
+            sxx += x*x;
+            sxy += x*y;
+        }
+
+        const double denom = n*sxx - sx*sx;
+        if( n > 1 && denom > 1e-8*n*n ) {
+            // clamp the exponent to something physically sensible, a noisy
+            // history should not make the controller run away
+            alpha = std::min( std::max( (n*sxy - sx*sy) / denom, 0.0 ), 2.0 );
+        }
+        k = std::exp( (sy - alpha*sx) / n );
+    }
+
+    double CostAwareTimeStepControl::
+    smallestFailedStep_() const
+    {
+        double dtFail = -1.0;
+        for( const auto& entry : history_ ) {
+            if( !entry.converged && (dtFail < 0.0 || entry.dt < dtFail) ) {
+                dtFail = entry.dt;
+            }
+        }
+        return dtFail;
+    }
+
+    double CostAwareTimeStepControl::
+    averageWaste_() const
+    {
+        double waste = 0.0;
+        int n = 0;
+        for( const auto& entry : history_ ) {
+            if( !entry.converged ) {
+                waste += entry.wallTime > 0.0 ? entry.wallTime : workUnits_( entry );
+                ++n;
+            }
+        }
+        return n > 0 ? waste / n : 0.0;
+    }
+
+    double CostAwareTimeStepControl::
+    expectedEfficiency( const double dt ) const
+    {
+        double k, alpha;
+        fitCostModel_( k, alpha );
+        if( k <= 0.0 || dt <= 0.0 ) {
+            return 0.0;
+        }
+
+        double cost = k * std::pow( dt, alpha );
+
+        // a failure costs the wasted work of the attempt in addition to the
+        // work of the retried step. The failure probability is modelled to
+        // rise steeply when approaching the smallest recently failed dt.
+        const double dtFail = smallestFailedStep_();
+        if( dtFail > 0.0 ) {
+            const double pFail = std::min( std::pow( dt / dtFail, 4 ), 1.0 );
+            cost += pFail * averageWaste_();
+        }
+
+        return dt / cost;
+    }
+
+    double CostAwareTimeStepControl::
+    computeTimeStepSize( const double dt, const int /* iterations */, const RelativeChangeInterface& /* relChange */, const double /*simulationTimeElapsed */) const
+    {
+        if( history_.empty() ) {
+            return dt;
+        }
+
+        // evaluate a small set of candidate step sizes around the current one
+        static const double factors[] = { 0.5, 0.7, 1.0, 1.4, 2.0, 3.0 };
+        double bestDt = dt;
+        double bestEfficiency = expectedEfficiency( dt );
+        for( const double factor : factors ) {
+            const double candidate = dt * std::min( factor, maxGrowth_ );
+            const double efficiency = expectedEfficiency( candidate );
+            if( efficiency > bestEfficiency ) {
+                bestEfficiency = efficiency;
+                bestDt = candidate;
+            }
+        }
+
+        if( verbose_ )
+            std::cout << "Computed step size (cost): " << unit::convert::to( bestDt, unit::day ) << " (days), expected efficiency "
+                      << bestEfficiency << std::endl;
+
+        return bestDt;
+    }
+
+    double CostAwareTimeStepControl::
+    computeTimeStepSizeAfterFailure( const double dt ) const
+    {
+        // cut at least like the plain restart factor does, such that the
+        // number of allowed restarts suffices. if a recently converged step
+        // is even smaller, retry with the largest such step
+        const double newDt = restartFactor_ * dt;
+        double lastGood = -1.0;
+        for( const auto& entry : history_ ) {
+            if( entry.converged && entry.dt < newDt ) {
+                lastGood = std::max( lastGood, entry.dt );
+            }
+        }
+        return lastGood > 0.0 ? lastGood : newDt;
+    }
+
 } // end namespace Opm
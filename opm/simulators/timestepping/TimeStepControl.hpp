@@ -21,6 +21,7 @@
 #ifndef OPM_TIMESTEPCONTROL_HEADER_INCLUDED
 #define OPM_TIMESTEPCONTROL_HEADER_INCLUDED
 
+#include <deque>
 #include <vector>
 
 #include <boost/any.hpp>
@@ -84,6 +85,12 @@ namespace Opm
         /// \brief \copydoc TimeStepControlInterface::computeTimeStepSize
         double computeTimeStepSize( const double dt, const int /* iterations */, const RelativeChangeInterface& relativeChange, const double /*simulationTimeElapsed */ ) const;
 
+        /// \brief \copydoc TimeStepControlInterface::serialize
+        void serialize( std::ostream& os ) const;
+
+        /// \brief \copydoc TimeStepControlInterface::deserialize
+        void deserialize( std::istream& is );
+
     protected:
         const double tol_;
         mutable std::vector< double > errors_;
@@ -117,6 +124,100 @@ namespace Opm
         const int     target_iterations_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    ///
+    ///  Cost aware adaptive time step control.
+    ///
+    ///  Keeps a short history of the work spent on the last substeps (wall time, Newton and
+    ///  linear iterations, well iterations and the work thrown away by chopped substeps) and
+    ///  chooses the next time step size such that the expected simulated time per second of
+    ///  compute time is maximized. The cost of a substep is modelled as  w(dt) = k * dt^alpha,
+    ///  where k and alpha are fitted to the converged substeps in the history, and failures
+    ///  enter through an expected penalty that grows as dt approaches the smallest recently
+    ///  failed step size.
+    ///
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class CostAwareTimeStepControl : public TimeStepControlInterface
+    {
+    public:
+        /// Work spent on a single (converged or failed) substep.
+        struct SubStepCost
+        {
+            double dt = 0.0;            //!< attempted time step size
+            double wallTime = 0.0;      //!< wall time spent in the nonlinear solver (seconds)
+            int newtonIterations = 0;
+            int linearIterations = 0;
+            int wellIterations = 0;
+            bool converged = true;
+        };
+
+        /// \brief constructor
+        /// \param historySize        number of substeps kept in the history
+        /// \param restartFactor      smallest factor applied to the time step after a failure
+        /// \param maxGrowth          largest factor the time step may grow with in one substep
+        /// \param verbose            if true get some output (default = false)
+        CostAwareTimeStepControl( const int historySize = 8,
+                                  const double restartFactor = 0.33,
+                                  const double maxGrowth = 3.0,
+                                  const bool verbose = false );
+
+        /// \brief register the work spent on the last substep
+        void recordSubStep( const SubStepCost& cost );
+
+        /// \brief \copydoc TimeStepControlInterface::computeTimeStepSize
+        double computeTimeStepSize( const double dt, const int /* iterations */, const RelativeChangeInterface& /*relativeChange */, const double /*simulationTimeElapsed */ ) const;
+
+        /// \brief compute the time step size to retry with after a failed substep of size dt
+        ///        that has already been registered with recordSubStep(). This is at most
+        ///        restartFactor*dt, or the largest recently converged step below it.
+        double computeTimeStepSizeAfterFailure( const double dt ) const;
+
+        /// \brief expected simulated time per second of wall time for a step of size dt
+        double expectedEfficiency( const double dt ) const;
+
+        /// \brief wall time spent on converged substeps since the last call to resetStatistics()
+        double usefulWork() const { return usefulWork_; }
+
+        /// \brief wall time thrown away by failed substeps since the last call to resetStatistics()
+        double wastedWork() const { return wastedWork_; }
+
+        /// \brief number of failed substeps since the last call to resetStatistics()
+        int numFailures() const { return numFailures_; }
+
+        /// \brief reset the accumulated useful and wasted work, e.g. at the start of a report step
+        void resetStatistics();
+
+        /// \brief \copydoc TimeStepControlInterface::serialize
+        void serialize( std::ostream& os ) const;
+
+        /// \brief \copydoc TimeStepControlInterface::deserialize
+        void deserialize( std::istream& is );
+
+    protected:
+        /// fit the cost model w(dt) = k * dt^alpha to the converged substeps of the history
+        void fitCostModel_( double& k, double& alpha ) const;
+
+        /// smallest failed time step in the history, or a negative value if none failed
+        double smallestFailedStep_() const;
+
+        /// average wall time lost per failure in the history
+        double averageWaste_() const;
+
+        /// proxy for the cost of a substep when no wall time was measured
+        static double workUnits_( const SubStepCost& cost );
+
+        const std::size_t historySize_;
+        const double restartFactor_;
+        const double maxGrowth_;
+        const bool verbose_;
+
+        std::deque<SubStepCost> history_;
+
+        double usefulWork_;
+        double wastedWork_;
+        int numFailures_;
+    };
+
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
     ///
     ///  HardcodedTimeStepControl
@@ -19,6 +19,8 @@
 #ifndef OPM_TIMESTEPCONTROLINTERFACE_HEADER_INCLUDED
 #define OPM_TIMESTEPCONTROLINTERFACE_HEADER_INCLUDED
 
+#include <istream>
+#include <ostream>
 
 namespace Opm
 {
@@ -58,6 +60,12 @@ namespace Opm
         /// \return suggested time step size for the next step
         virtual double computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& relativeChange , const double simulationTimeElapsed) const = 0;
 
+        /// write the state which the control keeps between time steps to a binary checkpoint
+        virtual void serialize( std::ostream& /* os */ ) const {}
+
+        /// restore the state written by serialize()
+        virtual void deserialize( std::istream& /* is */ ) {}
+
         /// virtual destructor (empty)
         virtual ~TimeStepControlInterface () {}
     };
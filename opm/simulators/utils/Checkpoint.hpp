@@ -0,0 +1,351 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_CHECKPOINT_HEADER_INCLUDED
+#define OPM_CHECKPOINT_HEADER_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+namespace Checkpoint
+{
+
+    // The values are written in the native binary representation, since a
+    // checkpoint is only read again by the same build on the same machine
+    // type and decomposition.
+
+    template <class T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+    write(std::ostream& os, const T& value);
+    template <class T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+    read(std::istream& is, T& value);
+
+    inline void write(std::ostream& os, const std::string& value);
+    inline void read(std::istream& is, std::string& value);
+
+    template <class T1, class T2>
+    void write(std::ostream& os, const std::pair<T1, T2>& value);
+    template <class T1, class T2>
+    void read(std::istream& is, std::pair<T1, T2>& value);
+
+    template <class T, class A>
+    void write(std::ostream& os, const std::vector<T, A>& value);
+    template <class T, class A>
+    void read(std::istream& is, std::vector<T, A>& value);
+
+    inline void write(std::ostream& os, const std::vector<bool>& value);
+    inline void read(std::istream& is, std::vector<bool>& value);
+
+    template <class T>
+    void write(std::ostream& os, const std::deque<T>& value);
+    template <class T>
+    void read(std::istream& is, std::deque<T>& value);
+
+    template <class K, class V, class C, class A>
+    void write(std::ostream& os, const std::map<K, V, C, A>& value);
+    template <class K, class V, class C, class A>
+    void read(std::istream& is, std::map<K, V, C, A>& value);
+
+    namespace Detail
+    {
+        inline void writeBytes(std::ostream& os, const void* data, std::size_t size)
+        {
+            os.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        }
+
+        inline void readBytes(std::istream& is, void* data, std::size_t size)
+        {
+            is.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+            if (static_cast<std::size_t>(is.gcount()) != size)
+                throw std::runtime_error("Unexpected end of checkpoint data");
+        }
+
+        inline std::uint64_t readSize(std::istream& is)
+        {
+            std::uint64_t size = 0;
+            readBytes(is, &size, sizeof(size));
+            return size;
+        }
+    } // namespace Detail
+
+    template <class T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+    write(std::ostream& os, const T& value)
+    {
+        Detail::writeBytes(os, &value, sizeof(T));
+    }
+
+    template <class T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type
+    read(std::istream& is, T& value)
+    {
+        Detail::readBytes(is, &value, sizeof(T));
+    }
+
+    inline void write(std::ostream& os, const std::string& value)
+    {
+        write(os, static_cast<std::uint64_t>(value.size()));
+        Detail::writeBytes(os, value.data(), value.size());
+    }
+
+    inline void read(std::istream& is, std::string& value)
+    {
+        value.resize(Detail::readSize(is));
+        if (!value.empty())
+            Detail::readBytes(is, &value[0], value.size());
+    }
+
+    template <class T1, class T2>
+    void write(std::ostream& os, const std::pair<T1, T2>& value)
+    {
+        write(os, value.first);
+        write(os, value.second);
+    }
+
+    template <class T1, class T2>
+    void read(std::istream& is, std::pair<T1, T2>& value)
+    {
+        read(is, value.first);
+        read(is, value.second);
+    }
+
+    template <class T, class A>
+    void write(std::ostream& os, const std::vector<T, A>& value)
+    {
+        write(os, static_cast<std::uint64_t>(value.size()));
+        if (std::is_trivially_copyable<T>::value) {
+            Detail::writeBytes(os, value.data(), value.size()*sizeof(T));
+        }
+        else {
+            for (const auto& v : value)
+                write(os, v);
+        }
+    }
+
+    template <class T, class A>
+    void read(std::istream& is, std::vector<T, A>& value)
+    {
+        value.resize(Detail::readSize(is));
+        if (std::is_trivially_copyable<T>::value) {
+            Detail::readBytes(is, value.data(), value.size()*sizeof(T));
+        }
+        else {
+            for (auto& v : value)
+                read(is, v);
+        }
+    }
+
+    inline void write(std::ostream& os, const std::vector<bool>& value)
+    {
+        write(os, static_cast<std::uint64_t>(value.size()));
+        for (const bool v : value)
+            write(os, static_cast<char>(v));
+    }
+
+    inline void read(std::istream& is, std::vector<bool>& value)
+    {
+        value.resize(Detail::readSize(is));
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            char v;
+            read(is, v);
+            value[i] = v;
+        }
+    }
+
+    template <class T>
+    void write(std::ostream& os, const std::deque<T>& value)
+    {
+        write(os, static_cast<std::uint64_t>(value.size()));
+        for (const auto& v : value)
+            write(os, v);
+    }
+
+    template <class T>
+    void read(std::istream& is, std::deque<T>& value)
+    {
+        value.resize(Detail::readSize(is));
+        for (auto& v : value)
+            read(is, v);
+    }
+
+    template <class K, class V, class C, class A>
+    void write(std::ostream& os, const std::map<K, V, C, A>& value)
+    {
+        write(os, static_cast<std::uint64_t>(value.size()));
+        for (const auto& v : value) {
+            write(os, v.first);
+            write(os, v.second);
+        }
+    }
+
+    template <class K, class V, class C, class A>
+    void read(std::istream& is, std::map<K, V, C, A>& value)
+    {
+        value.clear();
+        const std::uint64_t size = Detail::readSize(is);
+        for (std::uint64_t i = 0; i < size; ++i) {
+            K key;
+            read(is, key);
+            read(is, value[key]);
+        }
+    }
+
+    /// The 64-bit FNV-1a hash of a byte sequence. It identifies the input
+    /// deck a checkpoint was written for.
+    inline std::uint64_t hash(const std::string& data)
+    {
+        std::uint64_t result = 14695981039346656037ULL;
+        for (const char c : data) {
+            result ^= static_cast<unsigned char>(c);
+            result *= 1099511628211ULL;
+        }
+        return result;
+    }
+
+} // namespace Checkpoint
+
+
+    /// A binary checkpoint file of a single process.
+    ///
+    /// It offers the section interface of the eWoms restarter, such that the
+    /// serialize() and deserialize() methods of the problem and its
+    /// sub-objects can be used with it. The data is collected in memory and
+    /// written to disk by a background thread, so the simulation continues
+    /// while the file is written. The file is first written under a
+    /// temporary name and then renamed, such that an interrupted write never
+    /// destroys the previous checkpoint.
+    class CheckpointFile
+    {
+    public:
+        ~CheckpointFile()
+        {
+            if (pending_.valid())
+                pending_.wait();
+        }
+
+        /// Start collecting the data of a new checkpoint.
+        void serializeBegin()
+        {
+            out_.str(std::string());
+            out_.clear();
+            Checkpoint::write(out_, magic_());
+        }
+
+        void serializeSectionBegin(const std::string& cookie)
+        { Checkpoint::write(out_, cookie); }
+
+        std::ostream& serializeStream()
+        { return out_; }
+
+        void serializeSectionEnd()
+        { }
+
+        /// Write the collected data to the given file in the background.
+        /// The previous write is finished first.
+        void serializeEnd(const std::string& fileName)
+        {
+            wait();
+            pending_ = std::async(std::launch::async,
+                                  [fileName](const std::string& data)
+                                  {
+                                      const std::string tmpFileName = fileName + ".tmp";
+                                      {
+                                          std::ofstream file(tmpFileName, std::ios::binary);
+                                          file.write(data.data(), data.size());
+                                          if (!file)
+                                              throw std::runtime_error("Could not write checkpoint file " + tmpFileName);
+                                      }
+                                      if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+                                          throw std::runtime_error("Could not rename " + tmpFileName + " to " + fileName);
+                                  },
+                                  out_.str());
+        }
+
+        /// Wait until the last checkpoint has been written. Errors of the
+        /// background write are thrown here.
+        void wait()
+        {
+            if (pending_.valid())
+                pending_.get();
+        }
+
+        /// Read a checkpoint written by serializeEnd().
+        void deserializeBegin(const std::string& fileName)
+        {
+            std::ifstream file(fileName, std::ios::binary);
+            if (!file)
+                throw std::runtime_error("Could not open checkpoint file " + fileName);
+            std::ostringstream data;
+            data << file.rdbuf();
+            in_.str(data.str());
+            in_.clear();
+
+            std::uint64_t magic = 0;
+            Checkpoint::read(in_, magic);
+            if (magic != magic_())
+                throw std::runtime_error(fileName + " is not a checkpoint file");
+        }
+
+        void deserializeSectionBegin(const std::string& cookie)
+        {
+            std::string buf;
+            Checkpoint::read(in_, buf);
+            if (buf != cookie)
+                throw std::runtime_error("Expected section '" + cookie + "' in the checkpoint, found '" + buf + "'");
+        }
+
+        std::istream& deserializeStream()
+        { return in_; }
+
+        void deserializeSectionEnd()
+        { }
+
+        void deserializeEnd()
+        {
+            if (in_.peek() != std::char_traits<char>::eof())
+                throw std::runtime_error("Encountered unread values in the checkpoint");
+            in_.str(std::string());
+        }
+
+    private:
+        static std::uint64_t magic_()
+        { return 0x31544b434d504fULL; } // "OPMCKT1"
+
+        std::ostringstream out_;
+        std::istringstream in_;
+        std::future<void> pending_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_CHECKPOINT_HEADER_INCLUDED
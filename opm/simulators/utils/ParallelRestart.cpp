@@ -90,19 +90,22 @@
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableSchema.hpp>
 #include <opm/parser/eclipse/EclipseState/Util/IOrderSet.hpp>
-#include <dune/common/parallel/mpitraits.hh>
+#include <opm/common/ErrorMacros.hpp>
+
+#include <algorithm>
+#include <cstring>
 
 #define HANDLE_AS_POD(T) \
   std::size_t packSize(const T& data, Dune::MPIHelper::MPICommunicator comm) \
   { \
       return packSize(data, comm, std::integral_constant<bool,true>()); \
   } \
-  void pack(const T& data, std::vector<char>& buffer, int& position, \
+  void pack(const T& data, std::vector<char>& buffer, std::size_t& position, \
             Dune::MPIHelper::MPICommunicator comm) \
   { \
       pack(data, buffer, position, comm, std::integral_constant<bool,true>()); \
   } \
-  void unpack(T& data, std::vector<char>& buffer, int& position, \
+  void unpack(T& data, std::vector<char>& buffer, std::size_t& position, \
               Dune::MPIHelper::MPICommunicator comm) \
   { \
       unpack(data, buffer, position, comm, std::integral_constant<bool,true>()); \
@@ -110,6 +113,31 @@
 
 namespace
 {
+// The buffers are only exchanged between processes of the same build on
+// the same machine type, hence the plain binary representation is packed.
+// The buffer grows as needed, such that it does not have to be sized by
+// packSize() beforehand.
+void writeBytes(const void* data, std::size_t size,
+                std::vector<char>& buffer, std::size_t& position)
+{
+    if (buffer.size() < position + size)
+        buffer.resize(std::max(position + size, 2*buffer.size()));
+    if (size > 0)
+        std::memcpy(buffer.data() + position, data, size);
+    position += size;
+}
+
+void readBytes(void* data, std::size_t size,
+               const std::vector<char>& buffer, std::size_t& position)
+{
+    if (position + size > buffer.size())
+        OPM_THROW(std::runtime_error, "Unpacking " << size << " bytes at position "
+                  << position << " exceeds the buffer size " << buffer.size());
+    if (size > 0)
+        std::memcpy(data, buffer.data() + position, size);
+    position += size;
+}
+
 template<template<class, class> class Map, class Type, class Key>
 std::pair<std::vector<Type>, std::vector<std::pair<Key, std::vector<int>>>>
 splitDynMap(const Map<Key, Opm::DynamicState<Type>>& map)
@@ -201,7 +229,7 @@ std::size_t packSizeDynState(const Opm::DynamicState<T>& data,
 template<class T>
 void packDynState(const Opm::DynamicState<T>& data,
                   std::vector<char>& buffer,
-                  int& position,
+                  std::size_t& position,
                   Dune::MPIHelper::MPICommunicator comm)
 {
     auto split = splitDynState(data);
@@ -212,7 +240,7 @@ void packDynState(const Opm::DynamicState<T>& data,
 template<template<class, class> class Map, class Type, class Key>
 void packDynMap(const Map<Key, Opm::DynamicState<Type>>& data,
                 std::vector<char>& buffer,
-                int& position,
+                std::size_t& position,
                 Dune::MPIHelper::MPICommunicator comm)
 {
     auto split = splitDynMap<Map,Type,Key>(data);
@@ -223,7 +251,7 @@ void packDynMap(const Map<Key, Opm::DynamicState<Type>>& data,
 template<class T>
 void unpackDynState(Opm::DynamicState<T>& data,
                     std::vector<char>& buffer,
-                    int& position,
+                    std::size_t& position,
                     Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<T> unique;
@@ -236,7 +264,7 @@ void unpackDynState(Opm::DynamicState<T>& data,
 template<template<class, class> class Map, class Type, class Key>
 void unpackDynMap(Map<Key, Opm::DynamicState<Type>>& data,
                   std::vector<char>& buffer,
-                  int& position,
+                  std::size_t& position,
                   Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Type> unique;
@@ -263,16 +291,8 @@ template<class T>
 std::size_t packSize(const T*, std::size_t l, Dune::MPIHelper::MPICommunicator comm,
                      std::integral_constant<bool, true>)
 {
-#if HAVE_MPI
-    int size;
-    MPI_Pack_size(1, Dune::MPITraits<std::size_t>::getType(), comm, &size);
-    std::size_t totalSize = size;
-    MPI_Pack_size(l, Dune::MPITraits<T>::getType(), comm, &size);
-    return totalSize + size;
-#else
     (void) comm;
-    return l-l;
-#endif
+    return sizeof(std::size_t) + l*sizeof(T);
 }
 
 template<class T>
@@ -292,14 +312,8 @@ template<class T>
 std::size_t packSize(const T&, Dune::MPIHelper::MPICommunicator comm,
                      std::integral_constant<bool, true>)
 {
-#if HAVE_MPI
-    int size{};
-    MPI_Pack_size(1, Dune::MPITraits<T>::getType(), comm, &size);
-    return size;
-#else
     (void) comm;
-    return 0;
-#endif
+    return sizeof(T);
 }
 
 template<class T>
@@ -400,17 +414,8 @@ std::size_t packSize(const DynamicVector<T>& data, Dune::MPIHelper::MPICommunica
 
 std::size_t packSize(const char* str, Dune::MPIHelper::MPICommunicator comm)
 {
-#if HAVE_MPI
-    int size;
-    MPI_Pack_size(1, Dune::MPITraits<std::size_t>::getType(), comm, &size);
-    int totalSize = size;
-    MPI_Pack_size(strlen(str)+1, MPI_CHAR, comm, &size);
-    return totalSize + size;
-#else
-    (void) str;
     (void) comm;
-    return 0;
-#endif
+    return sizeof(std::size_t) + strlen(str) + 1;
 }
 
 std::size_t packSize(const std::string& str, Dune::MPIHelper::MPICommunicator comm)
@@ -1962,69 +1967,53 @@ std::size_t packSize(const FaultCollection& data,
 ////// pack routines
 
 template<class T>
-void pack(const T*, std::size_t, std::vector<char>&, int&,
+void pack(const T*, std::size_t, std::vector<char>&, std::size_t&,
           Dune::MPIHelper::MPICommunicator, std::integral_constant<bool, false>)
 {
     OPM_THROW(std::logic_error, "Packing not (yet) supported for this non-pod type.");
 }
 
 template<class T>
-void pack(const T* data, std::size_t l, std::vector<char>& buffer, int& position,
+void pack(const T* data, std::size_t l, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm,
           std::integral_constant<bool, true>)
 {
-#if HAVE_MPI
-    MPI_Pack(&l, 1, Dune::MPITraits<std::size_t>::getType(), buffer.data(),
-             buffer.size(), &position, comm);
-    MPI_Pack(data, l, Dune::MPITraits<T>::getType(), buffer.data(),
-             buffer.size(), &position, comm);
-#else
-    (void) data;
     (void) comm;
-    (void) l;
-    (void) buffer;
-    (void) position;
-#endif
+    writeBytes(&l, sizeof(l), buffer, position);
+    writeBytes(data, l*sizeof(T), buffer, position);
 }
 
 template<class T>
-void pack(const T* data, std::size_t l, std::vector<char>& buffer, int& position,
+void pack(const T* data, std::size_t l, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data, l, buffer, position, comm, typename std::is_pod<T>::type());
 }
 
 template<class T>
-void pack(const T&, std::vector<char>&, int&,
+void pack(const T&, std::vector<char>&, std::size_t&,
           Dune::MPIHelper::MPICommunicator, std::integral_constant<bool, false>)
 {
     OPM_THROW(std::logic_error, "Packing not (yet) supported for this non-pod type.");
 }
 
 template<class T>
-void pack(const T& data, std::vector<char>& buffer, int& position,
+void pack(const T& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm, std::integral_constant<bool, true>)
 {
-#if HAVE_MPI
-    MPI_Pack(&data, 1, Dune::MPITraits<T>::getType(), buffer.data(),
-             buffer.size(), &position, comm);
-#else
-    (void) data;
     (void) comm;
-    (void) buffer;
-    (void) position;
-#endif
+    writeBytes(&data, sizeof(T), buffer, position);
 }
 
 template<class T>
-void pack(const T& data, std::vector<char>& buffer, int& position,
+void pack(const T& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data, buffer, position, comm, typename std::is_pod<T>::type());
 }
 
 template<class T1, class T2>
-void pack(const std::pair<T1,T2>& data, std::vector<char>& buffer, int& position,
+void pack(const std::pair<T1,T2>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.first, buffer, position, comm);
@@ -2032,7 +2021,7 @@ void pack(const std::pair<T1,T2>& data, std::vector<char>& buffer, int& position
 }
 
 template<class T, class A>
-void pack(const std::vector<T, A>& data, std::vector<char>& buffer, int& position,
+void pack(const std::vector<T, A>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     if (std::is_pod<T>::value)
@@ -2050,7 +2039,7 @@ void pack(const std::vector<T, A>& data, std::vector<char>& buffer, int& positio
 
 template<class K, class C, class A>
 void pack(const std::set<K,C,A>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.size(), buffer, position, comm);
@@ -2063,7 +2052,7 @@ void pack(const std::set<K,C,A>& data,
 
 template<class T, class H, class KE, class A>
 void pack(const std::unordered_set<T,H,KE,A>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.size(), buffer, position, comm);
@@ -2075,7 +2064,7 @@ void pack(const std::unordered_set<T,H,KE,A>& data,
 }
 
 template<class T, size_t N>
-void pack(const std::array<T,N>& data, std::vector<char>& buffer, int& position,
+void pack(const std::array<T,N>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     for (const T& entry : data)
@@ -2083,7 +2072,7 @@ void pack(const std::array<T,N>& data, std::vector<char>& buffer, int& position,
 }
 
 template<class A>
-void pack(const std::vector<bool,A>& data, std::vector<char>& buffer, int& position,
+void pack(const std::vector<bool,A>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.size(), buffer, position, comm);
@@ -2095,7 +2084,7 @@ void pack(const std::vector<bool,A>& data, std::vector<char>& buffer, int& posit
 
 template<std::size_t I = 0, typename Tuple>
 typename std::enable_if<I == std::tuple_size<Tuple>::value, void>::type
-pack_tuple_entry(const Tuple&, std::vector<char>&, int&,
+pack_tuple_entry(const Tuple&, std::vector<char>&, std::size_t&,
                       Dune::MPIHelper::MPICommunicator)
 {
 }
@@ -2103,7 +2092,7 @@ pack_tuple_entry(const Tuple&, std::vector<char>&, int&,
 template<std::size_t I = 0, typename Tuple>
 typename std::enable_if<I != std::tuple_size<Tuple>::value, void>::type
 pack_tuple_entry(const Tuple& tuple, std::vector<char>& buffer,
-                 int& position, Dune::MPIHelper::MPICommunicator comm)
+                 std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     pack(std::get<I>(tuple), buffer, position, comm);
     pack_tuple_entry<I+1>(tuple, buffer, position, comm);
@@ -2111,13 +2100,13 @@ pack_tuple_entry(const Tuple& tuple, std::vector<char>& buffer,
 
 template<class... Ts>
 void pack(const std::tuple<Ts...>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm)
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     pack_tuple_entry(data, buffer, position, comm);
 }
 
 template<class Key, class Value>
-void pack(const OrderedMap<Key, Value>& data, std::vector<char>& buffer, int& position,
+void pack(const OrderedMap<Key, Value>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getIndex(), buffer, position, comm);
@@ -2125,7 +2114,7 @@ void pack(const OrderedMap<Key, Value>& data, std::vector<char>& buffer, int& po
 }
 
 template<class T>
-void pack(const DynamicState<T>& data, std::vector<char>& buffer, int& position,
+void pack(const DynamicState<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.data(), buffer, position, comm);
@@ -2133,37 +2122,29 @@ void pack(const DynamicState<T>& data, std::vector<char>& buffer, int& position,
 }
 
 template<class T>
-void pack(const DynamicVector<T>& data, std::vector<char>& buffer, int& position,
+void pack(const DynamicVector<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.data(), buffer, position, comm);
 }
 
-void pack(const char* str, std::vector<char>& buffer, int& position,
+void pack(const char* str, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
-#if HAVE_MPI
-    std::size_t length = strlen(str)+1;
-    MPI_Pack(&length, 1, Dune::MPITraits<std::size_t>::getType(), buffer.data(),
-        buffer.size(), &position, comm);
-    MPI_Pack(str, strlen(str)+1, MPI_CHAR, buffer.data(), buffer.size(),
-         &position, comm);
-#else
-    (void) str;
     (void) comm;
-    (void) buffer;
-    (void) position;
-#endif
+    std::size_t length = strlen(str)+1;
+    writeBytes(&length, sizeof(length), buffer, position);
+    writeBytes(str, length, buffer, position);
 }
 
-void pack(const std::string& str, std::vector<char>& buffer, int& position,
+void pack(const std::string& str, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(str.c_str(), buffer, position, comm);
 }
 
 template<class T1, class T2, class C, class A>
-void pack(const std::map<T1,T2,C,A>& data, std::vector<char>& buffer, int& position,
+void pack(const std::map<T1,T2,C,A>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.size(), buffer, position, comm);
@@ -2175,7 +2156,7 @@ void pack(const std::map<T1,T2,C,A>& data, std::vector<char>& buffer, int& posit
 }
 
 template<class T1, class T2, class H, class P, class A>
-void pack(const std::unordered_map<T1,T2,H,P,A>& data, std::vector<char>& buffer, int& position,
+void pack(const std::unordered_map<T1,T2,H,P,A>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.size(), buffer, position, comm);
@@ -2188,12 +2169,12 @@ void pack(const std::unordered_map<T1,T2,H,P,A>& data, std::vector<char>& buffer
 
 
 template void pack(const std::map<Phase, Group::GroupInjectionProperties>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 
 
-void pack(const data::Well& data, std::vector<char>& buffer, int& position,
+void pack(const data::Well& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.rates, buffer, position, comm);
@@ -2206,7 +2187,7 @@ void pack(const data::Well& data, std::vector<char>& buffer, int& position,
     pack(data.current_control, buffer, position, comm);
 }
 
-void pack(const RestartKey& data, std::vector<char>& buffer, int& position,
+void pack(const RestartKey& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.key, buffer, position, comm);
@@ -2214,7 +2195,7 @@ void pack(const RestartKey& data, std::vector<char>& buffer, int& position,
     pack(data.required, buffer, position, comm);
 }
 
-void pack(const data::CellData& data, std::vector<char>& buffer, int& position,
+void pack(const data::CellData& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.dim, buffer, position, comm);
@@ -2222,7 +2203,7 @@ void pack(const data::CellData& data, std::vector<char>& buffer, int& position,
     pack(data.target, buffer, position, comm);
 }
 
-void pack(const data::Solution& data, std::vector<char>& buffer, int& position,
+void pack(const data::Solution& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     // Needs explicit conversion to a supported base type holding the data
@@ -2231,7 +2212,7 @@ void pack(const data::Solution& data, std::vector<char>& buffer, int& position,
          buffer, position, comm);
 }
 
-void pack(const data::WellRates& data, std::vector<char>& buffer, int& position,
+void pack(const data::WellRates& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     // Needs explicit conversion to a supported base type holding the data
@@ -2240,7 +2221,7 @@ void pack(const data::WellRates& data, std::vector<char>& buffer, int& position,
          buffer, position, comm);
 }
 
-void pack(const RestartValue& data, std::vector<char>& buffer, int& position,
+void pack(const RestartValue& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.solution, buffer, position, comm);
@@ -2248,7 +2229,7 @@ void pack(const RestartValue& data, std::vector<char>& buffer, int& position,
     pack(data.extra, buffer, position, comm);
 }
 
-void pack(const ThresholdPressure& data, std::vector<char>& buffer, int& position,
+void pack(const ThresholdPressure& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.active(), buffer, position, comm);
@@ -2258,13 +2239,13 @@ void pack(const ThresholdPressure& data, std::vector<char>& buffer, int& positio
 }
 
 
-void pack(const BCConfig& bc, std::vector<char>& buffer, int& position,
+void pack(const BCConfig& bc, std::vector<char>& buffer, std::size_t& position,
     Dune::MPIHelper::MPICommunicator comm)
 {
     pack(bc.faces(), buffer, position, comm);
 }
 
-void pack(const RockConfig& data, std::vector<char>& buffer, int& position,
+void pack(const RockConfig& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.active(), buffer, position, comm);
@@ -2276,33 +2257,33 @@ void pack(const RockConfig& data, std::vector<char>& buffer, int& position,
 }
 
 
-void pack(const NNC& data, std::vector<char>& buffer, int& position,
+void pack(const NNC& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.data(), buffer, position, comm);
 }
 
-void pack(const EDITNNC& data, std::vector<char>& buffer, int& position,
+void pack(const EDITNNC& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.data(), buffer, position, comm);
 }
 
-void pack(const Rock2dTable& data, std::vector<char>& buffer, int& position,
+void pack(const Rock2dTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.pvmultValues(), buffer, position, comm);
     pack(data.pressureValues(), buffer, position, comm);
 }
 
-void pack(const Rock2dtrTable& data, std::vector<char>& buffer, int& position,
+void pack(const Rock2dtrTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.transMultValues(), buffer, position, comm);
     pack(data.pressureValues(), buffer, position, comm);
 }
 
-void pack(const ColumnSchema& data, std::vector<char>& buffer, int& position,
+void pack(const ColumnSchema& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.name(), buffer, position, comm);
@@ -2312,13 +2293,13 @@ void pack(const ColumnSchema& data, std::vector<char>& buffer, int& position,
         pack(data.getDefaultValue(), buffer, position, comm);
 }
 
-void pack(const TableSchema& data, std::vector<char>& buffer, int& position,
+void pack(const TableSchema& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getColumns(), buffer, position, comm);
 }
 
-void pack(const TableColumn& data, std::vector<char>& buffer, int& position,
+void pack(const TableColumn& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.schema(), buffer, position, comm);
@@ -2328,7 +2309,7 @@ void pack(const TableColumn& data, std::vector<char>& buffer, int& position,
     pack(data.defaultCount(), buffer, position, comm);
 }
 
-void pack(const SimpleTable& data, std::vector<char>& buffer, int& position,
+void pack(const SimpleTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.schema(), buffer, position, comm);
@@ -2336,7 +2317,7 @@ void pack(const SimpleTable& data, std::vector<char>& buffer, int& position,
     pack(data.jfunc(), buffer, position, comm);
 }
 
-void pack(const TableContainer& data, std::vector<char>& buffer, int& position,
+void pack(const TableContainer& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.max(), buffer, position, comm);
@@ -2355,19 +2336,19 @@ void pack(const TableContainer& data, std::vector<char>& buffer, int& position,
     }
 }
 
-void pack(const Equil& data, std::vector<char>& buffer, int& position,
+void pack(const Equil& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.records(), buffer, position, comm);
 }
 
-void pack(const FoamConfig& data, std::vector<char>& buffer, int& position,
+void pack(const FoamConfig& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.records(), buffer, position, comm);
 }
 
-void pack(const InitConfig& data, std::vector<char>& buffer, int& position,
+void pack(const InitConfig& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getEquil(), buffer, position, comm);
@@ -2379,7 +2360,7 @@ void pack(const InitConfig& data, std::vector<char>& buffer, int& position,
     pack(data.getRestartRootName(), buffer, position, comm);
 }
 
-void pack(const SimulationConfig& data, std::vector<char>& buffer, int& position,
+void pack(const SimulationConfig& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getThresholdPressure(), buffer, position, comm);
@@ -2391,13 +2372,13 @@ void pack(const SimulationConfig& data, std::vector<char>& buffer, int& position
     pack(data.isThermal(), buffer, position, comm);
 }
 
-void pack(const TimeMap& data, std::vector<char>& buffer, int& position,
+void pack(const TimeMap& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.timeList(), buffer, position, comm);
 }
 
-void pack(const RestartConfig& data, std::vector<char>& buffer, int& position,
+void pack(const RestartConfig& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.ioConfig(), buffer, position, comm);
@@ -2409,7 +2390,7 @@ void pack(const RestartConfig& data, std::vector<char>& buffer, int& position,
     pack(data.saveKeywords(), buffer, position, comm);
 }
 
-void pack(const IOConfig& data, std::vector<char>& buffer, int& position,
+void pack(const IOConfig& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getWriteINITFile(), buffer, position, comm);
@@ -2426,19 +2407,19 @@ void pack(const IOConfig& data, std::vector<char>& buffer, int& position,
     pack(data.getEclCompatibleRST(), buffer, position, comm);
 }
 
-void pack(const Phases& data, std::vector<char>& buffer, int& position,
+void pack(const Phases& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getBits(), buffer, position, comm);
 }
 
-void pack(const EndpointScaling& data, std::vector<char>& buffer, int& position,
+void pack(const EndpointScaling& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getBits(), buffer, position, comm);
 }
 
-void pack(const UDQParams& data, std::vector<char>& buffer, int& position,
+void pack(const UDQParams& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.reseed(), buffer, position, comm);
@@ -2448,7 +2429,7 @@ void pack(const UDQParams& data, std::vector<char>& buffer, int& position,
     pack(data.cmpEpsilon(), buffer, position, comm);
 }
 
-void pack(const Runspec& data, std::vector<char>& buffer, int& position,
+void pack(const Runspec& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.phases(), buffer, position, comm);
@@ -2462,7 +2443,7 @@ void pack(const Runspec& data, std::vector<char>& buffer, int& position,
     pack(data.saturationFunctionControls(), buffer, position, comm);
 }
 
-void pack(const PvtxTable& data, std::vector<char>& buffer, int& position,
+void pack(const PvtxTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getOuterColumnSchema(), buffer, position, comm);
@@ -2473,49 +2454,49 @@ void pack(const PvtxTable& data, std::vector<char>& buffer, int& position,
     pack(data.getSaturatedTable(), buffer, position, comm);
 }
 
-void pack(const PvtgTable& data, std::vector<char>& buffer, int& position,
+void pack(const PvtgTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const PvtxTable&>(data), buffer, position, comm);
 }
 
-void pack(const PvtoTable& data, std::vector<char>& buffer, int& position,
+void pack(const PvtoTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const PvtxTable&>(data), buffer, position, comm);
 }
 
-void pack(const PvtwTable& data, std::vector<char>& buffer, int& position,
+void pack(const PvtwTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const std::vector<PVTWRecord>&>(data), buffer, position, comm);
 }
 
-void pack(const PvcdoTable& data, std::vector<char>& buffer, int& position,
+void pack(const PvcdoTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const std::vector<PVCDORecord>&>(data), buffer, position, comm);
 }
 
-void pack(const DensityTable& data, std::vector<char>& buffer, int& position,
+void pack(const DensityTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const std::vector<DENSITYRecord>&>(data), buffer, position, comm);
 }
 
-void pack(const ViscrefTable& data, std::vector<char>& buffer, int& position,
+void pack(const ViscrefTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const std::vector<VISCREFRecord>&>(data), buffer, position, comm);
 }
 
-void pack(const WatdentTable& data, std::vector<char>& buffer, int& position,
+void pack(const WatdentTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const std::vector<WATDENTRecord>&>(data), buffer, position, comm);
 }
 
-void pack(const PolyInjTable& data, std::vector<char>& buffer, int& position,
+void pack(const PolyInjTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getThroughputs(), buffer, position, comm);
@@ -2524,32 +2505,32 @@ void pack(const PolyInjTable& data, std::vector<char>& buffer, int& position,
     pack(data.getTableData(), buffer, position, comm);
 }
 
-void pack(const PlymwinjTable& data, std::vector<char>& buffer, int& position,
+void pack(const PlymwinjTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const PolyInjTable&>(data), buffer, position, comm);
 }
 
-void pack(const SkprpolyTable& data, std::vector<char>& buffer, int& position,
+void pack(const SkprpolyTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const PolyInjTable&>(data), buffer, position, comm);
     pack(data.referenceConcentration(), buffer, position, comm);
 }
 
-void pack(const SkprwatTable& data, std::vector<char>& buffer, int& position,
+void pack(const SkprwatTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const PolyInjTable&>(data), buffer, position, comm);
 }
 
-void pack(const RockTable& data, std::vector<char>& buffer, int& position,
+void pack(const RockTable& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(static_cast<const std::vector<ROCKRecord>&>(data), buffer, position, comm);
 }
 
-void pack(const TableManager& data, std::vector<char>& buffer, int& position,
+void pack(const TableManager& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getSimpleTables(), buffer, position, comm);
@@ -2583,7 +2564,7 @@ void pack(const TableManager& data, std::vector<char>& buffer, int& position,
 
 template<class Scalar>
 void pack(const Tabulated1DFunction<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm)
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.xValues(), buffer, position, comm);
     pack(data.yValues(), buffer, position, comm);
@@ -2591,7 +2572,7 @@ void pack(const Tabulated1DFunction<Scalar>& data, std::vector<char>& buffer,
 
 template<class Scalar>
 void pack(const IntervalTabulated2DFunction<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm)
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.xPos(), buffer, position, comm);
     pack(data.yPos(), buffer, position, comm);
@@ -2602,7 +2583,7 @@ void pack(const IntervalTabulated2DFunction<Scalar>& data, std::vector<char>& bu
 
 template<class Scalar>
 void pack(const UniformXTabulated2DFunction<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm)
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.xPos(), buffer, position, comm);
     pack(data.yPos(), buffer, position, comm);
@@ -2611,7 +2592,7 @@ void pack(const UniformXTabulated2DFunction<Scalar>& data, std::vector<char>& bu
 }
 
 template<class Scalar>
-void pack(const SolventPvt<Scalar>& data, std::vector<char>& buffer, int& position,
+void pack(const SolventPvt<Scalar>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.solventReferenceDensity(), buffer, position, comm);
@@ -2622,7 +2603,7 @@ void pack(const SolventPvt<Scalar>& data, std::vector<char>& buffer, int& positi
 
 template<class Scalar, bool enableThermal>
 void pack(const GasPvtMultiplexer<Scalar,enableThermal>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.gasPvtApproach(), buffer, position, comm);
@@ -2641,7 +2622,7 @@ void pack(const GasPvtMultiplexer<Scalar,enableThermal>& data,
 }
 
 template<class Scalar>
-void pack(const DryGasPvt<Scalar>& data, std::vector<char>& buffer, int& position,
+void pack(const DryGasPvt<Scalar>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.gasReferenceDensity(), buffer, position, comm);
@@ -2652,7 +2633,7 @@ void pack(const DryGasPvt<Scalar>& data, std::vector<char>& buffer, int& positio
 
 template<class Scalar>
 void pack(const GasPvtThermal<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.gasvisctCurves(), buffer, position, comm);
@@ -2669,7 +2650,7 @@ void pack(const GasPvtThermal<Scalar>& data,
 }
 
 template<class Scalar>
-void pack(const WetGasPvt<Scalar>& data, std::vector<char>& buffer, int& position,
+void pack(const WetGasPvt<Scalar>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.gasReferenceDensity(), buffer, position, comm);
@@ -2686,7 +2667,7 @@ void pack(const WetGasPvt<Scalar>& data, std::vector<char>& buffer, int& positio
 
 template<class Scalar, bool enableThermal>
 void pack(const OilPvtMultiplexer<Scalar,enableThermal>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.approach(), buffer, position, comm);
@@ -2709,7 +2690,7 @@ void pack(const OilPvtMultiplexer<Scalar,enableThermal>& data,
 
 template<class Scalar>
 void pack(const ConstantCompressibilityOilPvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.oilReferenceDensity(), buffer, position, comm);
@@ -2722,7 +2703,7 @@ void pack(const ConstantCompressibilityOilPvt<Scalar>& data,
 
 template<class Scalar>
 void pack(const DeadOilPvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.oilReferenceDensity(), buffer, position, comm);
@@ -2733,7 +2714,7 @@ void pack(const DeadOilPvt<Scalar>& data,
 
 template<class Scalar>
 void pack(const LiveOilPvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.gasReferenceDensity(), buffer, position, comm);
@@ -2751,7 +2732,7 @@ void pack(const LiveOilPvt<Scalar>& data,
 
 template<class Scalar>
 void pack(const OilPvtThermal<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.oilvisctCurves(), buffer, position, comm);
@@ -2772,7 +2753,7 @@ void pack(const OilPvtThermal<Scalar>& data,
 
 template<class Scalar, bool enableThermal, bool enableBrine>
 void pack(const WaterPvtMultiplexer<Scalar,enableThermal,enableBrine>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.approach(), buffer, position, comm);
@@ -2792,7 +2773,7 @@ void pack(const WaterPvtMultiplexer<Scalar,enableThermal,enableBrine>& data,
 
 template<class Scalar>
 void pack(const ConstantCompressibilityWaterPvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.waterReferenceDensity(), buffer, position, comm);
@@ -2805,7 +2786,7 @@ void pack(const ConstantCompressibilityWaterPvt<Scalar>& data,
 
 template<class Scalar>
 void pack(const ConstantCompressibilityBrinePvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.waterReferenceDensity(), buffer, position, comm);
@@ -2818,7 +2799,7 @@ void pack(const ConstantCompressibilityBrinePvt<Scalar>& data,
 
 template<class Scalar>
 void pack(const WaterPvtThermal<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.viscrefPress(), buffer, position, comm);
@@ -2846,7 +2827,7 @@ void pack(const WaterPvtThermal<Scalar>& data,
 }
 
 void pack(const OilVaporizationProperties& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getType(), buffer, position, comm);
@@ -2859,20 +2840,20 @@ void pack(const OilVaporizationProperties& data,
 }
 
 void pack(const Events& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.events(), buffer, position, comm);
 }
 
 void pack(const MessageLimits& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getLimits(), buffer, position, comm);
 }
 void pack(const VFPInjTable& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getTableNum(), buffer, position, comm);
@@ -2884,7 +2865,7 @@ void pack(const VFPInjTable& data,
 }
 
 void pack(const VFPProdTable& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getTableNum(), buffer, position, comm);
@@ -2902,7 +2883,7 @@ void pack(const VFPProdTable& data,
 }
 
 void pack(const WellTestConfig::WTESTWell& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.name, buffer, position, comm);
@@ -2914,21 +2895,21 @@ void pack(const WellTestConfig::WTESTWell& data,
 }
 
 void pack(const WellTestConfig& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getWells(), buffer, position, comm);
 }
 
 void pack(const WellTracerProperties& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getConcentrations(), buffer, position, comm);
 }
 
 void pack(const UDAValue& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.get_dim(), buffer, position, comm);
@@ -2940,7 +2921,7 @@ void pack(const UDAValue& data,
 }
 
 void pack(const Connection& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.dir(), buffer, position, comm);
@@ -2967,7 +2948,7 @@ void pack(const Connection& data,
 }
 
 void pack(const Well::WellInjectionProperties& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.name, buffer, position, comm);
@@ -2988,7 +2969,7 @@ void pack(const Well::WellInjectionProperties& data,
 }
 
 void pack(const WellEconProductionLimits& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.minOilRate(), buffer, position, comm);
@@ -3009,7 +2990,7 @@ void pack(const WellEconProductionLimits& data,
 }
 
 void pack(const WellConnections& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getHeadI(), buffer, position, comm);
@@ -3019,7 +3000,7 @@ void pack(const WellConnections& data,
 }
 
 void pack(const Well::WellProductionProperties& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.name, buffer, position, comm);
@@ -3043,7 +3024,7 @@ void pack(const Well::WellProductionProperties& data,
 }
 
 void pack(const SpiralICD& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.strength(), buffer, position, comm);
@@ -3060,7 +3041,7 @@ void pack(const SpiralICD& data,
 }
 
 void pack(const Valve& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.conFlowCoefficient(), buffer, position, comm);
@@ -3074,7 +3055,7 @@ void pack(const Valve& data,
 }
 
 void pack(const Segment& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.segmentNumber(), buffer, position, comm);
@@ -3094,7 +3075,7 @@ void pack(const Segment& data,
 }
 
 template<class T>
-void pack(const std::shared_ptr<T>& data, std::vector<char>& buffer, int& position,
+void pack(const std::shared_ptr<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data != nullptr, buffer, position, comm);
@@ -3103,7 +3084,7 @@ void pack(const std::shared_ptr<T>& data, std::vector<char>& buffer, int& positi
 }
 
 template<class T>
-void pack(const std::unique_ptr<T>& data, std::vector<char>& buffer, int& position,
+void pack(const std::unique_ptr<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data != nullptr, buffer, position, comm);
@@ -3112,7 +3093,7 @@ void pack(const std::unique_ptr<T>& data, std::vector<char>& buffer, int& positi
 }
 
 void pack(const Dimension& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getName(), buffer, position, comm);
@@ -3121,7 +3102,7 @@ void pack(const Dimension& data,
 }
 
 void pack(const UnitSystem& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getName(), buffer, position, comm);
@@ -3131,7 +3112,7 @@ void pack(const UnitSystem& data,
 }
 
 void pack(const WellSegments& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.compPressureDrop(), buffer, position, comm);
@@ -3140,7 +3121,7 @@ void pack(const WellSegments& data,
 }
 
 void pack(const Well& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.name(), buffer, position, comm);
@@ -3177,7 +3158,7 @@ void pack(const Well& data,
 }
 
 template<class T>
-void pack(const IOrderSet<T>& data, std::vector<char>& buffer, int& position,
+void pack(const IOrderSet<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.index(), buffer, position, comm);
@@ -3185,7 +3166,7 @@ void pack(const IOrderSet<T>& data, std::vector<char>& buffer, int& position,
 }
 
 void pack(const Group::GroupInjectionProperties& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.phase, buffer, position, comm);
@@ -3200,7 +3181,7 @@ void pack(const Group::GroupInjectionProperties& data,
 }
 
 void pack(const Group::GroupProductionProperties& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.cmode, buffer, position, comm);
@@ -3216,7 +3197,7 @@ void pack(const Group::GroupProductionProperties& data,
 }
 
 void pack(const Group& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.name(), buffer, position, comm);
@@ -3236,14 +3217,14 @@ void pack(const Group& data,
 }
 
 void pack(const WList& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.wellList(), buffer, position, comm);
 }
 
 void pack(const WListManager& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.lists(), buffer, position, comm);
@@ -3251,7 +3232,7 @@ void pack(const WListManager& data,
 
 
 void pack(const UDQASTNode& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.var_type, buffer, position, comm);
@@ -3264,7 +3245,7 @@ void pack(const UDQASTNode& data,
 }
 
 void pack(const UDQDefine& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.keyword(), buffer, position, comm);
@@ -3274,7 +3255,7 @@ void pack(const UDQDefine& data,
 }
 
 void pack(const UDQAssign::AssignRecord& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.selector, buffer, position, comm);
@@ -3282,7 +3263,7 @@ void pack(const UDQAssign::AssignRecord& data,
 }
 
 void pack(const UDQAssign& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.keyword(), buffer, position, comm);
@@ -3291,7 +3272,7 @@ void pack(const UDQAssign& data,
 }
 
 void pack(const UDQIndex& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.insert_index, buffer, position, comm);
@@ -3301,7 +3282,7 @@ void pack(const UDQIndex& data,
 }
 
 void pack(const UDQConfig& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.params(), buffer, position, comm);
@@ -3313,7 +3294,7 @@ void pack(const UDQConfig& data,
 }
 
 void pack(const UDQActive::InputRecord& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.input_index, buffer, position, comm);
@@ -3323,7 +3304,7 @@ void pack(const UDQActive::InputRecord& data,
 }
 
 void pack(const UDQActive::Record& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.udq, buffer, position, comm);
@@ -3336,7 +3317,7 @@ void pack(const UDQActive::Record& data,
 }
 
 void pack(const UDQActive& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getInputRecords(), buffer, position, comm);
@@ -3346,7 +3327,7 @@ void pack(const UDQActive& data,
 }
 
 void pack(const GuideRateModel& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.timeInterval(), buffer, position, comm);
@@ -3360,7 +3341,7 @@ void pack(const GuideRateModel& data,
 }
 
 void pack(const GuideRateConfig& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getModel(), buffer, position, comm);
@@ -3369,7 +3350,7 @@ void pack(const GuideRateConfig& data,
 }
 
 void pack(const GConSale::GCONSALEGroup& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.sales_target, buffer, position, comm);
@@ -3381,14 +3362,14 @@ void pack(const GConSale::GCONSALEGroup& data,
 }
 
 void pack(const GConSale& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getGroups(), buffer, position, comm);
 }
 
 void pack(const GConSump::GCONSUMPGroup& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.consumption_rate, buffer, position, comm);
@@ -3399,14 +3380,14 @@ void pack(const GConSump::GCONSUMPGroup& data,
 }
 
 void pack(const GConSump& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getGroups(), buffer, position, comm);
 }
 
 void pack(const RFTConfig& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.timeMap(), buffer, position, comm);
@@ -3419,7 +3400,7 @@ void pack(const RFTConfig& data,
 }
 
 void pack(const DeckItem& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.dVal(), buffer, position, comm);
@@ -3435,14 +3416,14 @@ void pack(const DeckItem& data,
 }
 
 void pack(const DeckRecord& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getItems(), buffer, position, comm);
 }
 
 void pack(const Location& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.filename, buffer, position, comm);
@@ -3450,7 +3431,7 @@ void pack(const Location& data,
 }
 
 void pack(const DeckKeyword& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.name(), buffer, position, comm);
@@ -3461,7 +3442,7 @@ void pack(const DeckKeyword& data,
 }
 
 void pack(const Deck& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.keywords(), buffer, position, comm);
@@ -3473,7 +3454,7 @@ void pack(const Deck& data,
 }
 
 void pack(const Action::ASTNode& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.type, buffer, position, comm);
@@ -3485,14 +3466,14 @@ void pack(const Action::ASTNode& data,
 }
 
 void pack(const Action::AST& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getCondition(), buffer, position, comm);
 }
 
 void pack(const Action::Quantity& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.quantity, buffer, position, comm);
@@ -3500,7 +3481,7 @@ void pack(const Action::Quantity& data,
 }
 
 void pack(const Action::Condition& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.lhs, buffer, position, comm);
@@ -3511,7 +3492,7 @@ void pack(const Action::Condition& data,
 }
 
 void pack(const Action::ActionX& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.name(), buffer, position, comm);
@@ -3526,14 +3507,14 @@ void pack(const Action::ActionX& data,
 }
 
 void pack(const Action::Actions& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getActions(), buffer, position, comm);
 }
 
 void pack(const Schedule& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getTimeMap(), buffer, position, comm);
@@ -3562,14 +3543,14 @@ void pack(const Schedule& data,
 }
 
 void pack(const BrineDensityTable& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getBrineDensityColumn(), buffer, position, comm);
 }
 
 void pack(const PvtwsaltTable& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getReferencePressureValue(), buffer, position, comm);
@@ -3578,7 +3559,7 @@ void pack(const PvtwsaltTable& data,
 }
 
 void pack(const SummaryNode& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.keyword(), buffer, position, comm);
@@ -3591,7 +3572,7 @@ void pack(const SummaryNode& data,
 }
 
 void pack(const SummaryConfig& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getKwds(), buffer, position, comm);
@@ -3600,7 +3581,7 @@ void pack(const SummaryConfig& data,
 }
 
 void pack(const EquilRecord& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.datumDepth(), buffer, position, comm);
@@ -3615,7 +3596,7 @@ void pack(const EquilRecord& data,
 }
 
 void pack(const FoamData& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.referenceSurfactantConcentration(), buffer, position, comm);
@@ -3626,7 +3607,7 @@ void pack(const FoamData& data,
 }
 
 void pack(const RestartSchedule& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.timestep, buffer, position, comm);
@@ -3637,7 +3618,7 @@ void pack(const RestartSchedule& data,
 }
 
 void pack(const TimeStampUTC& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.ymd(), buffer, position, comm);
@@ -3648,7 +3629,7 @@ void pack(const TimeStampUTC& data,
 }
 
 void pack(const EclHysterConfig& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.active(), buffer, position, comm);
@@ -3657,7 +3638,7 @@ void pack(const EclHysterConfig& data,
 }
 
 void pack(const JFunc& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.flag(), buffer, position, comm);
@@ -3669,7 +3650,7 @@ void pack(const JFunc& data,
 }
 
 void pack(const WellPolymerProperties& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.m_polymerConcentration, buffer, position, comm);
@@ -3680,7 +3661,7 @@ void pack(const WellPolymerProperties& data,
 }
 
 void pack(const Well::WellGuideRate& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.available, buffer, position, comm);
@@ -3690,7 +3671,7 @@ void pack(const Well::WellGuideRate& data,
 }
 
 void pack(const GuideRateConfig::WellTarget& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.guide_rate, buffer, position, comm);
@@ -3699,7 +3680,7 @@ void pack(const GuideRateConfig::WellTarget& data,
 }
 
 void pack(const GuideRateConfig::GroupTarget& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.guide_rate, buffer, position, comm);
@@ -3707,7 +3688,7 @@ void pack(const GuideRateConfig::GroupTarget& data,
 }
 
 void pack(const MULTREGTRecord& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.src_value, buffer, position, comm);
@@ -3719,7 +3700,7 @@ void pack(const MULTREGTRecord& data,
 }
 
 void pack(const MULTREGTScanner& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getSize(), buffer, position, comm);
@@ -3730,7 +3711,7 @@ void pack(const MULTREGTScanner& data,
 }
 
 void pack(const EclipseConfig& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.init(), buffer, position, comm);
@@ -3738,7 +3719,7 @@ void pack(const EclipseConfig& data,
 }
 
 void pack(const TransMult& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getSize(), buffer, position, comm);
@@ -3748,7 +3729,7 @@ void pack(const TransMult& data,
 }
 
 void pack(const FaultFace& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getIndices(), buffer, position, comm);
@@ -3756,7 +3737,7 @@ void pack(const FaultFace& data,
 }
 
 void pack(const Fault& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getName(), buffer, position, comm);
@@ -3765,7 +3746,7 @@ void pack(const Fault& data,
 }
 
 void pack(const FaultCollection& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.getFaults(), buffer, position, comm);
@@ -3773,7 +3754,7 @@ void pack(const FaultCollection& data,
 
 template<class Scalar>
 void pack(const EclEpsScalingPointsInfo<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm)
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     pack(data.Swl, buffer, position, comm);
     pack(data.Sgl, buffer, position, comm);
@@ -3801,67 +3782,52 @@ void pack(const EclEpsScalingPointsInfo<Scalar>& data, std::vector<char>& buffer
 /// unpack routines
 
 template<class T>
-void unpack(T*, const std::size_t&, std::vector<char>&, int&,
+void unpack(T*, const std::size_t&, std::vector<char>&, std::size_t&,
             Dune::MPIHelper::MPICommunicator, std::integral_constant<bool, false>)
 {
     OPM_THROW(std::logic_error, "Packing not (yet) supported for this non-pod type.");
 }
 
 template<class T>
-void unpack(T* data, const std::size_t& l, std::vector<char>& buffer, int& position,
+void unpack(T* data, const std::size_t& l, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm,
             std::integral_constant<bool, true>)
 {
-#if HAVE_MPI
-    MPI_Unpack(buffer.data(), buffer.size(), &position, data, l,
-               Dune::MPITraits<T>::getType(), comm);
-#else
-    (void) data;
     (void) comm;
-    (void) l;
-    (void) buffer;
-    (void) position;
-#endif
+    readBytes(data, l*sizeof(T), buffer, position);
 }
 
 template<class T>
-void unpack(T* data, const std::size_t& l, std::vector<char>& buffer, int& position,
+void unpack(T* data, const std::size_t& l, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data, l, buffer, position, comm, typename std::is_pod<T>::type());
 }
 
 template<class T>
-void unpack(T&, std::vector<char>&, int&,
+void unpack(T&, std::vector<char>&, std::size_t&,
             Dune::MPIHelper::MPICommunicator, std::integral_constant<bool, false>)
 {
     OPM_THROW(std::logic_error, "Packing not (yet) supported for this non-pod type.");
 }
 
 template<class T>
-void unpack(T& data, std::vector<char>& buffer, int& position,
+void unpack(T& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm, std::integral_constant<bool, true>)
 {
-#if HAVE_MPI
-    MPI_Unpack(buffer.data(), buffer.size(), &position, &data, 1,
-               Dune::MPITraits<T>::getType(), comm);
-#else
-    (void) data;
     (void) comm;
-    (void) buffer;
-    (void) position;
-#endif
+    readBytes(&data, sizeof(T), buffer, position);
 }
 
 template<class T>
-void unpack(T& data, std::vector<char>& buffer, int& position,
+void unpack(T& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data, buffer, position, comm, typename std::is_pod<T>::type());
 }
 
 template<class T1, class T2>
-void unpack(std::pair<T1,T2>& data, std::vector<char>& buffer, int& position,
+void unpack(std::pair<T1,T2>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.first, buffer, position, comm);
@@ -3869,7 +3835,7 @@ void unpack(std::pair<T1,T2>& data, std::vector<char>& buffer, int& position,
 }
 
 template<class T, class A>
-void unpack(std::vector<T,A>& data, std::vector<char>& buffer, int& position,
+void unpack(std::vector<T,A>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::size_t length = 0;
@@ -3887,7 +3853,7 @@ void unpack(std::vector<T,A>& data, std::vector<char>& buffer, int& position,
 }
 
 template<class A>
-void unpack(std::vector<bool,A>& data, std::vector<char>& buffer, int& position,
+void unpack(std::vector<bool,A>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     size_t size;
@@ -3903,7 +3869,7 @@ void unpack(std::vector<bool,A>& data, std::vector<char>& buffer, int& position,
 
 template<std::size_t I = 0, typename Tuple>
 typename std::enable_if<I == std::tuple_size<Tuple>::value, void>::type
-unpack_tuple_entry(Tuple&, std::vector<char>&, int&,
+unpack_tuple_entry(Tuple&, std::vector<char>&, std::size_t&,
                    Dune::MPIHelper::MPICommunicator)
 {
 }
@@ -3911,7 +3877,7 @@ unpack_tuple_entry(Tuple&, std::vector<char>&, int&,
 template<std::size_t I = 0, typename Tuple>
 typename std::enable_if<I != std::tuple_size<Tuple>::value, void>::type
 unpack_tuple_entry(Tuple& tuple, std::vector<char>& buffer,
-                   int& position, Dune::MPIHelper::MPICommunicator comm)
+                   std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(std::get<I>(tuple), buffer, position, comm);
     unpack_tuple_entry<I+1>(tuple, buffer, position, comm);
@@ -3919,14 +3885,14 @@ unpack_tuple_entry(Tuple& tuple, std::vector<char>& buffer,
 
 template<class... Ts>
 void unpack(std::tuple<Ts...>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm)
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     unpack_tuple_entry(data, buffer, position, comm);
 }
 
 template<class K, class C, class A>
 void unpack(std::set<K,C,A>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::size_t size = 0;
@@ -3942,7 +3908,7 @@ void unpack(std::set<K,C,A>& data,
 
 template<class T, class H, class KE, class A>
 void unpack(std::unordered_set<T,H,KE,A>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::size_t size=0;
@@ -3957,7 +3923,7 @@ void unpack(std::unordered_set<T,H,KE,A>& data,
 }
 
 template<class T, size_t N>
-void unpack(std::array<T,N>& data, std::vector<char>& buffer, int& position,
+void unpack(std::array<T,N>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     for (T& entry : data)
@@ -3965,7 +3931,7 @@ void unpack(std::array<T,N>& data, std::vector<char>& buffer, int& position,
 }
 
 template<class Key, class Value>
-void unpack(OrderedMap<Key,Value>& data, std::vector<char>& buffer, int& position,
+void unpack(OrderedMap<Key,Value>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
   typename OrderedMap<Key,Value>::index_type index;
@@ -3976,7 +3942,7 @@ void unpack(OrderedMap<Key,Value>& data, std::vector<char>& buffer, int& positio
 }
 
 template<class T>
-void unpack(DynamicState<T>& data, std::vector<char>& buffer, int& position,
+void unpack(DynamicState<T>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<T> ddata;
@@ -3987,7 +3953,7 @@ void unpack(DynamicState<T>& data, std::vector<char>& buffer, int& position,
 }
 
 template<class T>
-void unpack(DynamicVector<T>& data, std::vector<char>& buffer, int& position,
+void unpack(DynamicVector<T>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<T> ddata;
@@ -3997,7 +3963,7 @@ void unpack(DynamicVector<T>& data, std::vector<char>& buffer, int& position,
 
 template<class Scalar>
 void unpack(EclEpsScalingPointsInfo<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm)
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.Swl, buffer, position, comm);
     unpack(data.Sgl, buffer, position, comm);
@@ -4022,21 +3988,14 @@ void unpack(EclEpsScalingPointsInfo<Scalar>& data, std::vector<char>& buffer,
     unpack(data.maxKrg, buffer, position, comm);
 }
 
-void unpack(char* str, std::size_t length, std::vector<char>& buffer, int& position,
+void unpack(char* str, std::size_t length, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
-#if HAVE_MPI
-    MPI_Unpack(buffer.data(), buffer.size(), &position, const_cast<char*>(str), length, MPI_CHAR, comm);
-#else
-    (void) str;
     (void) comm;
-    (void) length;
-    (void) buffer;
-    (void) position;
-#endif
+    readBytes(str, length, buffer, position);
 }
 
-void unpack(std::string& str, std::vector<char>& buffer, int& position,
+void unpack(std::string& str, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::size_t length=0;
@@ -4048,7 +4007,7 @@ void unpack(std::string& str, std::vector<char>& buffer, int& position,
 }
 
 template<class T1, class T2, class C, class A>
-void unpack(std::map<T1,T2,C,A>& data, std::vector<char>& buffer, int& position,
+void unpack(std::map<T1,T2,C,A>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::size_t size=0;
@@ -4063,7 +4022,7 @@ void unpack(std::map<T1,T2,C,A>& data, std::vector<char>& buffer, int& position,
 }
 
 template<class T1, class T2, class H, class P, class A>
-void unpack(std::unordered_map<T1,T2,H,P,A>& data, std::vector<char>& buffer, int& position,
+void unpack(std::unordered_map<T1,T2,H,P,A>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::size_t size=0;
@@ -4077,7 +4036,7 @@ void unpack(std::unordered_map<T1,T2,H,P,A>& data, std::vector<char>& buffer, in
     }
 }
 
-void unpack(data::Well& data, std::vector<char>& buffer, int& position,
+void unpack(data::Well& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.rates, buffer, position, comm);
@@ -4090,7 +4049,7 @@ void unpack(data::Well& data, std::vector<char>& buffer, int& position,
     unpack(data.current_control, buffer, position, comm);
 }
 
-void unpack(RestartKey& data, std::vector<char>& buffer, int& position,
+void unpack(RestartKey& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.key, buffer, position, comm);
@@ -4098,7 +4057,7 @@ void unpack(RestartKey& data, std::vector<char>& buffer, int& position,
     unpack(data.required, buffer, position, comm);
 }
 
-void unpack(data::CellData& data, std::vector<char>& buffer, int& position,
+void unpack(data::CellData& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.dim, buffer, position, comm);
@@ -4106,7 +4065,7 @@ void unpack(data::CellData& data, std::vector<char>& buffer, int& position,
     unpack(data.target, buffer, position, comm);
 }
 
-void unpack(data::Solution& data, std::vector<char>& buffer, int& position,
+void unpack(data::Solution& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     // Needs explicit conversion to a supported base type holding the data
@@ -4115,7 +4074,7 @@ void unpack(data::Solution& data, std::vector<char>& buffer, int& position,
            buffer, position, comm);
 }
 
-void unpack(data::WellRates& data, std::vector<char>& buffer, int& position,
+void unpack(data::WellRates& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     // Needs explicit conversion to a supported base type holding the data
@@ -4124,7 +4083,7 @@ void unpack(data::WellRates& data, std::vector<char>& buffer, int& position,
            buffer, position, comm);
 }
 
-void unpack(RestartValue& data, std::vector<char>& buffer, int& position,
+void unpack(RestartValue& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.solution, buffer, position, comm);
@@ -4132,7 +4091,7 @@ void unpack(RestartValue& data, std::vector<char>& buffer, int& position,
     unpack(data.extra, buffer, position, comm);
 }
 
-void unpack(RockConfig& data, std::vector<char>& buffer, int& position,
+void unpack(RockConfig& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     RockConfig rock_config;
@@ -4152,7 +4111,7 @@ void unpack(RockConfig& data, std::vector<char>& buffer, int& position,
     data = RockConfig(active, rock_comp, rocknum_property, num_rock_tables, water_compaction, hyst_mode);
 }
 
-void unpack(ThresholdPressure& data, std::vector<char>& buffer, int& position,
+void unpack(ThresholdPressure& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     ThresholdPressure::ThresholdPressureTable thpTable;
@@ -4167,7 +4126,7 @@ void unpack(ThresholdPressure& data, std::vector<char>& buffer, int& position,
 }
 
 
-void unpack(BCConfig& bc, std::vector<char>& buffer, int& position,
+void unpack(BCConfig& bc, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<BCConfig::BCFace> faces;
@@ -4176,7 +4135,7 @@ void unpack(BCConfig& bc, std::vector<char>& buffer, int& position,
     bc = BCConfig(faces);
 }
 
-void unpack(NNC& data, std::vector<char>& buffer, int& position,
+void unpack(NNC& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<NNCdata> res;
@@ -4184,7 +4143,7 @@ void unpack(NNC& data, std::vector<char>& buffer, int& position,
     data = NNC(res);
 }
 
-void unpack(EDITNNC& data, std::vector<char>& buffer, int& position,
+void unpack(EDITNNC& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<NNCdata> res;
@@ -4192,7 +4151,7 @@ void unpack(EDITNNC& data, std::vector<char>& buffer, int& position,
     data = EDITNNC(res);
 }
 
-void unpack(Rock2dTable& data, std::vector<char>& buffer, int& position,
+void unpack(Rock2dTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<std::vector<double>> pvmultValues;
@@ -4202,7 +4161,7 @@ void unpack(Rock2dTable& data, std::vector<char>& buffer, int& position,
     data = Rock2dTable(pvmultValues, pressureValues);
 }
 
-void unpack(Rock2dtrTable& data, std::vector<char>& buffer, int& position,
+void unpack(Rock2dtrTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<std::vector<double>> transMultValues;
@@ -4212,7 +4171,7 @@ void unpack(Rock2dtrTable& data, std::vector<char>& buffer, int& position,
     data = Rock2dtrTable(transMultValues, pressureValues);
 }
 
-void unpack(ColumnSchema& data, std::vector<char>& buffer, int& position,
+void unpack(ColumnSchema& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string name;
@@ -4229,7 +4188,7 @@ void unpack(ColumnSchema& data, std::vector<char>& buffer, int& position,
         data = ColumnSchema(name, order, action);
 }
 
-void unpack(TableSchema& data, std::vector<char>& buffer, int& position,
+void unpack(TableSchema& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     OrderedMap<std::string, ColumnSchema> columns;
@@ -4237,7 +4196,7 @@ void unpack(TableSchema& data, std::vector<char>& buffer, int& position,
     data = TableSchema(columns);
 }
 
-void unpack(TableColumn& data, std::vector<char>& buffer, int& position,
+void unpack(TableColumn& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     ColumnSchema schema;
@@ -4253,7 +4212,7 @@ void unpack(TableColumn& data, std::vector<char>& buffer, int& position,
     data = TableColumn(schema, name, values, defaults, defaultCount);
 }
 
-void unpack(SimpleTable& data, std::vector<char>& buffer, int& position,
+void unpack(SimpleTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     TableSchema schema;
@@ -4265,7 +4224,7 @@ void unpack(SimpleTable& data, std::vector<char>& buffer, int& position,
     data = SimpleTable(schema, columns, jf);
 }
 
-void unpack(TableContainer& data, std::vector<char>& buffer, int& position,
+void unpack(TableContainer& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     size_t max;
@@ -4282,7 +4241,7 @@ void unpack(TableContainer& data, std::vector<char>& buffer, int& position,
     }
 }
 
-void unpack(Equil& data, std::vector<char>& buffer, int& position,
+void unpack(Equil& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<EquilRecord> records;
@@ -4290,7 +4249,7 @@ void unpack(Equil& data, std::vector<char>& buffer, int& position,
     data = Equil(records);
 }
 
-void unpack(FoamConfig& data, std::vector<char>& buffer, int& position,
+void unpack(FoamConfig& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<FoamData> records;
@@ -4298,7 +4257,7 @@ void unpack(FoamConfig& data, std::vector<char>& buffer, int& position,
     data = FoamConfig(records);
 }
 
-void unpack(InitConfig& data, std::vector<char>& buffer, int& position,
+void unpack(InitConfig& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     Equil equil;
@@ -4317,7 +4276,7 @@ void unpack(InitConfig& data, std::vector<char>& buffer, int& position,
                       restartRequested, restartStep, restartRootName);
 }
 
-void unpack(SimulationConfig& data, std::vector<char>& buffer, int& position,
+void unpack(SimulationConfig& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     ThresholdPressure thresholdPressure;
@@ -4334,7 +4293,7 @@ void unpack(SimulationConfig& data, std::vector<char>& buffer, int& position,
     data = SimulationConfig(thresholdPressure, bc, rock_config, useCPR, DISGAS, VAPOIL, isThermal);
 }
 
-void unpack(TimeMap& data, std::vector<char>& buffer, int& position,
+void unpack(TimeMap& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<std::time_t> timeList;
@@ -4343,7 +4302,7 @@ void unpack(TimeMap& data, std::vector<char>& buffer, int& position,
     data = TimeMap(timeList);
 }
 
-void unpack(RestartConfig& data, std::vector<char>& buffer, int& position,
+void unpack(RestartConfig& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     IOConfig ioConfig;
@@ -4364,7 +4323,7 @@ void unpack(RestartConfig& data, std::vector<char>& buffer, int& position,
                          restart_keyw, save_keyw);
 }
 
-void unpack(IOConfig& data, std::vector<char>& buffer, int& position,
+void unpack(IOConfig& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     bool write_init, write_egrid, unifin, unifout, fmtin, fmtout;
@@ -4388,7 +4347,7 @@ void unpack(IOConfig& data, std::vector<char>& buffer, int& position,
                     no_sim, base_name, ecl_compatible_rst);
 }
 
-void unpack(Phases& data, std::vector<char>& buffer, int& position,
+void unpack(Phases& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unsigned long bits;
@@ -4396,7 +4355,7 @@ void unpack(Phases& data, std::vector<char>& buffer, int& position,
     data = Phases(std::bitset<NUM_PHASES_IN_ENUM>(bits));
 }
 
-void unpack(EndpointScaling& data, std::vector<char>& buffer, int& position,
+void unpack(EndpointScaling& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unsigned long bits;
@@ -4404,7 +4363,7 @@ void unpack(EndpointScaling& data, std::vector<char>& buffer, int& position,
     data = EndpointScaling(std::bitset<4>(bits));
 }
 
-void unpack(UDQParams& data, std::vector<char>& buffer, int& position,
+void unpack(UDQParams& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     bool reseed;
@@ -4419,7 +4378,7 @@ void unpack(UDQParams& data, std::vector<char>& buffer, int& position,
     data = UDQParams(reseed, rand_seed, range, undefVal, cmp_eps);
 }
 
-void unpack(Runspec& data, std::vector<char>& buffer, int& position,
+void unpack(Runspec& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     Phases phases;
@@ -4445,7 +4404,7 @@ void unpack(Runspec& data, std::vector<char>& buffer, int& position,
 }
 
 template<class PVTType>
-void unpack_pvt(PVTType& data, std::vector<char>& buffer, int& position,
+void unpack_pvt(PVTType& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     ColumnSchema outer_schema;
@@ -4463,19 +4422,19 @@ void unpack_pvt(PVTType& data, std::vector<char>& buffer, int& position,
                    undersat_tables, sat_table);
 }
 
-void unpack(PvtgTable& data, std::vector<char>& buffer, int& position,
+void unpack(PvtgTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack_pvt(data, buffer, position, comm);
 }
 
-void unpack(PvtoTable& data, std::vector<char>& buffer, int& position,
+void unpack(PvtoTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack_pvt(data, buffer, position, comm);
 }
 
-void unpack(PvtwTable& data, std::vector<char>& buffer, int& position,
+void unpack(PvtwTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<PVTWRecord> pdata;
@@ -4483,7 +4442,7 @@ void unpack(PvtwTable& data, std::vector<char>& buffer, int& position,
     data = PvtwTable(pdata);
 }
 
-void unpack(PvcdoTable& data, std::vector<char>& buffer, int& position,
+void unpack(PvcdoTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<PVCDORecord> pdata;
@@ -4491,7 +4450,7 @@ void unpack(PvcdoTable& data, std::vector<char>& buffer, int& position,
     data = PvcdoTable(pdata);
 }
 
-void unpack(DensityTable& data, std::vector<char>& buffer, int& position,
+void unpack(DensityTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<DENSITYRecord> pdata;
@@ -4499,7 +4458,7 @@ void unpack(DensityTable& data, std::vector<char>& buffer, int& position,
     data = DensityTable(pdata);
 }
 
-void unpack(ViscrefTable& data, std::vector<char>& buffer, int& position,
+void unpack(ViscrefTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<VISCREFRecord> pdata;
@@ -4507,7 +4466,7 @@ void unpack(ViscrefTable& data, std::vector<char>& buffer, int& position,
     data = ViscrefTable(pdata);
 }
 
-void unpack(WatdentTable& data, std::vector<char>& buffer, int& position,
+void unpack(WatdentTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<WATDENTRecord> pdata;
@@ -4515,7 +4474,7 @@ void unpack(WatdentTable& data, std::vector<char>& buffer, int& position,
     data = WatdentTable(pdata);
 }
 
-void unpack(PolyInjTable& data, std::vector<char>& buffer, int& position,
+void unpack(PolyInjTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<double> throughputs, velocities;
@@ -4528,13 +4487,13 @@ void unpack(PolyInjTable& data, std::vector<char>& buffer, int& position,
     data = PolyInjTable(throughputs, velocities, tableNumber, tableData);
 }
 
-void unpack(PlymwinjTable& data, std::vector<char>& buffer, int& position,
+void unpack(PlymwinjTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(static_cast<PolyInjTable&>(data), buffer, position, comm);
 }
 
-void unpack(SkprpolyTable& data, std::vector<char>& buffer, int& position,
+void unpack(SkprpolyTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(static_cast<PolyInjTable&>(data), buffer, position, comm);
@@ -4543,13 +4502,13 @@ void unpack(SkprpolyTable& data, std::vector<char>& buffer, int& position,
     data.setReferenceConcentration(refConcentration);
 }
 
-void unpack(SkprwatTable& data, std::vector<char>& buffer, int& position,
+void unpack(SkprwatTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(static_cast<PolyInjTable&>(data), buffer, position, comm);
 }
 
-void unpack(RockTable& data, std::vector<char>& buffer, int& position,
+void unpack(RockTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<ROCKRecord> pdata;
@@ -4557,7 +4516,7 @@ void unpack(RockTable& data, std::vector<char>& buffer, int& position,
     data = RockTable(pdata);
 }
 
-void unpack(TableManager& data, std::vector<char>& buffer, int& position,
+void unpack(TableManager& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     std::map<std::string, TableContainer> simpleTables;
@@ -4625,7 +4584,7 @@ void unpack(TableManager& data, std::vector<char>& buffer, int& position,
 
 template<class Scalar>
 void unpack(Tabulated1DFunction<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm)
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> xValues, yValues;
     unpack(xValues, buffer, position, comm);
@@ -4635,7 +4594,7 @@ void unpack(Tabulated1DFunction<Scalar>& data, std::vector<char>& buffer,
 
 template<class Scalar>
 void unpack(IntervalTabulated2DFunction<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm)
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> xPos, yPos;
     std::vector<std::vector<Scalar>> samples;
@@ -4651,7 +4610,7 @@ void unpack(IntervalTabulated2DFunction<Scalar>& data, std::vector<char>& buffer
 
 template<class Scalar>
 void unpack(UniformXTabulated2DFunction<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm)
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> xPos, yPos;
     std::vector<std::vector<typename UniformXTabulated2DFunction<Scalar>::SamplePoint>> samples;
@@ -4665,7 +4624,7 @@ void unpack(UniformXTabulated2DFunction<Scalar>& data, std::vector<char>& buffer
 }
 
 template<class Scalar>
-void unpack(SolventPvt<Scalar>& data, std::vector<char>& buffer, int& position,
+void unpack(SolventPvt<Scalar>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> solventReferenceDensity;
@@ -4682,7 +4641,7 @@ void unpack(SolventPvt<Scalar>& data, std::vector<char>& buffer, int& position,
 
 template<class Scalar, bool enableThermal>
 void unpack(GasPvtMultiplexer<Scalar,enableThermal>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     typename GasPvtMultiplexer<Scalar,enableThermal>::GasPvtApproach approach;
@@ -4706,7 +4665,7 @@ void unpack(GasPvtMultiplexer<Scalar,enableThermal>& data,
 }
 
 template<class Scalar>
-void unpack(DryGasPvt<Scalar>& data, std::vector<char>& buffer, int& position,
+void unpack(DryGasPvt<Scalar>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> gasReferenceDensity;
@@ -4723,7 +4682,7 @@ void unpack(DryGasPvt<Scalar>& data, std::vector<char>& buffer, int& position,
 
 template<class Scalar>
 void unpack(GasPvtThermal<Scalar>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<typename GasPvtThermal<Scalar>::TabulatedOneDFunction> gasvisctCurves;
@@ -4754,7 +4713,7 @@ void unpack(GasPvtThermal<Scalar>& data,
 }
 
 template<class Scalar>
-void unpack(WetGasPvt<Scalar>& data, std::vector<char>& buffer, int& position,
+void unpack(WetGasPvt<Scalar>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> gasReferenceDensity, oilReferenceDensity;
@@ -4784,7 +4743,7 @@ void unpack(WetGasPvt<Scalar>& data, std::vector<char>& buffer, int& position,
 
 template<class Scalar, bool enableThermal>
 void unpack(OilPvtMultiplexer<Scalar,enableThermal>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     typename OilPvtMultiplexer<Scalar,enableThermal>::OilPvtApproach approach;
@@ -4813,7 +4772,7 @@ void unpack(OilPvtMultiplexer<Scalar,enableThermal>& data,
 
 template<class Scalar>
 void unpack(ConstantCompressibilityOilPvt<Scalar>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> oilReferenceDensity, oilReferencePressure,
@@ -4836,7 +4795,7 @@ void unpack(ConstantCompressibilityOilPvt<Scalar>& data,
 
 template<class Scalar>
 void unpack(DeadOilPvt<Scalar>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> oilReferenceDensity;
@@ -4853,7 +4812,7 @@ void unpack(DeadOilPvt<Scalar>& data,
 
 template<class Scalar>
 void unpack(LiveOilPvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> gasReferenceDensity, oilReferenceDensity;
@@ -4891,7 +4850,7 @@ void unpack(LiveOilPvt<Scalar>& data,
 
 template<class Scalar>
 void unpack(OilPvtThermal<Scalar>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<typename OilPvtThermal<Scalar>::TabulatedOneDFunction> oilvisctCurves;
@@ -4928,7 +4887,7 @@ void unpack(OilPvtThermal<Scalar>& data,
 
 template<class Scalar, bool enableThermal, bool enableBrine>
 void unpack(WaterPvtMultiplexer<Scalar,enableThermal,enableBrine>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     typename WaterPvtMultiplexer<Scalar,enableThermal,enableBrine>::WaterPvtApproach approach;
@@ -4953,7 +4912,7 @@ void unpack(WaterPvtMultiplexer<Scalar,enableThermal,enableBrine>& data,
 
 template<class Scalar>
 void unpack(ConstantCompressibilityWaterPvt<Scalar>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> waterReferenceDensity, waterReferencePressure,
@@ -4976,7 +4935,7 @@ void unpack(ConstantCompressibilityWaterPvt<Scalar>& data,
 
 template<class Scalar>
 void unpack(ConstantCompressibilityBrinePvt<Scalar>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     using TabulatedFunction = typename ConstantCompressibilityBrinePvt<Scalar>::TabulatedFunction;
@@ -5000,7 +4959,7 @@ void unpack(ConstantCompressibilityBrinePvt<Scalar>& data,
 
 template<class Scalar>
 void unpack(WaterPvtThermal<Scalar>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Scalar> viscrefPress, watdentRefTemp, watdentCT1, watdentCT2,
@@ -5048,7 +5007,7 @@ void unpack(WaterPvtThermal<Scalar>& data,
 }
 
 void unpack(OilVaporizationProperties& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     OilVaporizationProperties::OilVaporization type;
@@ -5065,7 +5024,7 @@ void unpack(OilVaporizationProperties& data,
 }
 
 void unpack(Events& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     DynamicVector<uint64_t> events;
@@ -5074,7 +5033,7 @@ void unpack(Events& data,
 }
 
 void unpack(MessageLimits& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     DynamicState<MLimits> limits;
@@ -5083,7 +5042,7 @@ void unpack(MessageLimits& data,
 }
 
 void unpack(VFPInjTable& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     int tableNum;
@@ -5104,7 +5063,7 @@ void unpack(VFPInjTable& data,
 }
 
 void unpack(VFPProdTable& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     int tableNum;
@@ -5135,7 +5094,7 @@ void unpack(VFPProdTable& data,
 }
 
 void unpack(WellTestConfig::WTESTWell& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.name, buffer, position, comm);
@@ -5147,7 +5106,7 @@ void unpack(WellTestConfig::WTESTWell& data,
 }
 
 void unpack(WellTestConfig& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<WellTestConfig::WTESTWell> ddata;
@@ -5156,7 +5115,7 @@ void unpack(WellTestConfig& data,
 }
 
 void unpack(WellTracerProperties& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     WellTracerProperties::ConcentrationMap ddata;
@@ -5165,7 +5124,7 @@ void unpack(WellTracerProperties& data,
 }
 
 void unpack(UDAValue& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     bool isDouble;
@@ -5184,7 +5143,7 @@ void unpack(UDAValue& data,
 }
 
 void unpack(Connection& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     Connection::Direction dir;
@@ -5232,7 +5191,7 @@ void unpack(Connection& data,
 }
 
 void unpack(Well::WellInjectionProperties& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.name, buffer, position, comm);
@@ -5253,7 +5212,7 @@ void unpack(Well::WellInjectionProperties& data,
 }
 
 void unpack(WellEconProductionLimits& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     double minOilRate, minGasRate, maxWaterCut, maxGasOilRatio, maxWaterGasRatio;
@@ -5288,7 +5247,7 @@ void unpack(WellEconProductionLimits& data,
 }
 
 void unpack(WellConnections& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     int headI, headJ;
@@ -5304,7 +5263,7 @@ void unpack(WellConnections& data,
 }
 
 void unpack(Well::WellProductionProperties& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string name;
@@ -5345,7 +5304,7 @@ void unpack(Well::WellProductionProperties& data,
 }
 
 void unpack(SpiralICD& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     double strength, length, densityCalibration,
@@ -5376,7 +5335,7 @@ void unpack(SpiralICD& data,
 }
 
 void unpack(Valve& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     double conFlowCoefficient;
@@ -5402,7 +5361,7 @@ void unpack(Valve& data,
 }
 
 void unpack(Segment& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     int segmentNumber, branchNumber, outletSegment;
@@ -5434,7 +5393,7 @@ void unpack(Segment& data,
 }
 
 template<class T>
-void unpack(std::shared_ptr<T>& data, std::vector<char>& buffer, int& position,
+void unpack(std::shared_ptr<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     bool hasVal;
@@ -5446,7 +5405,7 @@ void unpack(std::shared_ptr<T>& data, std::vector<char>& buffer, int& position,
 }
 
 template<class T>
-void unpack(std::unique_ptr<T>& data, std::vector<char>& buffer, int& position,
+void unpack(std::unique_ptr<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm)
 {
     bool hasVal;
@@ -5458,7 +5417,7 @@ void unpack(std::unique_ptr<T>& data, std::vector<char>& buffer, int& position,
 }
 
 void unpack(Dimension& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string name;
@@ -5471,7 +5430,7 @@ void unpack(Dimension& data,
 }
 
 void unpack(UnitSystem& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string name;
@@ -5487,7 +5446,7 @@ void unpack(UnitSystem& data,
 }
 
 void unpack(WellSegments& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     WellSegments::CompPressureDrop compPressureDrop;
@@ -5503,7 +5462,7 @@ void unpack(WellSegments& data,
 }
 
 void unpack(Well& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string name, groupName;
@@ -5574,7 +5533,7 @@ void unpack(Well& data,
 }
 
 template<class T>
-void unpack(IOrderSet<T>& data, std::vector<char>& buffer, int& position,
+void unpack(IOrderSet<T>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     typename IOrderSet<T>::index_type index;
@@ -5585,11 +5544,11 @@ void unpack(IOrderSet<T>& data, std::vector<char>& buffer, int& position,
 }
 
 template void unpack(std::map<Phase,Group::GroupInjectionProperties>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 void unpack(Group::GroupInjectionProperties& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.phase, buffer, position, comm);
@@ -5605,7 +5564,7 @@ void unpack(Group::GroupInjectionProperties& data,
 
 
 void unpack(Group::GroupProductionProperties& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.cmode, buffer, position, comm);
@@ -5621,7 +5580,7 @@ void unpack(Group::GroupProductionProperties& data,
 }
 
 void unpack(Group& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string name;
@@ -5659,7 +5618,7 @@ void unpack(Group& data,
 }
 
 void unpack(WList& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     WList::storage ddata;
@@ -5668,7 +5627,7 @@ void unpack(WList& data,
 }
 
 void unpack(WListManager& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::map<std::string,WList> lists;
@@ -5678,7 +5637,7 @@ void unpack(WListManager& data,
 
 
 void unpack(UDQASTNode& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     UDQVarType var_type;
@@ -5700,7 +5659,7 @@ void unpack(UDQASTNode& data,
 }
 
 void unpack(UDQDefine& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string keyword;
@@ -5716,7 +5675,7 @@ void unpack(UDQDefine& data,
 }
 
 void unpack(UDQAssign::AssignRecord& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.selector, buffer, position, comm);
@@ -5724,7 +5683,7 @@ void unpack(UDQAssign::AssignRecord& data,
 }
 
 void unpack(UDQAssign& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string keyword;
@@ -5737,7 +5696,7 @@ void unpack(UDQAssign& data,
 }
 
 void unpack(UDQIndex& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.insert_index, buffer, position, comm);
@@ -5747,7 +5706,7 @@ void unpack(UDQIndex& data,
 }
 
 void unpack(UDQConfig& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     UDQParams params;
@@ -5770,7 +5729,7 @@ void unpack(UDQConfig& data,
 }
 
 void unpack(UDQActive::InputRecord& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.input_index, buffer, position, comm);
@@ -5780,7 +5739,7 @@ void unpack(UDQActive::InputRecord& data,
 }
 
 void unpack(UDQActive::Record& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.udq, buffer, position, comm);
@@ -5793,7 +5752,7 @@ void unpack(UDQActive::Record& data,
 }
 
 void unpack(UDQActive& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<UDQActive::InputRecord> inputRecords;
@@ -5808,7 +5767,7 @@ void unpack(UDQActive& data,
 }
 
 void unpack(GuideRateModel& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     double timeInterval;
@@ -5831,7 +5790,7 @@ void unpack(GuideRateModel& data,
 }
 
 void unpack(GuideRateConfig& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::shared_ptr<GuideRateModel> model;
@@ -5845,7 +5804,7 @@ void unpack(GuideRateConfig& data,
 }
 
 void unpack(GConSale::GCONSALEGroup& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.sales_target, buffer, position, comm);
@@ -5857,7 +5816,7 @@ void unpack(GConSale::GCONSALEGroup& data,
 }
 
 void unpack(GConSale& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::map<std::string,GConSale::GCONSALEGroup> groups;
@@ -5866,7 +5825,7 @@ void unpack(GConSale& data,
 }
 
 void unpack(GConSump::GCONSUMPGroup& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.consumption_rate, buffer, position, comm);
@@ -5877,7 +5836,7 @@ void unpack(GConSump::GCONSUMPGroup& data,
 }
 
 void unpack(GConSump& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::map<std::string,GConSump::GCONSUMPGroup> groups;
@@ -5886,7 +5845,7 @@ void unpack(GConSump& data,
 }
 
 void unpack(RFTConfig& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     TimeMap timeMap;
@@ -5910,7 +5869,7 @@ void unpack(RFTConfig& data,
 
 
 void unpack(DeckItem& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<double> dVal;
@@ -5938,7 +5897,7 @@ void unpack(DeckItem& data,
 }
 
 void unpack(DeckRecord& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<DeckItem> items;
@@ -5947,7 +5906,7 @@ void unpack(DeckRecord& data,
 }
 
 void unpack(Location& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     data.filename.clear();
@@ -5956,7 +5915,7 @@ void unpack(Location& data,
 }
 
 void unpack(DeckKeyword& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string name;
@@ -5973,7 +5932,7 @@ void unpack(DeckKeyword& data,
                        isDataKeyword, isSlashTerminated);
 }
 
-void unpack(Deck& data, std::vector<char>& buffer, int& position,
+void unpack(Deck& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<DeckKeyword> keywords;
@@ -5992,7 +5951,7 @@ void unpack(Deck& data, std::vector<char>& buffer, int& position,
                 activeUnitSystem.get(), dataFile, inputPath, accessCount);
 }
 
-void unpack(Action::ASTNode& data, std::vector<char>& buffer, int& position,
+void unpack(Action::ASTNode& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     TokenType token;
@@ -6011,7 +5970,7 @@ void unpack(Action::ASTNode& data, std::vector<char>& buffer, int& position,
     data = Action::ASTNode(token, func_type, func, argList, number, children);
 }
 
-void unpack(Action::AST& data, std::vector<char>& buffer, int& position,
+void unpack(Action::AST& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::shared_ptr<Action::ASTNode> condition;
@@ -6019,14 +5978,14 @@ void unpack(Action::AST& data, std::vector<char>& buffer, int& position,
     data = Action::AST(condition);
 }
 
-void unpack(Action::Quantity& data, std::vector<char>& buffer, int& position,
+void unpack(Action::Quantity& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.quantity, buffer, position, comm);
     unpack(data.args, buffer, position, comm);
 }
 
-void unpack(Action::Condition& data, std::vector<char>& buffer, int& position,
+void unpack(Action::Condition& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.lhs, buffer, position, comm);
@@ -6036,7 +5995,7 @@ void unpack(Action::Condition& data, std::vector<char>& buffer, int& position,
     unpack(data.cmp_string, buffer, position, comm);
 }
 
-void unpack(Action::ActionX& data, std::vector<char>& buffer, int& position,
+void unpack(Action::ActionX& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string name;
@@ -6062,7 +6021,7 @@ void unpack(Action::ActionX& data, std::vector<char>& buffer, int& position,
                            condition, conditions, run_count, last_run);
 }
 
-void unpack(Action::Actions& data, std::vector<char>& buffer, int& position,
+void unpack(Action::Actions& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<Action::ActionX> actions;
@@ -6070,7 +6029,7 @@ void unpack(Action::Actions& data, std::vector<char>& buffer, int& position,
     data = Action::Actions(actions);
 }
 
-void unpack(Schedule& data, std::vector<char>& buffer, int& position,
+void unpack(Schedule& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     TimeMap timeMap;
@@ -6129,7 +6088,7 @@ void unpack(Schedule& data, std::vector<char>& buffer, int& position,
                     rftConfig, nupCol, wellGroupEvents);
 }
 
-void unpack(BrineDensityTable& data, std::vector<char>& buffer, int& position,
+void unpack(BrineDensityTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<double> tableValues;
@@ -6138,7 +6097,7 @@ void unpack(BrineDensityTable& data, std::vector<char>& buffer, int& position,
     data = BrineDensityTable(tableValues);
 }
 
-void unpack(PvtwsaltTable& data, std::vector<char>& buffer, int& position,
+void unpack(PvtwsaltTable& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     double refPressValue, refSaltConValue;
@@ -6151,7 +6110,7 @@ void unpack(PvtwsaltTable& data, std::vector<char>& buffer, int& position,
 }
 
 void unpack(SummaryNode& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string keyword;
@@ -6177,7 +6136,7 @@ void unpack(SummaryNode& data,
 }
 
 void unpack(SummaryConfig& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     SummaryConfig::keyword_list kwds;
@@ -6190,7 +6149,7 @@ void unpack(SummaryConfig& data,
 }
 
 void unpack(EquilRecord& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     double datumDepth, datumDepthPressure, waterOilContactDepth;
@@ -6215,7 +6174,7 @@ void unpack(EquilRecord& data,
 }
 
 void unpack(FoamData& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     double referenceSurfactantConcentration, exponent;
@@ -6233,7 +6192,7 @@ void unpack(FoamData& data,
 }
 
 void unpack(RestartSchedule& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.timestep, buffer, position, comm);
@@ -6244,7 +6203,7 @@ void unpack(RestartSchedule& data,
 }
 
 void unpack(TimeStampUTC& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     TimeStampUTC::YMD ymd;
@@ -6260,7 +6219,7 @@ void unpack(TimeStampUTC& data,
 
 
 void unpack(EclHysterConfig& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     bool active;
@@ -6273,7 +6232,7 @@ void unpack(EclHysterConfig& data,
 }
 
 void unpack(JFunc& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     JFunc::Flag flag;
@@ -6292,7 +6251,7 @@ void unpack(JFunc& data,
 }
 
 void unpack(WellPolymerProperties& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.m_polymerConcentration, buffer, position, comm);
@@ -6303,7 +6262,7 @@ void unpack(WellPolymerProperties& data,
 }
 
 void unpack(Well::WellGuideRate& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.available, buffer, position, comm);
@@ -6313,7 +6272,7 @@ void unpack(Well::WellGuideRate& data,
 }
 
 void unpack(GuideRateConfig::WellTarget& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.guide_rate, buffer, position, comm);
@@ -6322,7 +6281,7 @@ void unpack(GuideRateConfig::WellTarget& data,
 }
 
 void unpack(GuideRateConfig::GroupTarget& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.guide_rate, buffer, position, comm);
@@ -6330,7 +6289,7 @@ void unpack(GuideRateConfig::GroupTarget& data,
 }
 
 void unpack(MULTREGTRecord& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     unpack(data.src_value, buffer, position, comm);
@@ -6342,7 +6301,7 @@ void unpack(MULTREGTRecord& data,
 }
 
 void unpack(MULTREGTScanner& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::array<size_t, 3> size;
@@ -6361,7 +6320,7 @@ void unpack(MULTREGTScanner& data,
 }
 
 void unpack(EclipseConfig& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     InitConfig init;
@@ -6373,7 +6332,7 @@ void unpack(EclipseConfig& data,
 }
 
 void unpack(TransMult& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::array<size_t, 3> size;
@@ -6389,7 +6348,7 @@ void unpack(TransMult& data,
 }
 
 void unpack(FaultFace& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::vector<size_t> indices;
@@ -6401,7 +6360,7 @@ void unpack(FaultFace& data,
 }
 
 void unpack(Fault& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     std::string name;
@@ -6415,7 +6374,7 @@ void unpack(Fault& data,
 }
 
 void unpack(FaultCollection& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm)
 {
     OrderedMap<std::string, Fault> faults;
@@ -6428,10 +6387,10 @@ void unpack(FaultCollection& data,
 template std::size_t packSize(const std::vector<__VA_ARGS__>& data, \
                               Dune::MPIHelper::MPICommunicator comm); \
 template void pack(const std::vector<__VA_ARGS__>& data, \
-                   std::vector<char>& buffer, int& position, \
+                   std::vector<char>& buffer, std::size_t& position, \
                    Dune::MPIHelper::MPICommunicator comm); \
 template void unpack(std::vector<__VA_ARGS__>& data, \
-                     std::vector<char>& buffer, int& position, \
+                     std::vector<char>& buffer, std::size_t& position, \
                      Dune::MPIHelper::MPICommunicator comm);
 
 INSTANTIATE_PACK_VECTOR(double)
@@ -6449,10 +6408,10 @@ INSTANTIATE_PACK_VECTOR(IntervalTabulated2DFunction<double>)
 template std::size_t packSize(const std::shared_ptr<__VA_ARGS__>& data, \
                               Dune::MPIHelper::MPICommunicator comm); \
 template void pack(const std::shared_ptr<__VA_ARGS__>& data, \
-                   std::vector<char>& buffer, int& position, \
+                   std::vector<char>& buffer, std::size_t& position, \
                    Dune::MPIHelper::MPICommunicator comm); \
 template void unpack(std::shared_ptr<__VA_ARGS__>& data, \
-                     std::vector<char>& buffer, int& position, \
+                     std::vector<char>& buffer, std::size_t& position, \
                      Dune::MPIHelper::MPICommunicator comm);
 
 INSTANTIATE_PACK_SHARED_PTR(Opm::GasPvtMultiplexer<double, true>)
@@ -6465,10 +6424,10 @@ INSTANTIATE_PACK_SHARED_PTR(SpiralICD)
 template std::size_t packSize(const __VA_ARGS__& data, \
                               Dune::MPIHelper::MPICommunicator comm); \
 template void pack(const __VA_ARGS__& data, \
-                   std::vector<char>& buffer, int& position, \
+                   std::vector<char>& buffer, std::size_t& position, \
                    Dune::MPIHelper::MPICommunicator comm); \
 template void unpack(__VA_ARGS__& data, \
-                     std::vector<char>& buffer, int& position, \
+                     std::vector<char>& buffer, std::size_t& position, \
                      Dune::MPIHelper::MPICommunicator comm);
 
 INSTANTIATE_PACK(double)
@@ -6520,20 +6479,17 @@ RestartValue loadParallelRestart(const EclipseIO* eclIO, SummaryState& summarySt
     {
         assert(comm.rank() == 0);
         restartValues = eclIO->loadRestart(summaryState, solutionKeys, extraKeys);
-        int packedSize = Mpi::packSize(restartValues, comm);
-        std::vector<char> buffer(packedSize);
-        int position=0;
+        std::vector<char> buffer;
+        std::size_t position = 0;
         Mpi::pack(restartValues, buffer, position, comm);
-        comm.broadcast(&position, 1, 0);
-        comm.broadcast(buffer.data(), position, 0);
+        buffer.resize(position);
+        Mpi::broadcastBuffer(buffer, comm);
     }
     else
     {
-        int bufferSize{};
-        comm.broadcast(&bufferSize, 1, 0);
-        std::vector<char> buffer(bufferSize);
-        comm.broadcast(buffer.data(), bufferSize, 0);
-        int position{};
+        std::vector<char> buffer;
+        Mpi::broadcastBuffer(buffer, comm);
+        std::size_t position = 0;
         Mpi::unpack(restartValues, buffer, position, comm);
     }
     return restartValues;
@@ -55,6 +55,9 @@
 
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <set>
 #include <tuple>
 #include <vector>
@@ -316,349 +319,349 @@ std::size_t packSize(const EclEpsScalingPointsInfo<Scalar>& data,
 ////// pack routines
 
 template<class T>
-void pack(const T*, std::size_t, std::vector<char>&, int&,
+void pack(const T*, std::size_t, std::vector<char>&, std::size_t&,
           Dune::MPIHelper::MPICommunicator, std::integral_constant<bool, false>);
 
 template<class T>
-void pack(const T* data, std::size_t l, std::vector<char>& buffer, int& position,
+void pack(const T* data, std::size_t l, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm, std::integral_constant<bool, true>);
 
 template<class T>
-void pack(const T* data, std::size_t l, std::vector<char>& buffer, int& position,
+void pack(const T* data, std::size_t l, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
-void pack(const T&, std::vector<char>&, int&,
+void pack(const T&, std::vector<char>&, std::size_t&,
           Dune::MPIHelper::MPICommunicator, std::integral_constant<bool, false>);
 
 template<class T>
-void pack(const T& data, std::vector<char>& buffer, int& position,
+void pack(const T& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm, std::integral_constant<bool, true>);
 
 
 template<class T>
-void pack(const T& data, std::vector<char>& buffer, int& position,
+void pack(const T& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T1, class T2>
-void pack(const std::pair<T1,T2>& data, std::vector<char>& buffer, int& position,
+void pack(const std::pair<T1,T2>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T, class A>
-void pack(const std::vector<T,A>& data, std::vector<char>& buffer, int& position,
+void pack(const std::vector<T,A>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class A>
-void pack(const std::vector<bool,A>& data, std::vector<char>& buffer, int& position,
+void pack(const std::vector<bool,A>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class... Ts>
 void pack(const std::tuple<Ts...>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class K, class C, class A>
 void pack(const std::set<K,C,A>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T, class H, class KE, class A>
 void pack(const std::unordered_set<T,H,KE,A>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
-void pack(const std::shared_ptr<T>& data, std::vector<char>& buffer, int& position,
+void pack(const std::shared_ptr<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T, size_t N>
-void pack(const std::array<T,N>& data, std::vector<char>& buffer, int& position,
+void pack(const std::array<T,N>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
-void pack(const std::unique_ptr<T>& data, std::vector<char>& buffer, int& position,
+void pack(const std::unique_ptr<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T1, class T2, class C, class A>
-void pack(const std::map<T1,T2,C,A>& data, std::vector<char>& buffer, int& position,
+void pack(const std::map<T1,T2,C,A>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T1, class T2, class H, class P, class A>
-void pack(const std::unordered_map<T1,T2,H,P,A>& data, std::vector<char>& buffer, int& position,
+void pack(const std::unordered_map<T1,T2,H,P,A>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class Key, class Value>
 void pack(const OrderedMap<Key,Value>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
 void pack(const DynamicState<T>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
 void pack(const DynamicVector<T>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const Tabulated1DFunction<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const IntervalTabulated2DFunction<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const UniformXTabulated2DFunction<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const SolventPvt<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar, bool enableThermal>
 void pack(const GasPvtMultiplexer<Scalar,enableThermal>& data,
-          const std::vector<char>& buffer, int& position,
+          const std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const DryGasPvt<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const GasPvtThermal<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const WetGasPvt<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar, bool enableThermal>
 void pack(const OilPvtMultiplexer<Scalar,enableThermal>& data,
-          const std::vector<char>& buffer, int& position,
+          const std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const ConstantCompressibilityOilPvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const DeadOilPvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const LiveOilPvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const OilPvtThermal<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar, bool enableThermal, bool enableBrine>
 void pack(const WaterPvtMultiplexer<Scalar,enableThermal,enableBrine>& data,
-          const std::vector<char>& buffer, int& position,
+          const std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const ConstantCompressibilityWaterPvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const ConstantCompressibilityBrinePvt<Scalar>& data,
-          std::vector<char>& buffer, int& position,
+          std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const WaterPvtThermal<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
 void pack(const IOrderSet<T>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void pack(const EclEpsScalingPointsInfo<Scalar>& data, std::vector<char>& buffer,
-          int& position, Dune::MPIHelper::MPICommunicator comm);
+          std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
-void pack(const char* str, std::vector<char>& buffer, int& position,
+void pack(const char* str, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 /// unpack routines
 
 template<class T>
-void unpack(T*, const std::size_t&, std::vector<char>&, int&,
+void unpack(T*, const std::size_t&, std::vector<char>&, std::size_t&,
             Dune::MPIHelper::MPICommunicator, std::integral_constant<bool, false>);
 
 template<class T>
-void unpack(T* data, const std::size_t& l, std::vector<char>& buffer, int& position,
+void unpack(T* data, const std::size_t& l, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm,
             std::integral_constant<bool, true>);
 
 template<class T>
-void unpack(T* data, const std::size_t& l, std::vector<char>& buffer, int& position,
+void unpack(T* data, const std::size_t& l, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
-void unpack(T&, std::vector<char>&, int&,
+void unpack(T&, std::vector<char>&, std::size_t&,
             Dune::MPIHelper::MPICommunicator, std::integral_constant<bool, false>);
 
 template<class T>
-void unpack(T& data, std::vector<char>& buffer, int& position,
+void unpack(T& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm, std::integral_constant<bool, true>);
 
 template<class T>
-void unpack(T& data, std::vector<char>& buffer, int& position,
+void unpack(T& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class T1, class T2>
-void unpack(std::pair<T1,T2>& data, std::vector<char>& buffer, int& position,
+void unpack(std::pair<T1,T2>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class T, class A>
-void unpack(std::vector<T,A>& data, std::vector<char>& buffer, int& position,
+void unpack(std::vector<T,A>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class A>
-void unpack(std::vector<bool,A>& data, std::vector<char>& buffer, int& position,
+void unpack(std::vector<bool,A>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class... Ts>
 void unpack(std::tuple<Ts...>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class K, class C, class A>
 void unpack(std::set<K,C,A>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class T, class H, class KE, class A>
 void unpack(std::unordered_set<T,H,KE,A>& data,
-            std::vector<char>& buffer, int& position,
+            std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
-void unpack(std::shared_ptr<T>& data, std::vector<char>& buffer, int& position,
+void unpack(std::shared_ptr<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T, size_t N>
-void unpack(std::array<T,N>& data, std::vector<char>& buffer, int& position,
+void unpack(std::array<T,N>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
-void unpack(std::unique_ptr<T>& data, std::vector<char>& buffer, int& position,
+void unpack(std::unique_ptr<T>& data, std::vector<char>& buffer, std::size_t& position,
           Dune::MPIHelper::MPICommunicator comm);
 
 template<class T1, class T2, class C, class A>
-void unpack(std::map<T1,T2,C,A>& data, std::vector<char>& buffer, int& position,
+void unpack(std::map<T1,T2,C,A>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class T1, class T2, class H, class P, class A>
-void unpack(std::unordered_map<T1,T2,H,P,A>& data, std::vector<char>& buffer, int& position,
+void unpack(std::unordered_map<T1,T2,H,P,A>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class Key, class Value>
-void unpack(OrderedMap<Key,Value>& data, std::vector<char>& buffer, int& position,
+void unpack(OrderedMap<Key,Value>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
-void unpack(DynamicState<T>& data, std::vector<char>& buffer, int& position,
+void unpack(DynamicState<T>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
-void unpack(DynamicVector<T>& data, std::vector<char>& buffer, int& position,
+void unpack(DynamicVector<T>& data, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(Tabulated1DFunction<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(IntervalTabulated2DFunction<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(UniformXTabulated2DFunction<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(SolventPvt<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar, bool enableThermal>
 void unpack(GasPvtMultiplexer<Scalar,enableThermal>& data,
-            const std::vector<char>& buffer, int& position,
+            const std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(DryGasPvt<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(GasPvtThermal<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(WetGasPvt<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar, bool enableThermal>
 void unpack(OilPvtMultiplexer<Scalar,enableThermal>& data,
-            const std::vector<char>& buffer, int& position,
+            const std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(ConstantCompressibilityOilPvt<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(DeadOilPvt<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(LiveOilPvt<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(OilPvtThermal<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar, bool enableThermal, bool enableBrine>
 void unpack(WaterPvtMultiplexer<Scalar,enableThermal,enableBrine>& data,
-            const std::vector<char>& buffer, int& position,
+            const std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(WaterPvtThermal<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(ConstantCompressibilityWaterPvt<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(ConstantCompressibilityBrinePvt<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class T>
 void unpack(IOrderSet<T>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
 template<class Scalar>
 void unpack(EclEpsScalingPointsInfo<Scalar>& data, std::vector<char>& buffer,
-            int& position, Dune::MPIHelper::MPICommunicator comm);
+            std::size_t& position, Dune::MPIHelper::MPICommunicator comm);
 
-void unpack(char* str, std::size_t length, std::vector<char>& buffer, int& position,
+void unpack(char* str, std::size_t length, std::vector<char>& buffer, std::size_t& position,
             Dune::MPIHelper::MPICommunicator comm);
 
 /// prototypes for complex types
 
 #define ADD_PACK_PROTOTYPES(T) \
   std::size_t packSize(const T& data, Dune::MPIHelper::MPICommunicator comm); \
-  void pack(const T& data, std::vector<char>& buffer, int& position, \
+  void pack(const T& data, std::vector<char>& buffer, std::size_t& position, \
           Dune::MPIHelper::MPICommunicator comm); \
-  void unpack(T& data, std::vector<char>& buffer, int& position, \
+  void unpack(T& data, std::vector<char>& buffer, std::size_t& position, \
               Dune::MPIHelper::MPICommunicator comm);
 
 ADD_PACK_PROTOTYPES(Actdims)
@@ -804,29 +807,55 @@ ADD_PACK_PROTOTYPES(WellTracerProperties)
 ADD_PACK_PROTOTYPES(WList)
 ADD_PACK_PROTOTYPES(WListManager)
 
+//! \brief Broadcast a buffer from rank 0 to all processes.
+//! \details The size is sent as a 64 bit value and the data in pieces
+//!          which fit into the int counts of MPI, such that buffers larger
+//!          than 2 GB can be sent. On ranks other than 0 the buffer is
+//!          resized to the size of the one of rank 0.
+template<class C>
+void broadcastBuffer(std::vector<char>& buffer, const C& comm)
+{
+    std::uint64_t size = buffer.size();
+    comm.broadcast(&size, 1, 0);
+    buffer.resize(size);
+
+    const std::size_t maxChunk = std::numeric_limits<int>::max();
+    for (std::size_t offset = 0; offset < buffer.size(); offset += maxChunk) {
+        const int count = static_cast<int>(std::min(maxChunk, buffer.size() - offset));
+        comm.broadcast(buffer.data() + offset, count, 0);
+    }
+}
+
+//! \brief Pack an object into a buffer in a single pass.
+//! \details The buffer grows while the object is packed, and is shrunk to
+//!          the packed size afterwards.
+template<class T, class C>
+std::vector<char> packToBuffer(const T& in, const C& comm)
+{
+    std::vector<char> buffer;
+    std::size_t pos = 0;
+    Mpi::pack(in, buffer, pos, comm);
+    buffer.resize(pos);
+    return buffer;
+}
+
 template<class T, class C>
 const T& packAndSend(const T& in, const C& comm)
 {
     if (comm.size() == 1)
         return in;
 
-    std::size_t size = packSize(in, comm);
-    std::vector<char> buffer(size);
-    int pos = 0;
-    Mpi::pack(in, buffer, pos, comm);
-    comm.broadcast(&pos, 1, 0);
-    comm.broadcast(buffer.data(), pos, 0);
+    std::vector<char> buffer = packToBuffer(in, comm);
+    broadcastBuffer(buffer, comm);
     return in;
 }
 
 template<class T, class C>
 void receiveAndUnpack(T& result, const C& comm)
 {
-    int size;
-    comm.broadcast(&size, 1, 0);
-    std::vector<char> buffer(size);
-    comm.broadcast(buffer.data(), size, 0);
-    int pos = 0;
+    std::vector<char> buffer;
+    broadcastBuffer(buffer, comm);
+    std::size_t pos = 0;
     unpack(result, buffer, pos, comm);
 }
 } // end namespace Mpi
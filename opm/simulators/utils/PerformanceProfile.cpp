@@ -0,0 +1,253 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#include <opm/simulators/utils/PerformanceProfile.hpp>
+
+#include <opm/common/OpmLog/OpmLog.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    bool inParallelRegion()
+    {
+#ifdef _OPENMP
+        return omp_in_parallel();
+#else
+        return false;
+#endif
+    }
+
+    // order the paths such that every timer is directly followed by the
+    // timers and counters nested below it
+    bool pathLess(const std::string& a, const std::string& b)
+    {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+                                            [](char x, char y) {
+                                                return (x == '/' ? '\0' : x) < (y == '/' ? '\0' : y);
+                                            });
+    }
+
+    std::string jsonString(const std::string& s)
+    {
+        std::string result = "\"";
+        for (const char c : s) {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result + "\"";
+    }
+
+    struct Statistics
+    {
+        std::vector<double> min, max, sum;
+
+        Statistics(const std::vector<double>& local, const Opm::PerformanceProfile::Communication& comm)
+            : min(local), max(local), sum(local)
+        {
+            if (local.empty())
+                return;
+            comm.min(min.data(), min.size());
+            comm.max(max.data(), max.size());
+            comm.sum(sum.data(), sum.size());
+        }
+
+        void writeJson(std::ostream& os, std::size_t idx, int numProcesses) const
+        {
+            os << "{\"min\": " << min[idx] << ", \"max\": " << max[idx]
+               << ", \"mean\": " << sum[idx]/numProcesses << "}";
+        }
+    };
+}
+
+namespace Opm
+{
+
+    bool PerformanceProfile::enabled_ = false;
+    std::vector<PerformanceProfile::Entry> PerformanceProfile::entries_(1);
+    std::vector<std::size_t> PerformanceProfile::scope_(1, 0);
+
+    void PerformanceProfile::ScopedTimer::start_(const char* name)
+    {
+        if (inParallelRegion())
+            return;
+
+        scope_.push_back(child_(name));
+        active_ = true;
+        start_time_ = std::chrono::steady_clock::now();
+    }
+
+    void PerformanceProfile::ScopedTimer::stop_()
+    {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time_;
+        Entry& entry = entries_[scope_.back()];
+        entry.time += elapsed.count();
+        ++entry.calls;
+        scope_.pop_back();
+    }
+
+    std::size_t PerformanceProfile::child_(const char* name)
+    {
+        const std::size_t parent = scope_.back();
+        const auto it = entries_[parent].children.find(name);
+        if (it != entries_[parent].children.end())
+            return it->second;
+
+        const std::size_t idx = entries_.size();
+        Entry entry;
+        entry.path = parent == 0 ? std::string(name) : entries_[parent].path + "/" + name;
+        entries_.push_back(std::move(entry));
+        entries_[parent].children.emplace(name, idx);
+        return idx;
+    }
+
+    void PerformanceProfile::count_(const char* name, long long value)
+    {
+        if (inParallelRegion())
+            return;
+
+        entries_[child_(name)].count += value;
+    }
+
+    void PerformanceProfile::clear()
+    {
+        entries_.assign(1, Entry());
+        scope_.assign(1, 0);
+    }
+
+    void PerformanceProfile::report(const Communication& comm, const std::string& jsonFileName)
+    {
+        // the union of the timers and counters of all processes
+        std::vector<std::string> paths;
+        for (std::size_t idx = 1; idx < entries_.size(); ++idx)
+            paths.push_back(entries_[idx].path);
+
+        if (comm.size() > 1) {
+            std::vector<char> localNames;
+            for (const auto& path : paths)
+                localNames.insert(localNames.end(), path.c_str(), path.c_str() + path.size() + 1);
+
+            int localSize = localNames.size();
+            std::vector<int> sizes(comm.size()), offsets(comm.size() + 1, 0);
+            comm.gather(&localSize, sizes.data(), 1, 0);
+            std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+            std::vector<char> allNames(comm.rank() == 0 ? offsets.back() : 0);
+            comm.gatherv(localNames.data(), localSize, allNames.data(), sizes.data(), offsets.data(), 0);
+
+            std::vector<char> names;
+            if (comm.rank() == 0) {
+                std::vector<std::string> all;
+                for (std::size_t pos = 0; pos < allNames.size(); pos += all.back().size() + 1)
+                    all.emplace_back(&allNames[pos]);
+                std::sort(all.begin(), all.end());
+                all.erase(std::unique(all.begin(), all.end()), all.end());
+                for (const auto& path : all)
+                    names.insert(names.end(), path.c_str(), path.c_str() + path.size() + 1);
+            }
+            int size = names.size();
+            comm.broadcast(&size, 1, 0);
+            names.resize(size);
+            comm.broadcast(names.data(), size, 0);
+
+            paths.clear();
+            for (std::size_t pos = 0; pos < names.size(); pos += paths.back().size() + 1)
+                paths.emplace_back(&names[pos]);
+        }
+        std::sort(paths.begin(), paths.end(), pathLess);
+
+        std::map<std::string, std::size_t> localIndex;
+        for (std::size_t idx = 1; idx < entries_.size(); ++idx)
+            localIndex[entries_[idx].path] = idx;
+
+        const std::size_t numPaths = paths.size();
+        std::vector<double> localTime(numPaths, 0.0), localCalls(numPaths, 0.0), localCount(numPaths, 0.0);
+        for (std::size_t i = 0; i < numPaths; ++i) {
+            const auto it = localIndex.find(paths[i]);
+            if (it == localIndex.end())
+                continue;
+            const Entry& entry = entries_[it->second];
+            localTime[i] = entry.time;
+            localCalls[i] = entry.calls;
+            localCount[i] = entry.count;
+        }
+
+        const Statistics time(localTime, comm);
+        const Statistics calls(localCalls, comm);
+        const Statistics count(localCount, comm);
+        if (comm.rank() != 0)
+            return;
+
+        const int numProcesses = comm.size();
+        std::ostringstream ss;
+        ss << "Performance profile of " << numProcesses << " process(es):\n"
+           << std::left << std::setw(40) << "timer/counter" << std::right
+           << std::setw(10) << "calls" << std::setw(12) << "min [s]" << std::setw(12) << "max [s]"
+           << std::setw(12) << "mean [s]" << std::setw(10) << "max/mean" << std::setw(14) << "count" << "\n";
+        for (std::size_t i = 0; i < numPaths; ++i) {
+            const std::size_t depth = std::count(paths[i].begin(), paths[i].end(), '/');
+            const std::size_t nameBegin = paths[i].rfind('/') + 1;
+            const std::string name = std::string(2*depth, ' ') + paths[i].substr(nameBegin);
+            ss << std::left << std::setw(40) << name << std::right;
+            if (calls.max[i] > 0) {
+                const double mean = time.sum[i]/numProcesses;
+                ss << std::setw(10) << static_cast<long long>(calls.max[i])
+                   << std::fixed << std::setprecision(3)
+                   << std::setw(12) << time.min[i] << std::setw(12) << time.max[i] << std::setw(12) << mean
+                   << std::setprecision(2) << std::setw(10) << (mean > 0.0 ? time.max[i]/mean : 1.0);
+            }
+            else
+                ss << std::setw(56) << "";
+            if (count.max[i] > 0)
+                ss << std::setw(14) << static_cast<long long>(count.sum[i]);
+            ss << std::defaultfloat << "\n";
+        }
+        OpmLog::info(ss.str());
+
+        if (jsonFileName.empty())
+            return;
+
+        std::ofstream json(jsonFileName);
+        if (!json)
+            throw std::runtime_error("Cannot write performance profile '" + jsonFileName + "'");
+
+        json << std::setprecision(9)
+             << "{\n  \"processes\": " << numProcesses << ",\n  \"entries\": [";
+        for (std::size_t i = 0; i < numPaths; ++i) {
+            json << (i == 0 ? "\n" : ",\n") << "    {\"name\": " << jsonString(paths[i]) << ", \"calls\": ";
+            calls.writeJson(json, i, numProcesses);
+            json << ", \"time\": ";
+            time.writeJson(json, i, numProcesses);
+            json << ", \"count\": ";
+            count.writeJson(json, i, numProcesses);
+            json << "}";
+        }
+        json << "\n  ]\n}\n";
+    }
+
+} // namespace Opm
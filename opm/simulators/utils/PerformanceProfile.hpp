@@ -0,0 +1,126 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PERFORMANCEPROFILE_HEADER_INCLUDED
+#define OPM_PERFORMANCEPROFILE_HEADER_INCLUDED
+
+#include <dune/common/parallel/collectivecommunication.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Opm
+{
+
+    /// Hierarchical profile of named timers and counters of a process.
+    ///
+    /// Timers are started by creating a ScopedTimer and stopped when it goes
+    /// out of scope. Timers and counters are nested below the timers running
+    /// when they are started, so "assembly" > "wells" > "PROD1" records the
+    /// time of the well PROD1 within the well part of the assembly. At the end
+    /// of a run, report() combines the profiles of all processes into the
+    /// minimum, maximum and mean over the processes.
+    ///
+    /// The profile is disabled by default, in which case a ScopedTimer costs a
+    /// single test of a flag. Timers and counters started inside an OpenMP
+    /// parallel region are ignored.
+    class PerformanceProfile
+    {
+    public:
+        typedef Dune::CollectiveCommunication<Dune::MPIHelper::MPICommunicator> Communication;
+
+        class ScopedTimer
+        {
+        public:
+            explicit ScopedTimer(const char* name)
+            {
+                if (PerformanceProfile::enabled())
+                    start_(name);
+            }
+
+            explicit ScopedTimer(const std::string& name)
+            {
+                if (PerformanceProfile::enabled())
+                    start_(name.c_str());
+            }
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+            ~ScopedTimer()
+            {
+                if (active_)
+                    stop_();
+            }
+
+        private:
+            void start_(const char* name);
+            void stop_();
+
+            bool active_ = false;
+            std::chrono::steady_clock::time_point start_time_;
+        };
+
+        static bool enabled()
+        { return enabled_; }
+
+        /// Enable or disable the recording of timers and counters.
+        static void setEnabled(bool enabled)
+        { enabled_ = enabled; }
+
+        /// Add value to the counter with the given name below the running timer.
+        static void count(const char* name, long long value)
+        {
+            if (enabled_)
+                count_(name, value);
+        }
+
+        /// Discard all timers and counters recorded so far.
+        static void clear();
+
+        /// Combine the profiles of all processes of comm. On rank 0 a table
+        /// is written to the log and, if jsonFileName is not empty, the
+        /// profile is written to that file in JSON format. This is a
+        /// collective operation.
+        static void report(const Communication& comm, const std::string& jsonFileName);
+
+    private:
+        struct Entry
+        {
+            std::string path;
+            double time = 0.0;
+            long long calls = 0;
+            long long count = 0;
+            std::map<std::string, std::size_t, std::less<>> children;
+        };
+
+        static std::size_t child_(const char* name);
+        static void count_(const char* name, long long value);
+
+        static bool enabled_;
+        static std::vector<Entry> entries_;
+        static std::vector<std::size_t> scope_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_PERFORMANCEPROFILE_HEADER_INCLUDED
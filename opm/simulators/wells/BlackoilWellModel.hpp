@@ -31,6 +31,8 @@
 #include <opm/common/utility/platform_dependent/reenable_warnings.h>
 
 #include <cassert>
+#include <map>
+#include <string>
 #include <tuple>
 
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
@@ -47,6 +49,7 @@
 #include <opm/simulators/wells/WellInterface.hpp>
 #include <opm/simulators/wells/StandardWell.hpp>
 #include <opm/simulators/wells/MultisegmentWell.hpp>
+#include <opm/simulators/wells/WellSchurComplement.hpp>
 #include <opm/simulators/wells/WellGroupHelpers.hpp>
 #include <opm/simulators/timestepping/gatherConvergenceReport.hpp>
 #include <dune/common/fmatrix.hh>
@@ -56,6 +59,8 @@
 #include <opm/material/densead/Math.hpp>
 
 #include <opm/simulators/utils/DeferredLogger.hpp>
+#include <opm/simulators/utils/Checkpoint.hpp>
+#include <opm/simulators/utils/PerformanceProfile.hpp>
 
 BEGIN_PROPERTIES
 
@@ -129,20 +134,38 @@ namespace Opm {
             // </ eWoms auxiliary module stuff>
             /////////////
 
+            /*!
+             * \brief This method restores the state of the wells at the end of a
+             *        report step written by serialize().
+             */
             template <class Restarter>
-            void deserialize(Restarter& /* res */)
+            void deserialize(Restarter& res)
             {
-                // TODO (?)
+                res.deserializeSectionBegin("BlackoilWellModel");
+                auto& is = res.deserializeStream();
+                Checkpoint::read(is, initial_step_);
+                previous_well_state_.deserialize(is);
+                res.deserializeSectionEnd();
+
+                well_state_ = previous_well_state_;
             }
 
             /*!
              * \brief This method writes the complete state of the well
              *        to the harddisk.
+             *
+             * Only the committed well state is written, i.e., the state the wells
+             * are restarted from at the beginning of the next time step. The well
+             * test state and the guide rates are not part of it.
              */
             template <class Restarter>
-            void serialize(Restarter& /* res*/)
+            void serialize(Restarter& res)
             {
-                // TODO (?)
+                res.serializeSectionBegin("BlackoilWellModel");
+                auto& os = res.serializeStream();
+                Checkpoint::write(os, initial_step_);
+                previous_well_state_.serialize(os);
+                res.serializeSectionEnd();
             }
 
             void beginEpisode()
@@ -195,6 +218,11 @@ namespace Opm {
             // apply well model with scaling of alpha
             void applyScaleAdd(const Scalar alpha, const BVector& x, BVector& Ax) const;
 
+            // the flat storage of the well matrices used by apply(), or nullptr if the
+            // wells are not linearized or some of them are applied one by one
+            const WellSchurComplement<Scalar, numEq>* schurComplement() const
+            { return schur_complement_ready_ && wells_applied_separately_.empty() ? &schur_complement_ : nullptr; }
+
             // Check if well equations is converged.
             ConvergenceReport getWellConvergence(const std::vector<Scalar>& B_avg) const;
 
@@ -214,9 +242,26 @@ namespace Opm {
                 }
             }
 
+            // the perforated cells of the wells whose couplings are part of the
+            // sparsity pattern of the Jacobian if the well contributions are added
+            // to the matrix, i.e., of the wells of the current report step
+            const std::vector<std::vector<int>>& wellSparsityCells() const
+            { return well_sparsity_cells_; }
+
+            // incremented whenever wellSparsityCells() changes
+            int wellSparsityRevision() const
+            { return well_sparsity_revision_; }
+
             // called at the beginning of a report step
             void beginReportStep(const int time_step);
 
+            // replace the target of a control of a well, starting with the next report
+            // step. the control is named like in WCONPROD or WCONINJE, e.g. "ORAT",
+            // "BHP" or "RATE", becomes the active control of the well and its target is
+            // given in SI units. the target is used until the schedule changes the
+            // controls of the well.
+            void setWellTarget(const std::string& wellName, const std::string& control, const double value);
+
             /// Return true if any well has a THP constraint.
             bool hasTHPConstraints() const;
 
@@ -228,6 +273,14 @@ namespace Opm {
             Simulator& ebosSimulator_;
 
             std::vector< Well > wells_ecl_;
+
+            struct WellTargetOverride
+            {
+                std::string control;
+                double value;
+                int firstReportStep;
+            };
+            std::map<std::string, WellTargetOverride> well_target_overrides_;
             std::vector< std::vector<PerforationData> > well_perf_data_;
             std::vector<int> first_perf_index_;
 
@@ -243,6 +296,20 @@ namespace Opm {
 
             void initializeWellPerfData();
 
+            // replace the targets of the wells in wells_ecl_ set by setWellTarget()
+            void applyWellTargetOverrides(const int timeStepIdx);
+
+            // the couplings of the wells in the sparsity pattern of the Jacobian,
+            // see wellSparsityCells()
+            std::vector<std::vector<int>> well_sparsity_cells_;
+            bool well_sparsity_initialized_ = false;
+            int well_sparsity_revision_ = 0;
+
+            // update the well couplings of the sparsity pattern to the open
+            // connections of wells_ecl_. the Jacobian is recreated by the next
+            // linearization if they have changed.
+            void updateWellSparsity();
+
             // create the well container
             std::vector<WellInterfacePtr > createWellContainer(const int time_step);
 
@@ -277,6 +344,12 @@ namespace Opm {
             // used to better efficiency of calcuation
             mutable BVector scaleAddRes_;
 
+            // the well matrices of the wells applied in the Krylov iterations,
+            // collected in linearize(), and the wells which are not part of it
+            WellSchurComplement<Scalar, numEq> schur_complement_;
+            std::vector<const WellInterface<TypeTag>*> wells_applied_separately_;
+            bool schur_complement_ready_ = false;
+
             const Grid& grid() const
             { return ebosSimulator_.vanguard().grid(); }
 
@@ -301,6 +374,9 @@ namespace Opm {
             // xw to update Well State
             void recoverWellSolutionAndUpdateWellState(const BVector& x);
 
+            // collect the well matrices for the application of the Schur complement
+            void setupSchurComplement();
+
             void updateWellControls(Opm::DeferredLogger& deferred_logger, const bool checkGroupControl, const bool checkCurrentGroupControl);
 
             // setting the well_solutions_ based on well_state.
@@ -22,6 +22,7 @@
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 #include <opm/simulators/wells/SimFIBODetails.hpp>
+#include <opm/simulators/flow/EnsembleDefinition.hpp>
 #include <opm/core/props/phaseUsageFromDeck.hpp>
 
 namespace Opm {
@@ -84,6 +85,17 @@ namespace Opm {
             return;
         }
 
+        // only the wells of the current report step are coupled, once it is known
+        if (well_sparsity_initialized_) {
+            for (const auto& wellCells : well_sparsity_cells_) {
+                for (int cellIdx : wellCells) {
+                    neighbors[cellIdx].insert(wellCells.begin(),
+                                              wellCells.end());
+                }
+            }
+            return;
+        }
+
         // Create cartesian to compressed mapping
         const auto& schedule_wells = schedule().getWellsatEnd();
         const auto& cartesianSize = Opm::UgGridHelpers::cartDims(grid());
@@ -132,6 +144,7 @@ namespace Opm {
                 // r = r - duneC_^T * invDuneD_ * resWell_
                 well->apply(res);
             }
+            setupSchurComplement();
             return;
         }
 
@@ -142,6 +155,29 @@ namespace Opm {
             // r = r - duneC_^T * invDuneD_ * resWell_
             well->apply(res);
         }
+        setupSchurComplement();
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    setupSchurComplement()
+    {
+        // collect the matrices of the wells into the flat storage applied in
+        // the Krylov iterations, and keep a compact list of the remaining
+        // wells which still need to be applied one by one.
+        schur_complement_.clear();
+        wells_applied_separately_.clear();
+        for (const auto& well: well_container_) {
+            if (!well->addToSchurComplement(schur_complement_)) {
+                wells_applied_separately_.push_back(well.get());
+            }
+        }
+        schur_complement_ready_ = true;
     }
 
 
@@ -222,7 +258,11 @@ namespace Opm {
             w.erase(std::remove_if(w.begin(), w.end(), is_shut_or_defunct), w.end());
             wells_ecl_.swap(w);
         }
+        applyWellTargetOverrides(timeStepIdx);
         initializeWellPerfData();
+        if (param_.matrix_add_well_contributions_) {
+            updateWellSparsity();
+        }
 
         // Wells are active if they are active wells on at least
         // one process.
@@ -279,7 +319,8 @@ namespace Opm {
                                                  + ScheduleEvents::INJECTION_UPDATE
                                                  + ScheduleEvents::NEW_WELL;
 
-            if(!schedule().hasWellGroupEvent(well.name(), effective_events_mask, timeStepIdx))
+            if(!schedule().hasWellGroupEvent(well.name(), effective_events_mask, timeStepIdx)
+               && well_target_overrides_.count(well.name()) == 0)
                 continue;
 
             if (well.isProducer()) {
@@ -310,6 +351,96 @@ namespace Opm {
     }
 
 
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    setWellTarget(const std::string& wellName, const std::string& control, const double value)
+    {
+        const int reportStepIdx = ebosSimulator_.episodeIndex() + 1;
+        if (!schedule().hasWell(wellName))
+            OPM_THROW(std::invalid_argument, "The well " + wellName + " is not in the schedule");
+
+        // reject invalid controls here instead of at the next report step
+        const Well& well = schedule().getWell(wellName, std::max(reportStepIdx - 1, 0));
+        if (well.isProducer())
+            Well::ProducerCModeFromString(control);
+        else
+            Well::InjectorCModeFromString(control);
+
+        well_target_overrides_[wellName] = WellTargetOverride{control, value, reportStepIdx};
+    }
+
+
+
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    applyWellTargetOverrides(const int timeStepIdx)
+    {
+        const uint64_t control_events_mask = ScheduleEvents::PRODUCTION_UPDATE
+                                           + ScheduleEvents::INJECTION_UPDATE;
+        for (auto it = well_target_overrides_.begin(); it != well_target_overrides_.end(); ) {
+            if (timeStepIdx > it->second.firstReportStep
+                && schedule().hasWellGroupEvent(it->first, control_events_mask, timeStepIdx))
+                it = well_target_overrides_.erase(it);
+            else
+                ++it;
+        }
+
+        for (auto& well : wells_ecl_) {
+            const auto it = well_target_overrides_.find(well.name());
+            if (it == well_target_overrides_.end())
+                continue;
+
+            const auto& target = it->second;
+            auto targetValue = [&target](const UDAValue& uda) {
+                return UDAValue(uda.get_dim().convertSiToRaw(target.value), uda.get_dim());
+            };
+
+            if (well.isProducer()) {
+                auto properties = std::make_shared<Well::WellProductionProperties>(well.getProductionProperties());
+                const auto cmode = Well::ProducerCModeFromString(target.control);
+                switch (cmode) {
+                case Well::ProducerCMode::ORAT: properties->OilRate = targetValue(properties->OilRate); break;
+                case Well::ProducerCMode::WRAT: properties->WaterRate = targetValue(properties->WaterRate); break;
+                case Well::ProducerCMode::GRAT: properties->GasRate = targetValue(properties->GasRate); break;
+                case Well::ProducerCMode::LRAT: properties->LiquidRate = targetValue(properties->LiquidRate); break;
+                case Well::ProducerCMode::RESV: properties->ResVRate = targetValue(properties->ResVRate); break;
+                case Well::ProducerCMode::BHP: properties->BHPTarget = targetValue(properties->BHPTarget); break;
+                case Well::ProducerCMode::THP: properties->THPTarget = targetValue(properties->THPTarget); break;
+                default:
+                    OPM_THROW(std::invalid_argument, "The target of the control " + target.control + " of well " + well.name() + " cannot be set");
+                }
+                properties->predictionMode = true;
+                properties->controlMode = cmode;
+                properties->addProductionControl(cmode);
+                well.updateProduction(properties);
+            }
+            else {
+                auto properties = std::make_shared<Well::WellInjectionProperties>(well.getInjectionProperties());
+                const auto cmode = Well::InjectorCModeFromString(target.control);
+                switch (cmode) {
+                case Well::InjectorCMode::RATE: properties->surfaceInjectionRate = targetValue(properties->surfaceInjectionRate); break;
+                case Well::InjectorCMode::RESV: properties->reservoirInjectionRate = targetValue(properties->reservoirInjectionRate); break;
+                case Well::InjectorCMode::BHP: properties->BHPTarget = targetValue(properties->BHPTarget); break;
+                case Well::InjectorCMode::THP: properties->THPTarget = targetValue(properties->THPTarget); break;
+                default:
+                    OPM_THROW(std::invalid_argument, "The target of the control " + target.control + " of well " + well.name() + " cannot be set");
+                }
+                properties->predictionMode = true;
+                properties->controlMode = cmode;
+                properties->addInjectionControl(cmode);
+                well.updateInjection(properties);
+            }
+        }
+    }
+
+
+
+
+
     // called at the beginning of a time step
     template<typename TypeTag>
     void
@@ -330,6 +461,7 @@ namespace Opm {
 
             // create the well container
             well_container_ = createWellContainer(reportStepIdx);
+            schur_complement_ready_ = false;
 
             // do the initialization for all the wells
             // TODO: to see whether we can postpone of the intialization of the well containers to
@@ -570,12 +702,53 @@ namespace Opm {
 
 
 
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    updateWellSparsity()
+    {
+        // the couplings only depend on the set of perforated cells of each well
+        std::vector<std::vector<int>> sparsityCells;
+        sparsityCells.reserve(well_perf_data_.size());
+        for (const auto& perfData : well_perf_data_) {
+            std::vector<int> wellCells;
+            wellCells.reserve(perfData.size());
+            for (const auto& perf : perfData) {
+                wellCells.push_back(perf.cell_index);
+            }
+            std::sort(wellCells.begin(), wellCells.end());
+            wellCells.erase(std::unique(wellCells.begin(), wellCells.end()), wellCells.end());
+            // a single perforated cell only couples with itself
+            if (wellCells.size() > 1) {
+                sparsityCells.push_back(std::move(wellCells));
+            }
+        }
+        std::sort(sparsityCells.begin(), sparsityCells.end());
+
+        if (well_sparsity_initialized_ && sparsityCells == well_sparsity_cells_) {
+            return;
+        }
+
+        well_sparsity_cells_.swap(sparsityCells);
+        well_sparsity_initialized_ = true;
+        ++well_sparsity_revision_;
+
+        // the linearizer collects the neighbors of the auxiliary modules when it
+        // creates the Jacobian
+        ebosSimulator_.model().linearizer().eraseMatrix();
+    }
+
+
+
+
+
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
     initializeWellPerfData()
     {
-        const auto& grid = ebosSimulator_.vanguard().grid();
+        const auto& vanguard = ebosSimulator_.vanguard();
+        const auto& grid = vanguard.grid();
         const auto& cartDims = Opm::UgGridHelpers::cartDims(grid);
         well_perf_data_.resize(wells_ecl_.size());
         first_perf_index_.clear();
@@ -600,6 +773,22 @@ namespace Opm {
                         PerforationData pd;
                         pd.cell_index = active_index;
                         pd.connection_transmissibility_factor = completion.CF() * completion.wellPi();
+                        // the factors computed from the permeabilities of the deck must
+                        // follow the permeability multipliers of an ensemble realization
+                        // like the transmissibilities between the cells do
+                        if (completion.kind() == Connection::CTFKind::Defaulted) {
+                            try {
+                                pd.connection_transmissibility_factor *=
+                                    connectionFactorMultiplier(vanguard.fieldPropertyMultiplier("PERMX", cart_grid_indx),
+                                                               vanguard.fieldPropertyMultiplier("PERMY", cart_grid_indx),
+                                                               vanguard.fieldPropertyMultiplier("PERMZ", cart_grid_indx),
+                                                               completion.dir());
+                            }
+                            catch (const std::invalid_argument& e) {
+                                OPM_THROW(std::runtime_error, "Connection " << i << " " << j << " " << k
+                                          << " of well " << well.name() << ": " << e.what());
+                            }
+                        }
                         pd.satnum_id = completion.satTableId();
                         well_perf_data_[well_index].push_back(pd);
                     }
@@ -823,11 +1012,14 @@ namespace Opm {
     {
 
         last_report_ = SimulatorReport();
+        // the well matrices are about to change
+        schur_complement_ready_ = false;
 
         if ( ! wellsActive() ) {
             return;
         }
 
+        PerformanceProfile::ScopedTimer profileTimer("wells");
         Opm::DeferredLogger local_deferredLogger;
 
         updatePerforationIntensiveQuantities();
@@ -883,6 +1075,7 @@ namespace Opm {
     assembleWellEq(const std::vector<Scalar>& B_avg, const double dt, Opm::DeferredLogger& deferred_logger)
     {
         for (auto& well : well_container_) {
+            PerformanceProfile::ScopedTimer profileTimer(well->name());
             well->assembleWellEq(ebosSimulator_, B_avg, dt, well_state_, deferred_logger);
         }
     }
@@ -913,7 +1106,15 @@ namespace Opm {
             return;
         }
 
-        for (auto& well : well_container_) {
+        if (!schur_complement_ready_) {
+            for (auto& well : well_container_) {
+                well->apply(x, Ax);
+            }
+            return;
+        }
+
+        schur_complement_.apply(x, Ax);
+        for (const auto* well : wells_applied_separately_) {
             well->apply(x, Ax);
         }
     }
@@ -183,6 +183,8 @@ namespace Opm
         /// r = r - C D^-1 Rw
         virtual void apply(BVector& r) const override;
 
+        virtual bool addToSchurComplement(WellSchurComplement<Scalar, numEq>& schur) const override;
+
         /// using the solution x to recover the solution xw for wells and applying
         /// xw to update Well State
         virtual void recoverWellSolutionAndUpdateWellState(const BVector& x,
@@ -2739,6 +2739,28 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    bool
+    StandardWell<TypeTag>::
+    addToSchurComplement(WellSchurComplement<Scalar, numEq>& schur) const
+    {
+        // the same wells as in apply() do not contribute
+        if (!this->isOperable() && !this->wellIsStopped()) return true;
+
+        if ( param_.matrix_add_well_contributions_ )
+        {
+            // Contributions are already in the matrix itself
+            return true;
+        }
+
+        schur.addWell(duneB_, duneC_, invDuneD_);
+        return true;
+    }
+
+
+
+
+
     template<typename TypeTag>
     void
     StandardWell<TypeTag>::
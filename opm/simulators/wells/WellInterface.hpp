@@ -40,6 +40,7 @@
 #include <opm/simulators/wells/WellHelpers.hpp>
 #include <opm/simulators/wells/WellGroupHelpers.hpp>
 #include <opm/simulators/wells/WellStateFullyImplicitBlackoil.hpp>
+#include <opm/simulators/wells/WellSchurComplement.hpp>
 #include <opm/simulators/flow/BlackoilModelParametersEbos.hpp>
 
 #include <opm/simulators/timestepping/ConvergenceReport.hpp>
@@ -190,6 +191,14 @@ namespace Opm
         /// r = r - C D^-1 Rw
         virtual void apply(BVector& r) const = 0;
 
+        /// Add the well matrices to the flat storage used to apply the
+        /// Schur complement of all wells at once. Returns false if the well
+        /// cannot be stored there and must be applied through apply().
+        virtual bool addToSchurComplement(WellSchurComplement<Scalar, numEq>&) const
+        {
+            return false;
+        }
+
         // TODO: before we decide to put more information under mutable, this function is not const
         virtual void computeWellPotentials(const Simulator& ebosSimulator,
                                            const std::vector<Scalar>& B_avg,
@@ -0,0 +1,292 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_WELLSCHURCOMPLEMENT_HEADER_INCLUDED
+#define OPM_WELLSCHURCOMPLEMENT_HEADER_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace Opm {
+
+    /// Flat storage of the well matrices B, C and D^-1 of all wells whose
+    /// Schur complement contribution A -= C^T D^-1 B is applied during the
+    /// Krylov iterations.
+    ///
+    /// The blocks of all wells are stored back to back in contiguous
+    /// arrays, one numWellEq x numEq block of B and C per perforation and
+    /// one numWellEq x numWellEq block of D^-1 per well, all row major.
+    /// This makes the application of the well part of the operator a
+    /// single streaming loop instead of one virtual call and three sparse
+    /// matrix products per well. Wells whose B or C matrices vanish do not
+    /// contribute and are not stored.
+    template <class Scalar, int numEq>
+    class WellSchurComplement
+    {
+    public:
+        WellSchurComplement()
+        {
+            clear();
+        }
+
+        void clear()
+        {
+            cells_.clear();
+            B_.clear();
+            C_.clear();
+            invD_.clear();
+            numWellEq_.clear();
+            maxNumWellEq_ = 0;
+            perfOffset_.assign(1, 0);
+            invDOffset_.assign(1, 0);
+            valueOffset_.assign(1, 0);
+        }
+
+        /// Add the matrices of a well. B and C are matrices with a single
+        /// block row with one block per perforated cell, invD has a single
+        /// block.
+        template <class OffDiagMatrix, class DiagMatrix>
+        void addWell(const OffDiagMatrix& B, const OffDiagMatrix& C, const DiagMatrix& invD)
+        {
+            if (B.N() == 0 || isZero_(B) || isZero_(C)) {
+                return;
+            }
+
+            const auto& invDBlock = invD[0][0];
+            const int numWellEq = invDBlock.N();
+            for (int i = 0; i < numWellEq; ++i) {
+                for (int j = 0; j < numWellEq; ++j) {
+                    invD_.push_back(invDBlock[i][j]);
+                }
+            }
+
+            auto colC = C[0].begin();
+            for (auto colB = B[0].begin(), endB = B[0].end(); colB != endB; ++colB, ++colC) {
+                assert(colC != C[0].end() && colC.index() == colB.index());
+                cells_.push_back(colB.index());
+                for (int i = 0; i < numWellEq; ++i) {
+                    for (int j = 0; j < numEq; ++j) {
+                        B_.push_back((*colB)[i][j]);
+                        C_.push_back((*colC)[i][j]);
+                    }
+                }
+            }
+
+            numWellEq_.push_back(numWellEq);
+            perfOffset_.push_back(cells_.size());
+            invDOffset_.push_back(invD_.size());
+            valueOffset_.push_back(B_.size());
+            maxNumWellEq_ = std::max(maxNumWellEq_, numWellEq);
+        }
+
+        /// Ax = Ax - C^T D^-1 B x for all stored wells. The scratch space is
+        /// local, so several threads may apply the same object concurrently.
+        template <class BVector>
+        void apply(const BVector& x, BVector& Ax) const
+        {
+            std::vector<Scalar> work(2*maxNumWellEq_);
+            Scalar* Bx = work.data();
+            Scalar* invDBx = Bx + maxNumWellEq_;
+
+            for (std::size_t w = 0; w < numWellEq_.size(); ++w) {
+                const int numWellEq = numWellEq_[w];
+                const std::size_t perfBegin = perfOffset_[w];
+                const std::size_t perfEnd = perfOffset_[w + 1];
+                const Scalar* BWell = &B_[valueOffset_[w]];
+                const Scalar* CWell = &C_[valueOffset_[w]];
+
+                // Bx = B x
+                std::fill(Bx, Bx + numWellEq, 0.0);
+                for (std::size_t perf = perfBegin; perf < perfEnd; ++perf) {
+                    const auto& xCell = x[cells_[perf]];
+                    const Scalar* block = BWell + (perf - perfBegin)*numWellEq*numEq;
+                    for (int i = 0; i < numWellEq; ++i) {
+                        for (int j = 0; j < numEq; ++j) {
+                            Bx[i] += block[i*numEq + j] * xCell[j];
+                        }
+                    }
+                }
+
+                // invDBx = D^-1 Bx
+                const Scalar* invD = &invD_[invDOffset_[w]];
+                for (int i = 0; i < numWellEq; ++i) {
+                    Scalar value = 0.0;
+                    for (int j = 0; j < numWellEq; ++j) {
+                        value += invD[i*numWellEq + j] * Bx[j];
+                    }
+                    invDBx[i] = value;
+                }
+
+                // Ax = Ax - C^T invDBx
+                for (std::size_t perf = perfBegin; perf < perfEnd; ++perf) {
+                    auto& AxCell = Ax[cells_[perf]];
+                    const Scalar* block = CWell + (perf - perfBegin)*numWellEq*numEq;
+                    for (int i = 0; i < numWellEq; ++i) {
+                        for (int j = 0; j < numEq; ++j) {
+                            AxCell[j] -= block[i*numEq + j] * invDBx[i];
+                        }
+                    }
+                }
+            }
+        }
+
+        /// Insert the couplings between the perforated cells of each well into
+        /// the sparsity pattern given as the set of columns of every row.
+        void addCouplings(std::vector<std::set<int>>& pattern) const
+        {
+            for (std::size_t w = 0; w < numWellEq_.size(); ++w) {
+                for (std::size_t i = perfOffset_[w]; i < perfOffset_[w + 1]; ++i) {
+                    for (std::size_t j = perfOffset_[w]; j < perfOffset_[w + 1]; ++j) {
+                        pattern[cells_[i]].insert(cells_[j]);
+                    }
+                }
+            }
+        }
+
+        /// A = A - C^T D^-1 B for all stored wells. The sparsity pattern of A
+        /// must contain the couplings given by addCouplings().
+        template <class Matrix>
+        void subtractFromMatrix(Matrix& A) const
+        {
+            std::vector<Scalar> invDB;
+            for (std::size_t w = 0; w < numWellEq_.size(); ++w) {
+                const int numWellEq = numWellEq_[w];
+                const std::size_t perfBegin = perfOffset_[w];
+                const std::size_t perfEnd = perfOffset_[w + 1];
+                const Scalar* invD = &invD_[invDOffset_[w]];
+                for (std::size_t j = perfBegin; j < perfEnd; ++j) {
+                    // invDB = D^-1 B_j
+                    const Scalar* B = &B_[valueOffset_[w] + (j - perfBegin)*numWellEq*numEq];
+                    invDB.assign(numWellEq*numEq, 0.0);
+                    for (int i = 0; i < numWellEq; ++i)
+                        for (int k = 0; k < numWellEq; ++k)
+                            for (int l = 0; l < numEq; ++l)
+                                invDB[i*numEq + l] += invD[i*numWellEq + k] * B[k*numEq + l];
+
+                    for (std::size_t i = perfBegin; i < perfEnd; ++i) {
+                        // A_ij -= C_i^T invDB
+                        const Scalar* C = &C_[valueOffset_[w] + (i - perfBegin)*numWellEq*numEq];
+                        auto& block = A[cells_[i]][cells_[j]];
+                        for (int k = 0; k < numWellEq; ++k)
+                            for (int r = 0; r < numEq; ++r)
+                                for (int c = 0; c < numEq; ++c)
+                                    block[r][c] -= C[k*numEq + r] * invDB[k*numEq + c];
+                    }
+                }
+            }
+        }
+
+        /// Write the stored matrices in binary form.
+        void write(std::ostream& os) const
+        {
+            writeVector_(os, numWellEq_);
+            writeVector_(os, perfOffset_);
+            writeVector_(os, cells_);
+            writeVector_(os, B_);
+            writeVector_(os, C_);
+            writeVector_(os, invD_);
+        }
+
+        /// Read matrices written by write(), replacing the stored ones.
+        void read(std::istream& is)
+        {
+            clear();
+            readVector_(is, numWellEq_);
+            readVector_(is, perfOffset_);
+            readVector_(is, cells_);
+            readVector_(is, B_);
+            readVector_(is, C_);
+            readVector_(is, invD_);
+
+            if (perfOffset_.size() != numWellEq_.size() + 1 || perfOffset_.back() != cells_.size()) {
+                throw std::runtime_error("Inconsistent well matrices");
+            }
+            for (std::size_t w = 0; w < numWellEq_.size(); ++w) {
+                const std::size_t numWellEq = numWellEq_[w];
+                const std::size_t numPerfs = perfOffset_[w + 1] - perfOffset_[w];
+                invDOffset_.push_back(invDOffset_.back() + numWellEq*numWellEq);
+                valueOffset_.push_back(valueOffset_.back() + numPerfs*numWellEq*numEq);
+                maxNumWellEq_ = std::max(maxNumWellEq_, numWellEq_[w]);
+            }
+            if (invDOffset_.back() != invD_.size() || valueOffset_.back() != B_.size() || B_.size() != C_.size()) {
+                throw std::runtime_error("Inconsistent well matrices");
+            }
+        }
+
+        /// The number of wells stored.
+        int numWells() const
+        { return numWellEq_.size(); }
+
+        /// The number of perforations of the stored wells.
+        std::size_t numPerforations() const
+        { return cells_.size(); }
+
+    private:
+        template <class T>
+        static void writeVector_(std::ostream& os, const std::vector<T>& v)
+        {
+            const std::uint64_t size = v.size();
+            os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            os.write(reinterpret_cast<const char*>(v.data()), size*sizeof(T));
+        }
+
+        template <class T>
+        static void readVector_(std::istream& is, std::vector<T>& v)
+        {
+            std::uint64_t size = 0;
+            is.read(reinterpret_cast<char*>(&size), sizeof(size));
+            v.resize(size);
+            is.read(reinterpret_cast<char*>(v.data()), size*sizeof(T));
+            if (!is) {
+                throw std::runtime_error("Cannot read well matrices");
+            }
+        }
+
+        template <class OffDiagMatrix>
+        static bool isZero_(const OffDiagMatrix& M)
+        {
+            for (auto col = M[0].begin(), end = M[0].end(); col != end; ++col) {
+                if (col->infinity_norm() != 0.0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        std::vector<int> cells_;
+        std::vector<Scalar> B_;
+        std::vector<Scalar> C_;
+        std::vector<Scalar> invD_;
+        std::vector<int> numWellEq_;
+        std::vector<std::size_t> perfOffset_;
+        std::vector<std::size_t> invDOffset_;
+        std::vector<std::size_t> valueOffset_;
+        // the largest number of equations of a stored well
+        int maxNumWellEq_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_WELLSCHURCOMPLEMENT_HEADER_INCLUDED
@@ -24,10 +24,13 @@
 #include <opm/output/data/Wells.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well/Well.hpp>
 #include <opm/simulators/wells/PerforationData.hpp>
+#include <opm/simulators/utils/Checkpoint.hpp>
 
 #include <array>
+#include <istream>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 #include <cassert>
@@ -216,6 +219,36 @@ namespace Opm
         WellState(const WellState& rhs)  = default;
         WellState& operator=(const WellState& rhs) = default;
 
+        /// Write the state to a binary checkpoint.
+        void serialize(std::ostream& os) const
+        {
+            Checkpoint::write(os, bhp_);
+            Checkpoint::write(os, thp_);
+            Checkpoint::write(os, temperature_);
+            Checkpoint::write(os, wellrates_);
+            Checkpoint::write(os, perfrates_);
+            Checkpoint::write(os, perfpress_);
+            Checkpoint::write(os, np_);
+            Checkpoint::write(os, open_for_output_);
+            Checkpoint::write(os, wellMap_);
+            Checkpoint::write(os, well_perf_data_);
+        }
+
+        /// Restore the state written by serialize().
+        void deserialize(std::istream& is)
+        {
+            Checkpoint::read(is, bhp_);
+            Checkpoint::read(is, thp_);
+            Checkpoint::read(is, temperature_);
+            Checkpoint::read(is, wellrates_);
+            Checkpoint::read(is, perfrates_);
+            Checkpoint::read(is, perfpress_);
+            Checkpoint::read(is, np_);
+            Checkpoint::read(is, open_for_output_);
+            Checkpoint::read(is, wellMap_);
+            Checkpoint::read(is, well_perf_data_);
+        }
+
     private:
         std::vector<double> bhp_;
         std::vector<double> thp_;
@@ -919,6 +919,76 @@ namespace Opm
             return globalIsProductionGrup_[it->second];
         }
 
+        /// Write the state to a binary checkpoint.
+        void serialize(std::ostream& os) const
+        {
+            BaseType::serialize(os);
+            Checkpoint::write(os, perfphaserates_);
+            Checkpoint::write(os, current_injection_controls_);
+            Checkpoint::write(os, current_production_controls_);
+            Checkpoint::write(os, globalIsInjectionGrup_);
+            Checkpoint::write(os, globalIsProductionGrup_);
+            Checkpoint::write(os, wellNameToGlobalIdx_);
+            Checkpoint::write(os, current_production_group_controls_);
+            Checkpoint::write(os, current_injection_group_controls_);
+            Checkpoint::write(os, production_group_reduction_rates);
+            Checkpoint::write(os, injection_group_reduction_rates);
+            Checkpoint::write(os, injection_group_reservoir_rates);
+            Checkpoint::write(os, injection_group_potentials);
+            Checkpoint::write(os, injection_group_vrep_rates);
+            Checkpoint::write(os, injection_group_rein_rates);
+            Checkpoint::write(os, perfRateSolvent_);
+            Checkpoint::write(os, perf_water_throughput_);
+            Checkpoint::write(os, perf_skin_pressure_);
+            Checkpoint::write(os, perf_water_velocity_);
+            Checkpoint::write(os, well_reservoir_rates_);
+            Checkpoint::write(os, well_dissolved_gas_rates_);
+            Checkpoint::write(os, well_vaporized_oil_rates_);
+            Checkpoint::write(os, effective_events_occurred_);
+            Checkpoint::write(os, segrates_);
+            Checkpoint::write(os, segpress_);
+            Checkpoint::write(os, top_segment_index_);
+            Checkpoint::write(os, nseg_);
+            Checkpoint::write(os, productivity_index_);
+            Checkpoint::write(os, well_potentials_);
+            Checkpoint::write(os, seg_number_);
+        }
+
+        /// Restore the state written by serialize().
+        void deserialize(std::istream& is)
+        {
+            BaseType::deserialize(is);
+            Checkpoint::read(is, perfphaserates_);
+            Checkpoint::read(is, current_injection_controls_);
+            Checkpoint::read(is, current_production_controls_);
+            Checkpoint::read(is, globalIsInjectionGrup_);
+            Checkpoint::read(is, globalIsProductionGrup_);
+            Checkpoint::read(is, wellNameToGlobalIdx_);
+            Checkpoint::read(is, current_production_group_controls_);
+            Checkpoint::read(is, current_injection_group_controls_);
+            Checkpoint::read(is, production_group_reduction_rates);
+            Checkpoint::read(is, injection_group_reduction_rates);
+            Checkpoint::read(is, injection_group_reservoir_rates);
+            Checkpoint::read(is, injection_group_potentials);
+            Checkpoint::read(is, injection_group_vrep_rates);
+            Checkpoint::read(is, injection_group_rein_rates);
+            Checkpoint::read(is, perfRateSolvent_);
+            Checkpoint::read(is, perf_water_throughput_);
+            Checkpoint::read(is, perf_skin_pressure_);
+            Checkpoint::read(is, perf_water_velocity_);
+            Checkpoint::read(is, well_reservoir_rates_);
+            Checkpoint::read(is, well_dissolved_gas_rates_);
+            Checkpoint::read(is, well_vaporized_oil_rates_);
+            Checkpoint::read(is, effective_events_occurred_);
+            Checkpoint::read(is, segrates_);
+            Checkpoint::read(is, segpress_);
+            Checkpoint::read(is, top_segment_index_);
+            Checkpoint::read(is, nseg_);
+            Checkpoint::read(is, productivity_index_);
+            Checkpoint::read(is, well_potentials_);
+            Checkpoint::read(is, seg_number_);
+        }
+
     private:
         std::vector<double> perfphaserates_;
         std::vector<Opm::Well::InjectorCMode> current_injection_controls_;
@@ -0,0 +1,300 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Python bindings of the black-oil simulator of flow.
+//
+//     from simulators import BlackOilSimulator
+//     sim = BlackOilSimulator("CASE.DATA", ["--output-mode=none"])
+//     sim.step_init()
+//     while not sim.done():
+//         sim.set_well_target("PROD", "ORAT", 0.01)   # SI units
+//         sim.step()
+//         p = sim.pressure()
+//     sim.step_cleanup()
+//
+// The arrays returned by the accessors refer to the cells and wells of the
+// calling process and are read-only:
+//
+// - primary_variables() is a view of the solution vector of the simulator;
+// - pressure() and saturation() are views of buffers of the bindings. The
+//   values are copied from the simulator after every report step and are
+//   updated in place, so an array shows the state of the last report step;
+// - well_rates() is a copy, since the well state is reallocated at the
+//   beginning of every report step.
+//
+// The views keep the simulator alive.
+
+#include "config.h"
+
+#include <opm/simulators/flow/SimulatorFullyImplicitBlackoilEbos.hpp>
+#include <opm/simulators/flow/FlowMainEbos.hpp>
+#include <opm/material/common/ResetLocale.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace Opm
+{
+namespace Pybind
+{
+
+class BlackOilSimulator
+{
+public:
+    typedef TTAG(EclFlowProblem) TypeTag;
+    typedef GET_PROP_TYPE(TypeTag, Simulator) EbosSimulator;
+    typedef GET_PROP_TYPE(TypeTag, Scalar) Scalar;
+    typedef GET_PROP_TYPE(TypeTag, Indices) Indices;
+    typedef GET_PROP_TYPE(TypeTag, FluidSystem) FluidSystem;
+    typedef GET_PROP_TYPE(TypeTag, ElementContext) ElementContext;
+    typedef GET_PROP_TYPE(TypeTag, PrimaryVariables) PrimaryVariables;
+
+    enum { numEq = GET_PROP_VALUE(TypeTag, NumEq) };
+    enum { numPhases = FluidSystem::numPhases };
+
+    BlackOilSimulator(const std::string& deckFilename,
+                      const std::vector<std::string>& args)
+    {
+        args_.push_back("flow");
+        args_.insert(args_.end(), args.begin(), args.end());
+        args_.push_back(deckFilename);
+    }
+
+    /// Parse the deck and prepare the simulation of the report steps.
+    void stepInit()
+    {
+        if (main_)
+            throw std::logic_error("step_init() has already been called");
+
+        std::vector<char*> argv;
+        for (auto& arg : args_)
+            argv.push_back(&arg[0]);
+        int argc = argv.size();
+        argv.push_back(nullptr);
+
+        Opm::resetLocale();
+        char** argvPtr = argv.data();
+        const auto& mpiHelper = Dune::MPIHelper::instance(argc, argvPtr);
+        outputCout_ = (mpiHelper.rank() == 0);
+
+        main_.reset(new Opm::FlowMainEbos<TypeTag>());
+        if (main_->executeInitStep(argc, argv.data(), outputCout_) != EXIT_SUCCESS)
+            throw std::runtime_error("The simulation could not be set up");
+        updateCellData_();
+    }
+
+    /// Simulate the next report step.
+    void step()
+    {
+        if (main_->executeStep(outputCout_) != EXIT_SUCCESS)
+            throw std::runtime_error("The report step could not be simulated");
+        updateCellData_();
+    }
+
+    bool done() const
+    { return main_->executeStepsDone(); }
+
+    /// Finish the simulation, i.e. write the remaining output.
+    void stepCleanup()
+    {
+        if (main_->executeStepsCleanup(outputCout_, /*output_to_files=*/true) != EXIT_SUCCESS)
+            throw std::runtime_error("The simulation could not be finished");
+    }
+
+    int currentStep() const
+    { return main_->simulatorTimer().currentStepNum(); }
+
+    int numSteps() const
+    { return main_->simulatorTimer().numSteps(); }
+
+    double currentTime() const
+    { return main_->simulatorTimer().simulationTimeElapsed(); }
+
+    /// The primary variables of the cells, one row per cell. This is a
+    /// read-only view of the solution vector of the simulator, whose meaning
+    /// differs between cells depending on the phases present.
+    py::array primaryVariables(py::object self)
+    {
+        auto& solution = ebosSimulator_().model().solution(/*timeIdx=*/0);
+        std::array<py::ssize_t, 2> shape = {static_cast<py::ssize_t>(solution.size()), numEq};
+        std::array<py::ssize_t, 2> strides = {sizeof(PrimaryVariables), sizeof(Scalar)};
+        return readOnly_(py::array_t<Scalar>(shape, strides, &solution[0][0], self));
+    }
+
+    /// The pressure of the oil phase in the cells (of the water phase if
+    /// there is no oil phase), updated in place after every report step.
+    py::array pressure(py::object self)
+    { return readOnly_(py::array_t<Scalar>(pressure_.size(), pressure_.data(), self)); }
+
+    /// The saturation of a phase ("water", "oil" or "gas") in the cells,
+    /// updated in place after every report step.
+    py::array saturation(py::object self, const std::string& phase)
+    {
+        const auto& sat = saturation_[phaseIdx_(phase)];
+        return readOnly_(py::array_t<Scalar>(sat.size(), sat.data(), self));
+    }
+
+    /// The surface rates of the wells of the calling process, one row per
+    /// well in the order of well_names(). This is a copy of the rates of the
+    /// well state at the end of the last report step.
+    py::array wellRates() const
+    {
+        const auto& rates = wellState_().wellRates();
+        const py::ssize_t np = wellState_().numPhases();
+        std::array<py::ssize_t, 2> shape = {static_cast<py::ssize_t>(np > 0 ? rates.size()/np : 0), np};
+        py::array_t<double> result(shape);
+        std::copy(rates.begin(), rates.end(), result.mutable_data());
+        return readOnly_(result);
+    }
+
+    std::vector<std::string> wellNames() const
+    {
+        const auto& wellMap = wellState_().wellMap();
+        std::vector<std::string> names(wellMap.size());
+        for (const auto& well : wellMap)
+            names[well.second[0]] = well.first;
+        return names;
+    }
+
+    /// Set the target of a control of a well for the next report steps, see
+    /// BlackoilWellModel::setWellTarget().
+    void setWellTarget(const std::string& wellName, const std::string& control, double value)
+    { ebosSimulator_().problem().wellModel().setWellTarget(wellName, control, value); }
+
+    double summaryValue(const std::string& key) const
+    {
+        const auto& summaryState = main_->ebosSimulator().vanguard().summaryState();
+        if (!summaryState.has(key))
+            throw py::key_error(key);
+        return summaryState.get(key);
+    }
+
+private:
+    EbosSimulator& ebosSimulator_()
+    {
+        if (!main_)
+            throw std::logic_error("step_init() must be called first");
+        return main_->ebosSimulator();
+    }
+
+    const Opm::WellStateFullyImplicitBlackoil& wellState_() const
+    {
+        if (!main_)
+            throw std::logic_error("step_init() must be called first");
+        return main_->ebosSimulator().problem().wellModel().wellState();
+    }
+
+    static py::array readOnly_(py::array array)
+    {
+        array.attr("setflags")(py::arg("write") = false);
+        return array;
+    }
+
+    static unsigned phaseIdx_(const std::string& phase)
+    {
+        unsigned phaseIdx;
+        if (phase == "water")
+            phaseIdx = FluidSystem::waterPhaseIdx;
+        else if (phase == "oil")
+            phaseIdx = FluidSystem::oilPhaseIdx;
+        else if (phase == "gas")
+            phaseIdx = FluidSystem::gasPhaseIdx;
+        else
+            throw std::invalid_argument("Unknown phase '" + phase + "'");
+
+        if (!FluidSystem::phaseIsActive(phaseIdx))
+            throw std::invalid_argument("The phase '" + phase + "' is not active");
+        return phaseIdx;
+    }
+
+    // the buffers are resized only once, so the arrays handed out stay valid
+    void updateCellData_()
+    {
+        auto& simulator = ebosSimulator_();
+        const auto& gridView = simulator.vanguard().gridView();
+        const std::size_t numCells = simulator.model().numGridDof();
+        pressure_.resize(numCells, 0.0);
+        for (auto& sat : saturation_)
+            sat.resize(numCells, 0.0);
+
+        ElementContext elemCtx(simulator);
+        const auto& elemEndIt = gridView.template end</*codim=*/0>();
+        for (auto elemIt = gridView.template begin</*codim=*/0>(); elemIt != elemEndIt; ++elemIt) {
+            elemCtx.updatePrimaryStencil(*elemIt);
+            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+
+            const unsigned cellIdx = elemCtx.globalSpaceIndex(/*spaceIdx=*/0, /*timeIdx=*/0);
+            const auto& fs = elemCtx.intensiveQuantities(/*spaceIdx=*/0, /*timeIdx=*/0).fluidState();
+            const unsigned pressurePhaseIdx = Indices::oilEnabled
+                ? FluidSystem::oilPhaseIdx
+                : (Indices::waterEnabled ? FluidSystem::waterPhaseIdx : FluidSystem::gasPhaseIdx);
+            pressure_[cellIdx] = Opm::getValue(fs.pressure(pressurePhaseIdx));
+            for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx)
+                if (FluidSystem::phaseIsActive(phaseIdx))
+                    saturation_[phaseIdx][cellIdx] = Opm::getValue(fs.saturation(phaseIdx));
+        }
+    }
+
+    std::vector<std::string> args_;
+    bool outputCout_ = false;
+    std::unique_ptr<Opm::FlowMainEbos<TypeTag>> main_;
+    std::vector<Scalar> pressure_;
+    std::array<std::vector<Scalar>, numPhases> saturation_;
+};
+
+} // namespace Pybind
+} // namespace Opm
+
+PYBIND11_MODULE(simulators, m)
+{
+    using Opm::Pybind::BlackOilSimulator;
+
+    py::class_<BlackOilSimulator>(m, "BlackOilSimulator")
+        .def(py::init<const std::string&, const std::vector<std::string>&>(),
+             py::arg("deck_filename"), py::arg("args") = std::vector<std::string>())
+        .def("step_init", &BlackOilSimulator::stepInit)
+        .def("step", &BlackOilSimulator::step)
+        .def("done", &BlackOilSimulator::done)
+        .def("step_cleanup", &BlackOilSimulator::stepCleanup)
+        .def("current_step", &BlackOilSimulator::currentStep)
+        .def("num_steps", &BlackOilSimulator::numSteps)
+        .def("current_time", &BlackOilSimulator::currentTime)
+        .def("primary_variables", [](py::object self) {
+                return self.cast<BlackOilSimulator&>().primaryVariables(self); })
+        .def("pressure", [](py::object self) {
+                return self.cast<BlackOilSimulator&>().pressure(self); })
+        .def("saturation", [](py::object self, const std::string& phase) {
+                return self.cast<BlackOilSimulator&>().saturation(self, phase); },
+             py::arg("phase"))
+        .def("well_rates", &BlackOilSimulator::wellRates)
+        .def("well_names", &BlackOilSimulator::wellNames)
+        .def("set_well_target", &BlackOilSimulator::setWellTarget,
+             py::arg("well"), py::arg("control"), py::arg("value"))
+        .def("summary_value", &BlackOilSimulator::summaryValue, py::arg("key"));
+}
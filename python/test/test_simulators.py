@@ -0,0 +1,73 @@
+# Smoke test of the Python bindings of the black-oil simulator.
+#
+#     python test_simulators.py <deck>
+#
+# The module "simulators" must be found in the PYTHONPATH.
+
+import sys
+import tempfile
+import unittest
+
+import numpy as np
+
+from simulators import BlackOilSimulator
+
+
+class TestBlackOilSimulator(unittest.TestCase):
+    deck = None
+
+    # the parameters of the simulator can only be set up once per process,
+    # hence all checks run on the same simulation
+    def test_step_and_getters(self):
+        output_dir = tempfile.mkdtemp()
+        sim = BlackOilSimulator(self.deck, ["--output-dir=" + output_dir,
+                                            "--enable-terminal-output=false"])
+        sim.step_init()
+        self.assertEqual(sim.current_step(), 0)
+        self.assertGreater(sim.num_steps(), 1)
+        self.assertFalse(sim.done())
+
+        pressure = sim.pressure()
+        num_cells = pressure.shape[0]
+        self.assertGreater(num_cells, 0)
+        self.assertTrue(np.all(pressure > 0.0))
+        self.assertFalse(pressure.flags.writeable)
+
+        primary_variables = sim.primary_variables()
+        self.assertEqual(primary_variables.shape[0], num_cells)
+        self.assertFalse(primary_variables.flags.writeable)
+
+        total_saturation = sum(sim.saturation(phase) for phase in ("water", "oil", "gas"))
+        np.testing.assert_allclose(total_saturation, 1.0, rtol=1e-10)
+        with self.assertRaises(ValueError):
+            sim.saturation("solvent")
+
+        sim.step()
+        self.assertEqual(sim.current_step(), 1)
+        self.assertGreater(sim.current_time(), 0.0)
+
+        # the pressure array is updated in place
+        np.testing.assert_array_equal(pressure, sim.pressure())
+
+        # the well rates are a copy which stays valid across report steps
+        names = sim.well_names()
+        rates = sim.well_rates()
+        rates_before = np.array(rates)
+        self.assertEqual(rates.shape[0], len(names))
+        self.assertGreater(len(names), 0)
+        self.assertTrue(np.all(np.isfinite(rates)))
+
+        with self.assertRaises(KeyError):
+            sim.summary_value("NO_SUCH_KEY")
+
+        while not sim.done():
+            sim.step()
+        np.testing.assert_array_equal(rates, rates_before)
+        self.assertEqual(sim.current_step(), sim.num_steps())
+
+        sim.step_cleanup()
+
+
+if __name__ == "__main__":
+    TestBlackOilSimulator.deck = sys.argv.pop(1)
+    unittest.main()
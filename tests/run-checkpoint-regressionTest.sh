@@ -0,0 +1,59 @@
+#!/bin/bash
+
+# This runs a simulator from start to end while it writes a checkpoint after
+# every report step, then continues a second run of the simulator from the
+# last checkpoint, before comparing the output from the two runs.
+# This is meant to track regressions in the checkpoint support.
+
+INPUT_DATA_PATH="$1"
+RESULT_PATH="$2"
+BINPATH="$3"
+FILENAME="$4"
+ABS_TOL="$5"
+REL_TOL="$6"
+COMPARE_ECL_COMMAND="$7"
+OPM_PACK_COMMAND="$8"
+PARALLEL="${9}"
+EXE_NAME="${10}"
+shift 10
+DECK="$1"
+shift 1
+TEST_ARGS="$@"
+
+CHECKPOINT_FILE=${RESULT_PATH}/checkpoint/${FILENAME}
+
+rm -Rf ${RESULT_PATH}
+mkdir -p ${RESULT_PATH}/checkpoint ${RESULT_PATH}/resumed
+cd ${RESULT_PATH}
+if test $PARALLEL -eq 1
+then
+  CMD_PREFIX="mpirun -np 4 "
+else
+  CMD_PREFIX=""
+fi
+
+# a tiny interval writes a checkpoint after every report step but the last
+${CMD_PREFIX} ${BINPATH}/${EXE_NAME} ${DECK}.DATA --output-dir=${RESULT_PATH} --checkpoint-interval=1e-9 --checkpoint-file=${CHECKPOINT_FILE} ${TEST_ARGS}
+test $? -eq 0 || exit 1
+
+${CMD_PREFIX} ${BINPATH}/${EXE_NAME} ${DECK}.DATA --output-dir=${RESULT_PATH}/resumed --resume-from-checkpoint=true --checkpoint-file=${CHECKPOINT_FILE} ${TEST_ARGS}
+test $? -eq 0 || exit 1
+
+ecode=0
+echo "=== Executing comparison for summary file ==="
+${COMPARE_ECL_COMMAND} -R -t SMRY ${RESULT_PATH}/${FILENAME} ${RESULT_PATH}/resumed/${FILENAME} ${ABS_TOL} ${REL_TOL}
+if [ $? -ne 0 ]
+then
+  ecode=1
+  ${COMPARE_ECL_COMMAND} -a -R -t SMRY ${RESULT_PATH}/${FILENAME} ${RESULT_PATH}/resumed/${FILENAME} ${ABS_TOL} ${REL_TOL}
+fi
+
+echo "=== Executing comparison for restart file ==="
+${COMPARE_ECL_COMMAND} -l -t UNRST ${RESULT_PATH}/${FILENAME} ${RESULT_PATH}/resumed/${FILENAME} ${ABS_TOL} ${REL_TOL}
+if [ $? -ne 0 ]
+then
+  ecode=1
+  ${COMPARE_ECL_COMMAND} -a -l -t UNRST ${RESULT_PATH}/${FILENAME} ${RESULT_PATH}/resumed/${FILENAME} ${ABS_TOL} ${REL_TOL}
+fi
+
+exit $ecode
@@ -0,0 +1,48 @@
+#!/bin/bash
+
+# This runs a simulator twice, first with its default options and then
+# with the given test arguments, and compares the summary files of the
+# two runs. It then reports the time step chops, Newton
+# iterations, linearizations and wall times of both runs, to compare
+# the cost of a solution strategy with the default one.
+
+INPUT_DATA_PATH="$1"
+RESULT_PATH="$2"
+BINPATH="$3"
+FILENAME="$4"
+ABS_TOL="$5"
+REL_TOL="$6"
+COMPARE_ECL_COMMAND="$7"
+EXE_NAME="${8}"
+shift 8
+TEST_ARGS="$@"
+
+rm -Rf  ${RESULT_PATH}
+mkdir -p ${RESULT_PATH}/default ${RESULT_PATH}/test
+cd ${RESULT_PATH}
+${BINPATH}/${EXE_NAME} ${INPUT_DATA_PATH}/${FILENAME} --output-dir=${RESULT_PATH}/default > default.log 2>&1
+test $? -eq 0 || exit 1
+${BINPATH}/${EXE_NAME} ${TEST_ARGS} --output-dir=${RESULT_PATH}/test > test.log 2>&1
+test $? -eq 0 || exit 1
+cd ..
+
+echo "=== Cost of the default run and of the run with: ${TEST_ARGS} ==="
+for key in "Total time (seconds)" "Overall Linearizations" "Overall Newton Iterations" "Overall Linear Iterations" "Overall Local Linearizations"
+do
+  printf "%-30s %-40s %s\n" "${key}" \
+         "$(grep -m 1 "^${key}" ${RESULT_PATH}/default.log | cut -d: -f2-)" \
+         "$(grep -m 1 "^${key}" ${RESULT_PATH}/test.log | cut -d: -f2-)"
+done
+printf "%-30s %-40s %s\n" "Time step chops" \
+       "$(grep -c "Timestep chopped" ${RESULT_PATH}/default.log)" \
+       "$(grep -c "Timestep chopped" ${RESULT_PATH}/test.log)"
+
+ecode=0
+${COMPARE_ECL_COMMAND} -t SMRY ${RESULT_PATH}/default/${FILENAME} ${RESULT_PATH}/test/${FILENAME} ${ABS_TOL} ${REL_TOL}
+if [ $? -ne 0 ]
+then
+  ecode=1
+  ${COMPARE_ECL_COMMAND} -a -t SMRY ${RESULT_PATH}/default/${FILENAME} ${RESULT_PATH}/test/${FILENAME} ${ABS_TOL} ${REL_TOL}
+fi
+
+exit $ecode
@@ -448,14 +448,14 @@ Opm::Action::ActionX getActionX()
 
 
 template<class T>
-std::tuple<T,int,int> PackUnpack(const T& in)
+std::tuple<T,std::size_t,std::size_t> PackUnpack(const T& in)
 {
     auto comm = Dune::MPIHelper::getCollectiveCommunication();
     std::size_t packSize = Opm::Mpi::packSize(in, comm);
     std::vector<char> buffer(packSize);
-    int pos1 = 0;
+    std::size_t pos1 = 0;
     Opm::Mpi::pack(in, buffer, pos1, comm);
-    int pos2 = 0;
+    std::size_t pos2 = 0;
     T out;
     Opm::Mpi::unpack(out, buffer, pos2, comm);
 
@@ -2390,6 +2390,28 @@ BOOST_AUTO_TEST_CASE(EclEpsScalingPointsInfo)
 }
 
 
+BOOST_AUTO_TEST_CASE(SinglePassPacking)
+{
+    auto comm = Dune::MPIHelper::getCollectiveCommunication();
+    std::vector<std::vector<double>> val1{{1.0, 2.0, 3.0}, {}, std::vector<double>(1000, 4.0)};
+
+    // the buffer grows while packing and ends up with the size computed by packSize()
+    std::vector<char> buffer = Opm::Mpi::packToBuffer(val1, comm);
+    BOOST_CHECK_EQUAL(buffer.size(), Opm::Mpi::packSize(val1, comm));
+
+    std::vector<std::vector<double>> val2;
+    std::size_t pos = 0;
+    Opm::Mpi::unpack(val2, buffer, pos, comm);
+    BOOST_CHECK_EQUAL(pos, buffer.size());
+    BOOST_CHECK(val1 == val2);
+
+    // reading past the end of the buffer is detected
+    buffer.resize(buffer.size() - 1);
+    std::vector<std::vector<double>> val3;
+    pos = 0;
+    BOOST_CHECK_THROW(Opm::Mpi::unpack(val3, buffer, pos, comm), std::runtime_error);
+}
+
 bool init_unit_test_func()
 {
     return true;
@@ -0,0 +1,223 @@
+/*
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE BlockKernelsTest
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <opm/simulators/linalg/BlockKernels.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/ilu.hh>
+
+#include <random>
+
+namespace
+{
+template <int n>
+struct BlockData
+{
+    typedef Dune::FieldMatrix<double, n, n> Block;
+    typedef Dune::FieldVector<double, n> Vector;
+
+    BlockData()
+    {
+        std::mt19937 gen(n);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        for (int i = 0; i < n; ++i) {
+            x[i] = dist(gen);
+            y[i] = dist(gen);
+            for (int j = 0; j < n; ++j) {
+                // diagonally dominant, so that the blocks are invertible
+                A[i][j] = dist(gen) + (i == j ? 2.0*n : 0.0);
+                B[i][j] = dist(gen);
+                C[i][j] = dist(gen);
+            }
+        }
+    }
+
+    Block A, B, C;
+    Vector x, y;
+};
+
+template <int n>
+void checkClose(const Dune::FieldVector<double, n>& a, const Dune::FieldVector<double, n>& b)
+{
+    for (int i = 0; i < n; ++i)
+        BOOST_CHECK_CLOSE(a[i], b[i], 1e-11);
+}
+
+template <int n>
+void checkClose(const Dune::FieldMatrix<double, n, n>& a, const Dune::FieldMatrix<double, n, n>& b)
+{
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j)
+            BOOST_CHECK_SMALL(a[i][j] - b[i][j], 1e-12);
+}
+
+template <int n>
+using BlockSize = std::integral_constant<int, n>;
+}
+
+typedef boost::mpl::list<BlockSize<1>, BlockSize<2>, BlockSize<3>, BlockSize<4>, BlockSize<6>> BlockSizes;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(MatrixVectorProducts, T, BlockSizes)
+{
+    constexpr int n = T::value;
+    BlockData<n> d;
+
+    auto expected = d.y;
+    auto result = d.y;
+    d.A.mv(d.x, expected);
+    Opm::BlockKernels::mv(d.A, d.x, result);
+    checkClose(expected, result);
+
+    expected = d.y;
+    result = d.y;
+    d.A.umv(d.x, expected);
+    Opm::BlockKernels::umv(d.A, d.x, result);
+    checkClose(expected, result);
+
+    expected = d.y;
+    result = d.y;
+    d.A.mmv(d.x, expected);
+    Opm::BlockKernels::mmv(d.A, d.x, result);
+    checkClose(expected, result);
+
+    expected = d.y;
+    result = d.y;
+    d.A.usmv(0.5, d.x, expected);
+    Opm::BlockKernels::usmv(0.5, d.A, d.x, result);
+    checkClose(expected, result);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(MatrixProducts, T, BlockSizes)
+{
+    constexpr int n = T::value;
+    BlockData<n> d;
+
+    auto expected = d.A;
+    expected.rightmultiply(d.B);
+    typename BlockData<n>::Block result;
+    Opm::BlockKernels::multiply(d.A, d.B, result);
+    checkClose(expected, result);
+
+    auto rightmultiplied = d.A;
+    Opm::BlockKernels::rightmultiply(rightmultiplied, d.B);
+    checkClose(expected, rightmultiplied);
+
+    expected = d.C;
+    expected -= typename BlockData<n>::Block(d.B).leftmultiply(d.A);
+    result = d.C;
+    Opm::BlockKernels::multiplySubtract(d.A, d.B, result);
+    checkClose(expected, result);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(InvertAndSolve, T, BlockSizes)
+{
+    constexpr int n = T::value;
+    BlockData<n> d;
+
+    typename BlockData<n>::Block identity(0.0);
+    for (int i = 0; i < n; ++i)
+        identity[i][i] = 1.0;
+
+    auto inverse = d.A;
+    Opm::BlockKernels::invert(inverse);
+    typename BlockData<n>::Block product;
+    Opm::BlockKernels::multiply(d.A, inverse, product);
+    checkClose(identity, product);
+
+    auto lu = d.A;
+    std::array<int, n> pivots;
+    Opm::BlockKernels::luFactor(lu, pivots);
+    auto solution = d.x;
+    Opm::BlockKernels::luSolve(lu, pivots, solution);
+    typename BlockData<n>::Vector rhs;
+    d.A.mv(solution, rhs);
+    checkClose(d.x, rhs);
+}
+
+template <int n>
+void checkSingularBlockThrows()
+{
+    Dune::FieldMatrix<double, n, n> zero(0.0);
+    BOOST_CHECK_THROW(Opm::BlockKernels::invert(zero), Dune::FMatrixError);
+
+    // rank one, i.e., singular for n > 1 only
+    Dune::FieldMatrix<double, n, n> ones(1.0);
+    if (n > 1)
+        BOOST_CHECK_THROW(Opm::BlockKernels::invert(ones), Dune::FMatrixError);
+    else
+        BOOST_CHECK_NO_THROW(Opm::BlockKernels::invert(ones));
+}
+
+BOOST_AUTO_TEST_CASE(SingularBlockThrows)
+{
+    checkSingularBlockThrows<1>();
+    checkSingularBlockThrows<2>();
+    checkSingularBlockThrows<3>();
+    checkSingularBlockThrows<4>();
+    checkSingularBlockThrows<6>();
+}
+
+BOOST_AUTO_TEST_CASE(ILU0MatchesDune)
+{
+    constexpr int n = 3;
+    typedef Dune::FieldMatrix<double, n, n> Block;
+    typedef Dune::BCRSMatrix<Block> Matrix;
+
+    // tridiagonal block matrix
+    const int N = 20;
+    Matrix A(N, N, 3*N, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int i = row.index();
+        if (i > 0)
+            row.insert(i - 1);
+        row.insert(i);
+        if (i < N - 1)
+            row.insert(i + 1);
+    }
+    BlockData<n> d;
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            *col = col.index() == row.index() ? d.A : d.B;
+            (*col)[0][0] += 0.01 * row.index();
+        }
+    }
+
+    Matrix expected(A);
+    Dune::bilu0_decomposition(expected);
+    Matrix result(A);
+    Opm::detail::ilu0_decomposition(result);
+
+    for (auto row = expected.begin(); row != expected.end(); ++row)
+        for (auto col = row->begin(); col != row->end(); ++col)
+            checkClose(*col, result[row.index()][col.index()]);
+
+    Dune::BlockVector<Dune::FieldVector<double, n>> x(N), yExpected(N), yResult(N);
+    for (int i = 0; i < N; ++i)
+        x[i] = d.x;
+    A.mv(x, yExpected);
+    Opm::BlockKernels::spmv(A, x, yResult);
+    for (int i = 0; i < N; ++i)
+        checkClose(yExpected[i], yResult[i]);
+}
@@ -0,0 +1,158 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE CheckpointTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/Checkpoint.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Cost
+    {
+        double dt;
+        int iterations;
+        bool converged;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(RoundTripIsBitExact)
+{
+    const std::string fileName = "test_checkpoint.ckpt";
+
+    const std::vector<double> values = { 1.0/3.0, -0.0, std::numeric_limits<double>::denorm_min(),
+                                         std::nextafter(1.0, 2.0) };
+    const std::vector<bool> flags = { true, false, true };
+    const std::map<std::string, std::pair<int, int>> wellMap = { { "PROD", { 0, 3 } }, { "INJ", { 1, 2 } } };
+    const std::deque<Cost> history = { { 1.5, 4, true }, { 0.25, 12, false } };
+
+    {
+        Opm::CheckpointFile checkpoint;
+        checkpoint.serializeBegin();
+        checkpoint.serializeSectionBegin("First");
+        auto& os = checkpoint.serializeStream();
+        Opm::Checkpoint::write(os, values);
+        Opm::Checkpoint::write(os, flags);
+        checkpoint.serializeSectionEnd();
+        checkpoint.serializeSectionBegin("Second");
+        Opm::Checkpoint::write(os, wellMap);
+        Opm::Checkpoint::write(os, history);
+        checkpoint.serializeSectionEnd();
+        checkpoint.serializeEnd(fileName);
+        checkpoint.wait();
+    }
+
+    Opm::CheckpointFile checkpoint;
+    checkpoint.deserializeBegin(fileName);
+    checkpoint.deserializeSectionBegin("First");
+    auto& is = checkpoint.deserializeStream();
+    std::vector<double> values2;
+    std::vector<bool> flags2;
+    Opm::Checkpoint::read(is, values2);
+    Opm::Checkpoint::read(is, flags2);
+    checkpoint.deserializeSectionEnd();
+    checkpoint.deserializeSectionBegin("Second");
+    std::map<std::string, std::pair<int, int>> wellMap2;
+    std::deque<Cost> history2;
+    Opm::Checkpoint::read(is, wellMap2);
+    Opm::Checkpoint::read(is, history2);
+    checkpoint.deserializeSectionEnd();
+    checkpoint.deserializeEnd();
+
+    BOOST_REQUIRE_EQUAL(values2.size(), values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        BOOST_CHECK_EQUAL(values2[i], values[i]);
+        BOOST_CHECK_EQUAL(std::signbit(values2[i]), std::signbit(values[i]));
+    }
+    BOOST_CHECK(flags2 == flags);
+    BOOST_CHECK(wellMap2 == wellMap);
+    BOOST_REQUIRE_EQUAL(history2.size(), history.size());
+    for (std::size_t i = 0; i < history.size(); ++i) {
+        BOOST_CHECK_EQUAL(history2[i].dt, history[i].dt);
+        BOOST_CHECK_EQUAL(history2[i].iterations, history[i].iterations);
+        BOOST_CHECK_EQUAL(history2[i].converged, history[i].converged);
+    }
+
+    std::remove(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(WrongSectionIsDetected)
+{
+    const std::string fileName = "test_checkpoint_section.ckpt";
+
+    {
+        Opm::CheckpointFile checkpoint;
+        checkpoint.serializeBegin();
+        checkpoint.serializeSectionBegin("WellModel");
+        Opm::Checkpoint::write(checkpoint.serializeStream(), 42);
+        checkpoint.serializeSectionEnd();
+        checkpoint.serializeEnd(fileName);
+    }
+
+    Opm::CheckpointFile checkpoint;
+    checkpoint.deserializeBegin(fileName);
+    BOOST_CHECK_THROW(checkpoint.deserializeSectionBegin("AquiferModel"), std::runtime_error);
+
+    std::remove(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(TruncatedDataIsDetected)
+{
+    const std::string fileName = "test_checkpoint_truncated.ckpt";
+
+    {
+        Opm::CheckpointFile checkpoint;
+        checkpoint.serializeBegin();
+        checkpoint.serializeSectionBegin("Data");
+        // the size of a vector of three values, followed by only one value
+        Opm::Checkpoint::write(checkpoint.serializeStream(), std::uint64_t(3));
+        Opm::Checkpoint::write(checkpoint.serializeStream(), 1.0);
+        checkpoint.serializeSectionEnd();
+        checkpoint.serializeEnd(fileName);
+    }
+
+    Opm::CheckpointFile checkpoint;
+    checkpoint.deserializeBegin(fileName);
+    checkpoint.deserializeSectionBegin("Data");
+    std::vector<double> values;
+    BOOST_CHECK_THROW(Opm::Checkpoint::read(checkpoint.deserializeStream(), values), std::runtime_error);
+
+    BOOST_CHECK_THROW(checkpoint.deserializeBegin("does_not_exist.ckpt"), std::runtime_error);
+
+    std::remove(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(DeckHash)
+{
+    // reference values of the 64-bit FNV-1a hash
+    BOOST_CHECK_EQUAL(Opm::Checkpoint::hash(""), 14695981039346656037ULL);
+    BOOST_CHECK_EQUAL(Opm::Checkpoint::hash("a"), 0xaf63dc4c8601ec8cULL);
+
+    // a single changed value of the deck must change the hash
+    BOOST_CHECK(Opm::Checkpoint::hash("PORO\n 100*0.25 /\n") != Opm::Checkpoint::hash("PORO\n 100*0.26 /\n"));
+}
@@ -0,0 +1,130 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE EnsembleDefinitionTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/flow/EnsembleDefinition.hpp>
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    // The Peaceman transmissibility factor of a vertical connection in an
+    // anisotropic cell, as computed from the permeabilities of the deck.
+    double peacemanFactor(double kx, double ky, double dx, double dy, double h, double rw, double skin)
+    {
+        const double r0 = 0.28 * std::sqrt(std::sqrt(ky/kx)*dx*dx + std::sqrt(kx/ky)*dy*dy)
+            / (std::pow(ky/kx, 0.25) + std::pow(kx/ky, 0.25));
+        return 2*M_PI * std::sqrt(kx*ky) * h / (std::log(r0/rw) + skin);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ReadMembers)
+{
+    std::istringstream is("-- name   multipliers\n"
+                          "BASE\n"
+                          "\n"
+                          "# high permeability\n"
+                          "R001  PERMX=1.5 PERMY=1.5   PORO=0.9\n"
+                          "R002  PERMZ=2e-1\n"
+                          "R003  PERMX=@perm/R003.INC PORO=0.8\n");
+    const auto members = Opm::readEnsembleDefinition(is);
+
+    BOOST_REQUIRE_EQUAL(members.size(), 4U);
+    BOOST_CHECK_EQUAL(members[0].name, "BASE");
+    BOOST_CHECK(members[0].multipliers.empty());
+    BOOST_CHECK_EQUAL(members[1].name, "R001");
+    BOOST_CHECK_EQUAL(members[1].multipliers.size(), 3U);
+    BOOST_CHECK_EQUAL(members[1].multipliers.at("PERMX"), 1.5);
+    BOOST_CHECK_EQUAL(members[1].multipliers.at("PERMY"), 1.5);
+    BOOST_CHECK_EQUAL(members[1].multipliers.at("PORO"), 0.9);
+    BOOST_CHECK_EQUAL(members[2].multipliers.at("PERMZ"), 0.2);
+    BOOST_CHECK(members[2].arrayFiles.empty());
+    BOOST_CHECK_EQUAL(members[3].multipliers.size(), 1U);
+    BOOST_CHECK_EQUAL(members[3].multipliers.at("PORO"), 0.8);
+    BOOST_CHECK_EQUAL(members[3].arrayFiles.size(), 1U);
+    BOOST_CHECK_EQUAL(members[3].arrayFiles.at("PERMX"), "perm/R003.INC");
+}
+
+BOOST_AUTO_TEST_CASE(RejectInvalidLines)
+{
+    const char* invalid[] = { "R001 PERMX\n",
+                              "R001 NTG=1.0\n",
+                              "R001 PORO=abc\n",
+                              "R001 PORO=1.0x\n",
+                              "R001 PORO=-1.0\n",
+                              "R001 PORO=@\n",
+                              "R001 PORO=0.9 PORO=0.8\n",
+                              "R001 PERMX=@a.INC PERMX=2.0\n",
+                              "R001\nR001\n" };
+    for (const auto* text : invalid) {
+        std::istringstream is(text);
+        BOOST_CHECK_THROW(Opm::readEnsembleDefinition(is), std::invalid_argument);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CellMultipliers)
+{
+    const std::vector<double> deckValues = { 100.0, 0.0, 300.0, 0.0 };
+    const auto mult = Opm::cellMultipliers(deckValues, { 150.0, 0.0, 100.0, 0.0 });
+    BOOST_REQUIRE_EQUAL(mult.size(), deckValues.size());
+    BOOST_CHECK_EQUAL(mult[0], 1.5);
+    BOOST_CHECK_EQUAL(mult[1], 1.0);
+    BOOST_CHECK_CLOSE(mult[2], 1.0/3, 1e-12);
+    BOOST_CHECK_EQUAL(mult[3], 1.0);
+
+    BOOST_CHECK_THROW(Opm::cellMultipliers(deckValues, { 1.0, 0.0, 1.0 }), std::invalid_argument);
+    BOOST_CHECK_THROW(Opm::cellMultipliers(deckValues, { 1.0, 1.0, 1.0, 0.0 }), std::invalid_argument);
+    BOOST_CHECK_THROW(Opm::cellMultipliers(deckValues, { -1.0, 0.0, 1.0, 0.0 }), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(ConnectionFactorsFollowPermeabilities)
+{
+    using Dir = Opm::Connection::Direction;
+
+    // a realization which scales the permeabilities isotropically scales the
+    // transmissibilities between the cells and the well connection factors alike
+    const double mult = 1.5;
+    for (const auto dir : { Dir::X, Dir::Y, Dir::Z })
+        BOOST_CHECK_EQUAL(Opm::connectionFactorMultiplier(mult, mult, mult, dir), mult);
+
+    const double kx = 2e-13, ky = 5e-14, dx = 100.0, dy = 50.0, h = 10.0, rw = 0.1, skin = 2.0;
+    const double cf = peacemanFactor(kx, ky, dx, dy, h, rw, skin);
+    const double cfMult = peacemanFactor(mult*kx, mult*ky, dx, dy, h, rw, skin);
+    BOOST_CHECK_CLOSE(cfMult/cf, Opm::connectionFactorMultiplier(mult, mult, 3.0, Dir::Z), 1e-10);
+
+    // the permeability along the connection does not enter its factor
+    BOOST_CHECK_EQUAL(Opm::connectionFactorMultiplier(3.0, mult, mult, Dir::X), mult);
+    BOOST_CHECK_EQUAL(Opm::connectionFactorMultiplier(mult, 3.0, mult, Dir::Y), mult);
+
+    // the factors of a cell derived from the arrays of a realization which
+    // scale both permeabilities alike only differ by rounding errors
+    const double multX = (mult*kx)/kx, multY = (mult*ky)/ky;
+    BOOST_CHECK_CLOSE(Opm::connectionFactorMultiplier(multX, multY, 1.0, Dir::Z), mult, 1e-10);
+
+    // different factors of the perpendicular permeabilities change the
+    // equivalent radius, so the connection factor cannot simply be scaled
+    BOOST_CHECK(std::abs(peacemanFactor(mult*kx, ky, dx, dy, h, rw, skin)/cf - std::sqrt(mult)) > 1e-3);
+    BOOST_CHECK_THROW(Opm::connectionFactorMultiplier(mult, 1.0, 1.0, Dir::Z), std::invalid_argument);
+    BOOST_CHECK_THROW(Opm::connectionFactorMultiplier(1.0, mult, 1.0, Dir::X), std::invalid_argument);
+    BOOST_CHECK_THROW(Opm::connectionFactorMultiplier(1.0, 1.0, mult, Dir::Y), std::invalid_argument);
+}
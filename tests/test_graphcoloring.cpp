@@ -99,3 +99,54 @@ BOOST_AUTO_TEST_CASE(TestWelschPowell)
                                            graph, 0);
     checkAllIndices(newOrder);
 }
+
+BOOST_AUTO_TEST_CASE(TestStronglyConnectedComponents)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double,1,1>>;
+    using Graph = Dune::Amg::MatrixGraph<const Matrix>;
+    // a chain 0 <- 1 <- 2 feeding a cycle of 3 and 4, on which 5 depends,
+    // and 6 depending on 0 only
+    const std::vector<std::vector<int>> dependencies = {
+        {}, {0}, {1}, {2, 4}, {3}, {4}, {0}
+    };
+    const int N = dependencies.size();
+    Matrix matrix(N, N, 3, 0.4, Matrix::implicit);
+    for( int index = N - 1; index >= 0; --index)
+    {
+        matrix.entry(index,index) = 1;
+        for(auto dependency: dependencies[index])
+        {
+            matrix.entry(index,dependency) = 1;
+        }
+    }
+    matrix.compress();
+
+    Graph graph(matrix);
+    auto components = Opm::stronglyConnectedComponents(graph);
+    const auto& vertices = components.first;
+    const auto& offsets = components.second;
+    BOOST_CHECK(vertices.size() == std::size_t(N));
+    BOOST_CHECK(offsets.size() == 7);
+    BOOST_CHECK(offsets.back() == std::size_t(N));
+
+    std::vector<std::size_t> componentOf(N);
+    for(std::size_t component = 0; component + 1 < offsets.size(); ++component)
+    {
+        for(auto index = offsets[component]; index < offsets[component + 1]; ++index)
+        {
+            componentOf[vertices[index]] = component;
+        }
+    }
+    std::vector<std::size_t> ordering(vertices.begin(), vertices.end());
+    checkAllIndices(ordering);
+
+    BOOST_CHECK(componentOf[3] == componentOf[4]);
+    BOOST_CHECK(offsets[componentOf[3] + 1] - offsets[componentOf[3]] == 2);
+    for(int index = 0; index < N; ++index)
+    {
+        for(auto dependency: dependencies[index])
+        {
+            BOOST_CHECK(componentOf[dependency] <= componentOf[index]);
+        }
+    }
+}
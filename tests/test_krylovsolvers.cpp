@@ -0,0 +1,178 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE KrylovSolversTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/KrylovSolvers.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+
+#include <memory>
+
+namespace
+{
+    typedef Dune::BCRSMatrix<Dune::FieldMatrix<double, 1, 1>> Matrix;
+    typedef Dune::BlockVector<Dune::FieldVector<double, 1>> Vector;
+
+    // upwind discretization of -laplace(u) + c grad(u) on an n x n grid,
+    // which gives a nonsymmetric matrix
+    Matrix convectionDiffusion(const int n, const double c)
+    {
+        const int N = n*n;
+        Matrix A(N, N, 5*N, Matrix::row_wise);
+        for (auto row = A.createbegin(); row != A.createend(); ++row) {
+            const int i = row.index() % n;
+            const int j = row.index() / n;
+            if (j > 0)
+                row.insert(row.index() - n);
+            if (i > 0)
+                row.insert(row.index() - 1);
+            row.insert(row.index());
+            if (i < n - 1)
+                row.insert(row.index() + 1);
+            if (j < n - 1)
+                row.insert(row.index() + n);
+        }
+        A = 0.0;
+        for (int k = 0; k < N; ++k) {
+            const int i = k % n;
+            const int j = k / n;
+            A[k][k] = 4.0 + 2.0*c;
+            if (j > 0)
+                A[k][k - n] = -1.0 - c;
+            if (i > 0)
+                A[k][k - 1] = -1.0 - c;
+            if (i < n - 1)
+                A[k][k + 1] = -1.0;
+            if (j < n - 1)
+                A[k][k + n] = -1.0;
+        }
+        return A;
+    }
+
+    // Jacobi preconditioner doing a different number of sweeps in each
+    // application, which requires a flexible Krylov method.
+    class VaryingJacobi : public Dune::Preconditioner<Vector, Vector>
+    {
+    public:
+        explicit VaryingJacobi(const Matrix& A)
+            : A_(A)
+        {
+        }
+
+        virtual void pre(Vector&, Vector&) override
+        {
+        }
+
+        virtual void apply(Vector& v, const Vector& d) override
+        {
+            const int sweeps = 1 + (count_++ % 3);
+            Vector r(d);
+            for (int sweep = 0; sweep < sweeps; ++sweep) {
+                r = d;
+                A_.mmv(v, r);
+                for (std::size_t i = 0; i < v.size(); ++i)
+                    v[i][0] += r[i][0]/A_[i][i][0][0];
+            }
+        }
+
+        virtual void post(Vector&) override
+        {
+        }
+
+        virtual Dune::SolverCategory::Category category() const override
+        {
+            return Dune::SolverCategory::sequential;
+        }
+
+    private:
+        const Matrix& A_;
+        int count_ = 0;
+    };
+
+    void makeProblem(const Matrix& A, Vector& xExact, Vector& b)
+    {
+        xExact.resize(A.N());
+        for (std::size_t i = 0; i < xExact.size(); ++i)
+            xExact[i] = 1.0 + double(i % 7);
+        b.resize(A.N());
+        A.mv(xExact, b);
+    }
+
+    void checkSolution(const Vector& x, const Vector& xExact)
+    {
+        for (std::size_t i = 0; i < x.size(); ++i)
+            BOOST_CHECK_CLOSE(x[i][0], xExact[i][0], 1e-4);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(PipelinedBiCGSTABTwoReductionsPerIteration)
+{
+    const Matrix A = convectionDiffusion(20, 2.0);
+    Vector xExact, b;
+    makeProblem(A, xExact, b);
+
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    Dune::SeqJac<Matrix, Vector, Vector> prec(A, 1, 1.0);
+    auto reduction = std::make_shared<Opm::FusedReduction<Vector>>();
+    Opm::PipelinedBiCGSTABSolver<Vector> solver(op, reduction, prec, 1e-10, 500, 0);
+
+    Vector x(A.N());
+    x = 0.0;
+    Dune::InverseOperatorResult res;
+    solver.apply(x, b, res);
+
+    BOOST_CHECK(res.converged);
+    BOOST_CHECK_LT(res.reduction, 1e-10);
+    BOOST_CHECK_EQUAL(reduction->numReductions(), 1 + 2*res.iterations);
+    checkSolution(x, xExact);
+}
+
+BOOST_AUTO_TEST_CASE(FlexibleGMResWithVaryingPreconditioner)
+{
+    const Matrix A = convectionDiffusion(20, 2.0);
+    Vector xExact, b;
+    makeProblem(A, xExact, b);
+
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(A);
+    VaryingJacobi prec(A);
+    auto reduction = std::make_shared<Opm::FusedReduction<Vector>>();
+    const int restart = 30;
+    Opm::FlexibleGMResSolver<Vector> solver(op, reduction, prec, 1e-10, restart, 1000, 0);
+
+    Vector x(A.N());
+    x = 0.0;
+    Dune::InverseOperatorResult res;
+    solver.apply(x, b, res);
+
+    BOOST_CHECK(res.converged);
+    BOOST_CHECK_LT(res.reduction, 1e-10);
+    // one reduction per iteration and restart, and occasionally one more
+    // for a second orthogonalization
+    const int numRestarts = (res.iterations - 1)/restart;
+    BOOST_CHECK_GE(reduction->numReductions(), 1 + res.iterations + numRestarts);
+    BOOST_CHECK_LE(reduction->numReductions(), 1 + 2*res.iterations + numRestarts);
+    checkSolution(x, xExact);
+}
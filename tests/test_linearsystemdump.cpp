@@ -0,0 +1,196 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE LinearSystemDumpTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/LinearSystemDump.hpp>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int numEq = 3;
+    typedef Dune::BlockVector<Dune::FieldVector<double, numEq>> BVector;
+    typedef Dune::BCRSMatrix<Dune::FieldMatrix<double, numEq, numEq>> Matrix;
+    typedef Dune::BCRSMatrix<Dune::DynamicMatrix<double>> WellMatrix;
+    typedef Dune::BlockVector<Dune::DynamicVector<double>> BVectorWell;
+
+    struct TestWell
+    {
+        TestWell(const std::vector<int>& cells, const int numCells, const int numWellEq, std::mt19937& gen)
+        {
+            std::uniform_real_distribution<double> dist(-1.0, 1.0);
+            B.setBuildMode(WellMatrix::row_wise);
+            C.setBuildMode(WellMatrix::row_wise);
+            invD.setBuildMode(WellMatrix::row_wise);
+            B.setSize(1, numCells, cells.size());
+            C.setSize(1, numCells, cells.size());
+            invD.setSize(1, 1, 1);
+            for (auto row = B.createbegin(); row != B.createend(); ++row)
+                for (const int cell : cells)
+                    row.insert(cell);
+            for (auto row = C.createbegin(); row != C.createend(); ++row)
+                for (const int cell : cells)
+                    row.insert(cell);
+            for (auto row = invD.createbegin(); row != invD.createend(); ++row)
+                row.insert(row.index());
+
+            invD[0][0].resize(numWellEq, numWellEq);
+            for (int i = 0; i < numWellEq; ++i)
+                for (int j = 0; j < numWellEq; ++j)
+                    invD[0][0][i][j] = dist(gen);
+            for (const int cell : cells) {
+                B[0][cell].resize(numWellEq, numEq);
+                C[0][cell].resize(numWellEq, numEq);
+                for (int i = 0; i < numWellEq; ++i) {
+                    for (int j = 0; j < numEq; ++j) {
+                        B[0][cell][i][j] = dist(gen);
+                        C[0][cell][i][j] = dist(gen);
+                    }
+                }
+            }
+        }
+
+        // Ax = Ax - C^T D^-1 B x, as done by StandardWell::apply()
+        void apply(const BVector& x, BVector& Ax) const
+        {
+            BVectorWell Bx(1), invDBx(1);
+            Bx[0].resize(invD[0][0].N());
+            invDBx[0].resize(invD[0][0].N());
+            B.mv(x, Bx);
+            invD.mv(Bx, invDBx);
+            C.mmtv(invDBx, Ax);
+        }
+
+        WellMatrix B, C, invD;
+    };
+
+    // a tridiagonal matrix with random blocks and a random right hand side
+    void makeSystem(const int numCells, std::mt19937& gen, Matrix& A, BVector& b)
+    {
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        A.setSize(numCells, numCells, 3*numCells);
+        A.setBuildMode(Matrix::row_wise);
+        for (auto row = A.createbegin(); row != A.createend(); ++row)
+            for (int col = std::max(int(row.index()) - 1, 0); col <= std::min(int(row.index()) + 1, numCells - 1); ++col)
+                row.insert(col);
+        for (auto row = A.begin(); row != A.end(); ++row)
+            for (auto col = row->begin(); col != row->end(); ++col)
+                for (int i = 0; i < numEq; ++i)
+                    for (int j = 0; j < numEq; ++j)
+                        (*col)[i][j] = dist(gen);
+        b.resize(numCells);
+        for (auto& block : b)
+            for (auto& value : block)
+                value = dist(gen);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(WriteAndReadSystemWithWells)
+{
+    const int numCells = 12;
+    std::mt19937 gen(3);
+    Matrix A;
+    BVector b;
+    makeSystem(numCells, gen, A, b);
+    std::vector<TestWell> wells;
+    wells.emplace_back(std::vector<int>{1, 5}, numCells, 4, gen);
+    wells.emplace_back(std::vector<int>{5, 6, 11}, numCells, 5, gen);
+    Opm::WellSchurComplement<double, numEq> schur;
+    for (const auto& well : wells)
+        schur.addWell(well.B, well.C, well.invD);
+
+    const std::string fileName = "test_linearsystemdump.opmsys";
+    Opm::LinearSystemDump::write(fileName, A, b, &schur);
+    BOOST_CHECK_EQUAL(Opm::LinearSystemDump::blockSize(fileName), numEq);
+
+    Matrix A2;
+    BVector b2;
+    Opm::WellSchurComplement<double, numEq> schur2;
+    BOOST_CHECK(Opm::LinearSystemDump::read(fileName, A2, b2, schur2));
+    std::remove(fileName.c_str());
+
+    BOOST_REQUIRE_EQUAL(A2.N(), A.N());
+    BOOST_REQUIRE_EQUAL(A2.nonzeroes(), A.nonzeroes());
+    for (auto row = A.begin(); row != A.end(); ++row)
+        for (auto col = row->begin(); col != row->end(); ++col)
+            for (int i = 0; i < numEq; ++i)
+                for (int j = 0; j < numEq; ++j)
+                    BOOST_CHECK_EQUAL(A2[row.index()][col.index()][i][j], (*col)[i][j]);
+    for (int cell = 0; cell < numCells; ++cell)
+        for (int i = 0; i < numEq; ++i)
+            BOOST_CHECK_EQUAL(b2[cell][i], b[cell][i]);
+    BOOST_CHECK_EQUAL(schur2.numWells(), 2);
+    BOOST_CHECK_EQUAL(schur2.numPerforations(), 5);
+
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    BVector x(numCells), expected(numCells), result(numCells);
+    for (auto& block : x)
+        for (auto& value : block)
+            value = dist(gen);
+    expected = 0.0;
+    result = 0.0;
+    schur.apply(x, expected);
+    schur2.apply(x, result);
+    for (int cell = 0; cell < numCells; ++cell)
+        for (int i = 0; i < numEq; ++i)
+            BOOST_CHECK_EQUAL(result[cell][i], expected[cell][i]);
+}
+
+BOOST_AUTO_TEST_CASE(WellContributionsMatchOperator)
+{
+    const int numCells = 12;
+    std::mt19937 gen(4);
+    Matrix A;
+    BVector b;
+    makeSystem(numCells, gen, A, b);
+    // the perforations of the first well are not neighbours in A
+    std::vector<TestWell> wells;
+    wells.emplace_back(std::vector<int>{0, 4, 9}, numCells, 4, gen);
+    wells.emplace_back(std::vector<int>{9, 10}, numCells, 4, gen);
+    Opm::WellSchurComplement<double, numEq> schur;
+    for (const auto& well : wells)
+        schur.addWell(well.B, well.C, well.invD);
+
+    const Matrix combined = Opm::LinearSystemDump::addWellContributions(A, schur);
+    BOOST_CHECK_EQUAL(combined.nonzeroes(), A.nonzeroes() + 6);
+
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    BVector x(numCells), expected(numCells), result(numCells);
+    for (auto& block : x)
+        for (auto& value : block)
+            value = dist(gen);
+    A.mv(x, expected);
+    schur.apply(x, expected);
+    combined.mv(x, result);
+    for (int cell = 0; cell < numCells; ++cell)
+        for (int i = 0; i < numEq; ++i)
+            BOOST_CHECK_CLOSE(result[cell][i], expected[cell][i], 1e-10);
+}
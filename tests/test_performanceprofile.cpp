@@ -0,0 +1,98 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE PerformanceProfileTest
+#define BOOST_TEST_NO_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/PerformanceProfile.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    std::string writeProfile()
+    {
+        const std::string fileName = "test_performanceprofile.json";
+        Opm::PerformanceProfile::report(Dune::MPIHelper::getCollectiveCommunication(), fileName);
+        std::ifstream json(fileName);
+        std::stringstream content;
+        content << json.rdbuf();
+        std::remove(fileName.c_str());
+        return content.str();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(DisabledProfileRecordsNothing)
+{
+    Opm::PerformanceProfile::clear();
+    Opm::PerformanceProfile::setEnabled(false);
+    {
+        Opm::PerformanceProfile::ScopedTimer timer("assembly");
+        Opm::PerformanceProfile::count("iterations", 3);
+    }
+
+    const std::string json = writeProfile();
+    BOOST_CHECK(json.find("\"entries\": [\n  ]") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(NestedTimersAndCounters)
+{
+    Opm::PerformanceProfile::clear();
+    Opm::PerformanceProfile::setEnabled(true);
+    for (int i = 0; i < 2; ++i) {
+        Opm::PerformanceProfile::ScopedTimer assembly("assembly");
+        {
+            Opm::PerformanceProfile::ScopedTimer wells("wells");
+            Opm::PerformanceProfile::ScopedTimer well(std::string("PROD\"1"));
+        }
+        Opm::PerformanceProfile::count("cells", 10);
+    }
+    Opm::PerformanceProfile::setEnabled(false);
+
+    const std::string json = writeProfile();
+    const auto assembly = json.find("{\"name\": \"assembly\", \"calls\": {\"min\": 2,");
+    const auto cells = json.find("{\"name\": \"assembly/cells\"");
+    const auto wells = json.find("{\"name\": \"assembly/wells\", \"calls\": {\"min\": 2,");
+    const auto well = json.find("{\"name\": \"assembly/wells/PROD\\\"1\"");
+    BOOST_CHECK(assembly != std::string::npos);
+    BOOST_CHECK(cells != std::string::npos);
+    BOOST_CHECK(wells != std::string::npos);
+    BOOST_CHECK(well != std::string::npos);
+    // nested entries follow their parent
+    BOOST_CHECK(assembly < cells && cells < wells && wells < well);
+    BOOST_CHECK(json.find("\"count\": {\"min\": 20, \"max\": 20, \"mean\": 20}") != std::string::npos);
+    Opm::PerformanceProfile::clear();
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -0,0 +1,98 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TimeStepControlTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/timestepping/TimeStepControl.hpp>
+
+namespace {
+    class NoChange : public Opm::RelativeChangeInterface
+    {
+    public:
+        double relativeChange() const { return 0.0; }
+    };
+
+    Opm::CostAwareTimeStepControl::SubStepCost cost(double dt, double wallTime, bool converged)
+    {
+        Opm::CostAwareTimeStepControl::SubStepCost c;
+        c.dt = dt;
+        c.wallTime = wallTime;
+        c.newtonIterations = 5;
+        c.linearIterations = 50;
+        c.converged = converged;
+        return c;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CostAwareGrowsWithSublinearCost)
+{
+    Opm::CostAwareTimeStepControl control(8, 0.33, 3.0);
+    const NoChange noChange;
+
+    // cost grows like sqrt(dt): larger steps are cheaper per simulated second
+    control.recordSubStep(cost(1.0, 1.0, true));
+    control.recordSubStep(cost(4.0, 2.0, true));
+
+    const double dt = control.computeTimeStepSize(4.0, 5, noChange, 0.0);
+    BOOST_CHECK_CLOSE(dt, 12.0, 1e-10);
+    BOOST_CHECK_CLOSE(control.usefulWork(), 3.0, 1e-10);
+    BOOST_CHECK_EQUAL(control.wastedWork(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(CostAwareShrinksWithSuperlinearCost)
+{
+    Opm::CostAwareTimeStepControl control(8, 0.33, 3.0);
+    const NoChange noChange;
+
+    // cost grows like dt^2: smaller steps pay off
+    control.recordSubStep(cost(1.0, 1.0, true));
+    control.recordSubStep(cost(2.0, 4.0, true));
+
+    const double dt = control.computeTimeStepSize(2.0, 5, noChange, 0.0);
+    BOOST_CHECK_CLOSE(dt, 1.0, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(CostAwareAvoidsFailedStepSize)
+{
+    Opm::CostAwareTimeStepControl control(8, 0.33, 3.0);
+    const NoChange noChange;
+
+    control.recordSubStep(cost(1.0, 1.0, true));
+    control.recordSubStep(cost(4.0, 2.0, true));
+    control.recordSubStep(cost(8.0, 20.0, false));
+
+    BOOST_CHECK_CLOSE(control.wastedWork(), 20.0, 1e-10);
+    BOOST_CHECK_EQUAL(control.numFailures(), 1);
+
+    // chop at least by the restart factor
+    BOOST_CHECK_CLOSE(control.computeTimeStepSizeAfterFailure(8.0), 0.33*8.0, 1e-10);
+    // and retry with the largest converged step below that
+    BOOST_CHECK_CLOSE(control.computeTimeStepSizeAfterFailure(100.0), 4.0, 1e-10);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSizeAfterFailure(4.0), 1.0, 1e-10);
+
+    // the expected penalty keeps the next step below the failed size
+    const double dt = control.computeTimeStepSize(4.0, 5, noChange, 0.0);
+    BOOST_CHECK_LT(dt, 8.0);
+    BOOST_CHECK_GT(control.expectedEfficiency(dt), control.expectedEfficiency(8.0));
+
+    control.resetStatistics();
+    BOOST_CHECK_EQUAL(control.wastedWork(), 0.0);
+    BOOST_CHECK_EQUAL(control.numFailures(), 0);
+}
@@ -0,0 +1,147 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE WellSchurComplementTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/wells/WellSchurComplement.hpp>
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int numEq = 3;
+    typedef Dune::BlockVector<Dune::FieldVector<double, numEq>> BVector;
+    typedef Dune::BCRSMatrix<Dune::DynamicMatrix<double>> WellMatrix;
+    typedef Dune::BlockVector<Dune::DynamicVector<double>> BVectorWell;
+
+    struct TestWell
+    {
+        TestWell(const std::vector<int>& cells, const int numCells, const int numWellEq, std::mt19937& gen)
+        {
+            std::uniform_real_distribution<double> dist(-1.0, 1.0);
+            B.setBuildMode(WellMatrix::row_wise);
+            C.setBuildMode(WellMatrix::row_wise);
+            invD.setBuildMode(WellMatrix::row_wise);
+            B.setSize(1, numCells, cells.size());
+            C.setSize(1, numCells, cells.size());
+            invD.setSize(1, 1, 1);
+            for (auto row = B.createbegin(); row != B.createend(); ++row)
+                for (const int cell : cells)
+                    row.insert(cell);
+            for (auto row = C.createbegin(); row != C.createend(); ++row)
+                for (const int cell : cells)
+                    row.insert(cell);
+            for (auto row = invD.createbegin(); row != invD.createend(); ++row)
+                row.insert(row.index());
+
+            invD[0][0].resize(numWellEq, numWellEq);
+            for (int i = 0; i < numWellEq; ++i)
+                for (int j = 0; j < numWellEq; ++j)
+                    invD[0][0][i][j] = dist(gen);
+            for (const int cell : cells) {
+                B[0][cell].resize(numWellEq, numEq);
+                C[0][cell].resize(numWellEq, numEq);
+                for (int i = 0; i < numWellEq; ++i) {
+                    for (int j = 0; j < numEq; ++j) {
+                        B[0][cell][i][j] = dist(gen);
+                        C[0][cell][i][j] = dist(gen);
+                    }
+                }
+            }
+        }
+
+        // Ax = Ax - C^T D^-1 B x, as done by StandardWell::apply()
+        void apply(const BVector& x, BVector& Ax) const
+        {
+            BVectorWell Bx(1), invDBx(1);
+            Bx[0].resize(invD[0][0].N());
+            invDBx[0].resize(invD[0][0].N());
+            B.mv(x, Bx);
+            invD.mv(Bx, invDBx);
+            C.mmtv(invDBx, Ax);
+        }
+
+        WellMatrix B, C, invD;
+    };
+}
+
+BOOST_AUTO_TEST_CASE(ApplyMatchesPerWellProducts)
+{
+    const int numCells = 20;
+    std::mt19937 gen(1);
+    // wells with different numbers of well equations, as for polymer
+    // injectivity wells, and a shared perforated cell
+    std::vector<TestWell> wells;
+    wells.emplace_back(std::vector<int>{1, 2, 3}, numCells, 4, gen);
+    wells.emplace_back(std::vector<int>{3, 10}, numCells, 6, gen);
+    wells.emplace_back(std::vector<int>{19}, numCells, 4, gen);
+
+    Opm::WellSchurComplement<double, numEq> schur;
+    for (const auto& well : wells)
+        schur.addWell(well.B, well.C, well.invD);
+    BOOST_CHECK_EQUAL(schur.numWells(), 3);
+    BOOST_CHECK_EQUAL(schur.numPerforations(), 6);
+
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    BVector x(numCells), expected(numCells), result(numCells);
+    for (auto& block : x)
+        for (auto& value : block)
+            value = dist(gen);
+    expected = 1.0;
+    result = 1.0;
+
+    for (const auto& well : wells)
+        well.apply(x, expected);
+    schur.apply(x, result);
+
+    for (int cell = 0; cell < numCells; ++cell)
+        for (int i = 0; i < numEq; ++i)
+            BOOST_CHECK_CLOSE(expected[cell][i], result[cell][i], 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(WellsWithoutCouplingAreSkipped)
+{
+    const int numCells = 5;
+    std::mt19937 gen(2);
+    TestWell well(std::vector<int>{0, 4}, numCells, 4, gen);
+    well.B = 0.0;
+
+    Opm::WellSchurComplement<double, numEq> schur;
+    schur.addWell(well.B, well.C, well.invD);
+    BOOST_CHECK_EQUAL(schur.numWells(), 0);
+
+    BVector x(numCells), Ax(numCells);
+    x = 1.0;
+    Ax = 2.0;
+    schur.apply(x, Ax);
+    for (const auto& block : Ax)
+        for (const auto value : block)
+            BOOST_CHECK_EQUAL(value, 2.0);
+
+    schur.clear();
+    BOOST_CHECK_EQUAL(schur.numPerforations(), 0);
+}